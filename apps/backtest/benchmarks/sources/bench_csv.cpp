@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <format>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ctre.hpp>
+#include <rapidcsv.h>
+
+import pludux.backtest;
+
+namespace {
+
+/**
+ * The loader used before the streaming CSV reader, kept to compare against.
+ */
+void legacy_update_asset_from_csv(pludux::backtest::Asset& asset,
+                                  std::istream& csv_stream)
+{
+  auto csv_doc = rapidcsv::Document(csv_stream);
+  const auto column_count = csv_doc.GetColumnCount();
+
+  if(column_count == 0) {
+    return;
+  }
+
+  constexpr auto date_record_index = 0;
+  const auto first_records = csv_doc.GetColumn<std::string>(date_record_index);
+  auto date_records = std::vector<double>{};
+
+  constexpr auto date_regex_match =
+   ctre::match<"^"
+               "(\\d{4})-(\\d{2})-(\\d{2})" // YYYY-MM-DD
+               "(?:[T ](\\d{2}):(\\d{2})"   // hh:mm
+               "(?::(\\d{2}(?:\\.\\d+)?))?" // :ss.s
+               "(Z|[+\\-]\\d{2}:\\d{2})"    // Z or +hh:mm or -hh:mm
+               ")?"
+               "$">;
+
+  std::transform(
+   first_records.cbegin(),
+   first_records.cend(),
+   std::back_inserter(date_records),
+   [&date_regex_match](const std::string& date) -> double {
+     const auto date_match = date_regex_match(date);
+
+     if(!date_match) {
+       return std::stod(date);
+     }
+
+     const auto year = date_match.template get<1>().str();
+     const auto month = date_match.template get<2>().str();
+     const auto day = date_match.template get<3>().str();
+     const auto hour =
+      date_match.template get<4>().to_optional_string().value_or("00");
+     const auto minute =
+      date_match.template get<5>().to_optional_string().value_or("00");
+     const auto second =
+      date_match.template get<6>().to_optional_string().value_or("00");
+     const auto timezone =
+      date_match.template get<7>().to_optional_string().value_or("Z");
+
+     const auto date_str = std::format(
+      "{}-{}-{}T{}:{}:{}{}", year, month, day, hour, minute, second, timezone);
+     auto datetime_tm = std::tm{};
+     auto date_stream = std::istringstream{date_str};
+     date_stream >> std::get_time(&datetime_tm, "%Y-%m-%dT%H:%M:%S%z");
+     return static_cast<double>(std::mktime(&datetime_tm));
+   });
+
+  auto field_data = std::vector<std::pair<std::string, pludux::AssetData>>{};
+
+  const auto date_record_header = csv_doc.GetColumnName(date_record_index);
+  field_data.emplace_back(date_record_header,
+                          pludux::AssetData{std::move(date_records)});
+
+  for(auto i = 1uz; i < column_count; ++i) {
+    field_data.emplace_back(csv_doc.GetColumnName(i),
+                            pludux::AssetData{csv_doc.GetColumn<double>(i)});
+  }
+
+  auto asset_field_resolver = pludux::AssetQuoteFieldResolver{};
+  asset_field_resolver.datetime_field(date_record_header);
+
+  asset.history(pludux::AssetHistory{field_data.begin(), field_data.end()});
+  asset.field_resolver(std::move(asset_field_resolver));
+}
+
+auto generate_csv(std::size_t row_count) -> std::string
+{
+  auto csv = std::string{"Date,Open,High,Low,Close,Volume\n"};
+  csv.reserve(row_count * 64);
+
+  const auto start_time = std::chrono::sys_days{std::chrono::year{2000} /
+                                                std::chrono::January / 1};
+  for(auto i = 0uz; i < row_count; ++i) {
+    const auto bar_time = start_time + std::chrono::minutes{i};
+    const auto close = 1000.0 + static_cast<double>(i % 997) * 0.25;
+    std::format_to(std::back_inserter(csv),
+                   "{:%Y-%m-%dT%H:%M:%S}Z,{},{},{},{},{}\n",
+                   bar_time,
+                   close - 0.5,
+                   close + 1.0,
+                   close - 1.0,
+                   close,
+                   1000 + i % 113);
+  }
+
+  return csv;
+}
+
+template<typename TLoader>
+auto time_loader(const std::string& csv, TLoader loader) -> double
+{
+  auto csv_stream = std::istringstream{csv};
+  auto asset = pludux::backtest::Asset{"Benchmark"};
+
+  const auto start = std::chrono::steady_clock::now();
+  loader(asset, csv_stream);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  if(asset.size() == 0) {
+    std::cerr << "Loader produced an empty asset" << std::endl;
+  }
+
+  return std::chrono::duration<double>(elapsed).count();
+}
+
+} // namespace
+
+auto main(int argc, const char** argv) -> int
+{
+  const auto row_count =
+   argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : 1'000'000uz;
+
+  const auto csv = generate_csv(row_count);
+  const auto megabytes = static_cast<double>(csv.size()) / (1 << 20);
+
+  const auto legacy_seconds = time_loader(csv, legacy_update_asset_from_csv);
+  const auto single_thread_seconds = time_loader(
+   csv, [](pludux::backtest::Asset& asset, std::istream& csv_stream) {
+     auto [headers, columns] =
+      pludux::backtest::read_asset_csv_columns(csv_stream, 1uz << 24, 1);
+
+     auto field_data =
+      std::vector<std::pair<std::string, pludux::AssetData>>{};
+     for(auto i = 0uz; i < headers.size(); ++i) {
+       field_data.emplace_back(headers[i],
+                               pludux::AssetData{std::move(columns[i])});
+     }
+     asset.history(pludux::AssetHistory{field_data.begin(), field_data.end()});
+   });
+  const auto multi_thread_seconds = time_loader(
+   csv, [](pludux::backtest::Asset& asset, std::istream& csv_stream) {
+     pludux::update_asset_from_csv(asset, csv_stream);
+   });
+
+  const auto print_result = [&](std::string_view name, double seconds) {
+    std::cout << std::format("{:<16} {:.3f} s ({:.1f} MiB/s, {:.1f}x)\n",
+                             name,
+                             seconds,
+                             megabytes / seconds,
+                             legacy_seconds / seconds);
+  };
+
+  std::cout << std::format("rows: {}, size: {:.1f} MiB, threads: {}\n",
+                           row_count,
+                           megabytes,
+                           std::thread::hardware_concurrency());
+  print_result("legacy:", legacy_seconds);
+  print_result("single thread:", single_thread_seconds);
+  print_result("multi thread:", multi_thread_seconds);
+
+  return 0;
+}
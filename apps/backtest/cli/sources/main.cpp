@@ -1,15 +1,206 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <exception>
 #include <format>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <jsoncons/json.hpp>
 
 import pludux.backtest;
 
+namespace {
+
+auto sweep_parameter_label(std::string_view path) -> std::string_view
+{
+  return path.substr(path.rfind('/') + 1);
+}
+
+auto format_sweep_values(
+ const std::vector<pludux::backtest::SweepParameter>& parameters,
+ const std::vector<double>& values) -> std::string
+{
+  auto formatted = std::string{};
+  for(auto i = 0uz; i < parameters.size(); ++i) {
+    formatted += std::format("{}{}={:g}",
+                             i == 0 ? "" : " ",
+                             sweep_parameter_label(parameters[i].path),
+                             values[i]);
+  }
+  return formatted;
+}
+
+/**
+ * Optimize the sweep parameters on rolling train windows and print the
+ * out-of-sample result of every test window as it finishes.
+ */
+auto run_walk_forward(const jsoncons::ojson& walk_forward_json,
+                      jsoncons::ojson strategy_json,
+                      std::vector<pludux::backtest::SweepParameter> parameters,
+                      std::shared_ptr<pludux::backtest::Asset> asset_ptr,
+                      std::shared_ptr<pludux::backtest::Market> market_ptr,
+                      std::shared_ptr<pludux::backtest::Broker> broker_ptr,
+                      const pludux::backtest::Profile& profile,
+                      double initial_capital,
+                      std::size_t thread_count) -> int
+{
+  auto walk_forward = pludux::backtest::WalkForward{
+   std::move(strategy_json),
+   profile,
+   std::move(asset_ptr),
+   std::move(market_ptr),
+   std::move(broker_ptr),
+   initial_capital,
+   parameters,
+   walk_forward_json.at("train").as<std::size_t>(),
+   walk_forward_json.at("test").as<std::size_t>()};
+  walk_forward.warmup_bar_count(
+   walk_forward_json.get_value_or<std::size_t>("warmup", 0));
+  walk_forward.is_anchored(
+   walk_forward_json.get_value_or<bool>("anchored", false));
+
+  auto& ostream = std::cout;
+  ostream << std::format("Walking forward over {} windows\n",
+                         walk_forward.windows().size());
+
+  const auto result = walk_forward.run(thread_count, [&](const auto& window) {
+    ostream << std::format("Test bars {}-{}: ",
+                           window.test_begin,
+                           window.test_end - 1);
+    if(window.is_failed()) {
+      ostream << std::format("failed: {}\n", window.error);
+    } else {
+      ostream << std::format(
+       "{}, train profit {:.2f}, test profit {:.2f}, {} trades\n",
+       format_sweep_values(parameters, window.values),
+       window.train_profit,
+       window.test_profit,
+       window.test_trade_count);
+    }
+  });
+
+  ostream << "\n\n";
+  ostream << "OUT-OF-SAMPLE\n";
+  ostream << "-------------\n";
+  ostream << std::format("Total profit: {:.2f}\n", result.total_profit);
+
+  auto peak_equity = initial_capital;
+  auto max_drawdown = 0.0;
+  for(const auto equity : result.equities) {
+    peak_equity = std::max(peak_equity, equity);
+    max_drawdown = std::max(max_drawdown, peak_equity - equity);
+  }
+  ostream << std::format("Max drawdown: {:.2f}\n", max_drawdown);
+
+  return 0;
+}
+
+/**
+ * Backtest every variant of the sweep described by the sweep JSON, printing
+ * each variant as it finishes and then the best variants ranked by their
+ * total profit. A sweep JSON with a `walkForward` object of `train`, `test`
+ * and optional `warmup` bar counts and `anchored` flag walks forward instead.
+ */
+auto run_parameter_sweep(const std::string& sweep_path,
+                         const std::string& strategy_path,
+                         std::shared_ptr<pludux::backtest::Asset> asset_ptr,
+                         std::shared_ptr<pludux::backtest::Market> market_ptr,
+                         std::shared_ptr<pludux::backtest::Broker> broker_ptr,
+                         const pludux::backtest::Profile& profile,
+                         double initial_capital) -> int
+{
+  using json = jsoncons::ojson;
+
+  const auto json_options = jsoncons::json_options{}.allow_comments(true);
+
+  auto sweep_file = std::ifstream{sweep_path};
+  const auto sweep_json = json::parse(sweep_file, json_options);
+  auto strategy_file = std::ifstream{strategy_path};
+  auto strategy_json = json::parse(strategy_file, json_options);
+
+  const auto thread_count = sweep_json.get_value_or<std::size_t>("threads", 0);
+  const auto top_count = sweep_json.get_value_or<std::size_t>("top", 20);
+
+  auto sweep_parameters =
+   pludux::backtest::parse_parameter_sweep_json(sweep_json);
+
+  if(sweep_json.contains("walkForward")) {
+    return run_walk_forward(sweep_json.at("walkForward"),
+                            std::move(strategy_json),
+                            std::move(sweep_parameters),
+                            std::move(asset_ptr),
+                            std::move(market_ptr),
+                            std::move(broker_ptr),
+                            profile,
+                            initial_capital,
+                            thread_count);
+  }
+
+  const auto sweep =
+   pludux::backtest::ParameterSweep{std::move(strategy_json),
+                                    profile,
+                                    std::move(asset_ptr),
+                                    std::move(market_ptr),
+                                    std::move(broker_ptr),
+                                    initial_capital,
+                                    std::move(sweep_parameters)};
+  const auto& parameters = sweep.parameters();
+  const auto variant_count = sweep.variant_count();
+
+  auto& ostream = std::cout;
+  ostream << std::format("Sweeping {} variants\n", variant_count);
+
+  auto finished_count = 0uz;
+  const auto results = sweep.run(thread_count, [&](const auto& result) {
+    ++finished_count;
+    ostream << std::format("[{}/{}] {}: ",
+                           finished_count,
+                           variant_count,
+                           format_sweep_values(parameters, result.values));
+    if(result.is_failed()) {
+      ostream << std::format("failed: {}\n", result.error);
+    } else {
+      ostream << std::format("profit {:.2f}, {} trades\n",
+                             result.total_profit,
+                             result.trade_count);
+    }
+  });
+
+  ostream << "\n\n";
+  ostream << "RANKED VARIANTS\n";
+  ostream << "---------------\n";
+  for(auto i = 0uz; i < std::min(top_count, results.size()); ++i) {
+    const auto& result = results[i];
+    if(result.is_failed()) {
+      break;
+    }
+
+    ostream << std::format(
+     "{:>4}. {}\n"
+     "      Profit: {:.2f}, Trades: {}, Win rate: {:.2f}%, EV: {:.2f}, "
+     "Profit factor: {:.2f}, Max drawdown: {:.2f}\n",
+     i + 1,
+     format_sweep_values(parameters, result.values),
+     result.total_profit,
+     result.trade_count,
+     result.profit_rate * 100,
+     result.expected_value,
+     result.profit_factor,
+     result.max_drawdown);
+  }
+
+  return 0;
+}
+
+} // namespace
+
 auto main(int, const char**) -> int
 {
   using json = jsoncons::ojson;
@@ -18,22 +209,17 @@ auto main(int, const char**) -> int
    pludux::get_env_var("PLUDUX_BACKTEST_STRATEGY_JSON_PATH").value_or("");
   const auto asset_file =
    pludux::get_env_var("PLUDUX_BACKTEST_CSV_DATA_PATH").value_or("");
+  const auto json_sweep_path =
+   pludux::get_env_var("PLUDUX_BACKTEST_SWEEP_JSON_PATH");
 
-  auto json_strategy_file = std::ifstream{json_strategy_path};
-  auto strategy = pludux::backtest::parse_backtest_strategy_json(
-   "Strategy", json_strategy_file);
-  auto strategy_ptr = std::make_shared<pludux::backtest::Strategy>(strategy);
-
-  auto csv_stream = std::ifstream{asset_file};
-
-  if(!csv_stream.is_open()) {
-    std::cerr << "Could not open file: " << asset_file << std::endl;
+  auto asset_ptr = std::make_shared<pludux::backtest::Asset>(asset_file);
+  try {
+    pludux::update_asset_from_csv_file(*asset_ptr, asset_file);
+  } catch(const std::exception& error) {
+    std::cerr << error.what() << std::endl;
     return 1;
   }
 
-  auto asset_ptr = std::make_shared<pludux::backtest::Asset>(asset_file);
-  pludux::update_asset_from_csv(*asset_ptr, csv_stream);
-
   auto profile_ptr = std::make_shared<pludux::backtest::Profile>("Default");
   profile_ptr->capital_risk(0.01);
 
@@ -43,6 +229,26 @@ auto main(int, const char**) -> int
 
   const auto intial_capital = 1'000'000;
 
+  if(json_sweep_path) {
+    try {
+      return run_parameter_sweep(*json_sweep_path,
+                                 json_strategy_path,
+                                 asset_ptr,
+                                 market_ptr,
+                                 broker_ptr,
+                                 *profile_ptr,
+                                 intial_capital);
+    } catch(const std::exception& error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+  }
+
+  auto json_strategy_file = std::ifstream{json_strategy_path};
+  auto strategy = pludux::backtest::parse_backtest_strategy_json(
+   "Strategy", json_strategy_file);
+  auto strategy_ptr = std::make_shared<pludux::backtest::Strategy>(strategy);
+
   auto backtest = pludux::backtest::Backtest{"no name",
                                              intial_capital,
                                              asset_ptr,
@@ -54,10 +260,8 @@ auto main(int, const char**) -> int
     backtest.run();
   }
 
-  const auto& backtest_summaries = backtest.summaries();
-  const auto& summary = !backtest_summaries.empty()
-                         ? backtest_summaries.back()
-                         : pludux::backtest::BacktestSummary{};
+  const auto& backtest_results = backtest.results();
+  const auto& summary = backtest_results.last_summary();
 
   auto& ostream = std::cout;
 
@@ -103,31 +307,83 @@ auto main(int, const char**) -> int
                          summary.break_even_rate() * 100);
   ostream << "\n\n";
 
-  // iterate through the trades
-  std::cout << "Trades: " << std::endl;
-  // auto is_in_trade = false;
+  const auto monte_carlo_iterations =
+   pludux::get_env_var("PLUDUX_BACKTEST_MONTE_CARLO_ITERATIONS");
+  if(monte_carlo_iterations) {
+    auto monte_carlo = pludux::backtest::MonteCarlo{
+     pludux::backtest::closed_trade_pnls(backtest_results), intial_capital};
+    monte_carlo.iteration_count(std::stoull(*monte_carlo_iterations));
+    monte_carlo.skip_rate(std::stod(
+     pludux::get_env_var("PLUDUX_BACKTEST_MONTE_CARLO_SKIP_RATE")
+      .value_or("0")));
+    if(pludux::get_env_var("PLUDUX_BACKTEST_MONTE_CARLO_RESAMPLE")) {
+      monte_carlo.sampling(pludux::backtest::MonteCarlo::Sampling::Resample);
+    }
 
-  for(int i = 0, ii = backtest_summaries.size(); i < ii; ++i) {
-    const auto& session = backtest_summaries[i].trade_session();
-    for(const auto& record : session.trade_record_range()) {
-      if(!record.is_open() || i == ii - 1) {
-        const auto entry_timestamp = record.entry_timestamp();
-        const auto exit_timestamp = record.exit_timestamp();
-        std::cout << "Entry date: " << pludux::format_datetime(entry_timestamp)
-                  << std::endl
-                  << "Exit date: "
-                  << (record.is_open()
-                       ? "N/A"
-                       : pludux::format_datetime(exit_timestamp))
-                  << std::endl
-                  << "Position size: " << record.position_size() << std::endl
-                  << "Reason: " << static_cast<int>(record.status())
-                  << std::endl
-                  << "Profit: " << record.pnl() << std::endl
-                  << std::endl;
+    const auto result = monte_carlo.run();
+
+    ostream << "MONTE CARLO\n";
+    ostream << "-----------\n";
+    ostream << std::format("Iterations: {}\n", monte_carlo.iteration_count());
+    ostream << std::format("Loss probability: {:.2f}%\n",
+                           result.loss_probability() * 100);
+    for(const auto percent : {5.0, 25.0, 50.0, 75.0, 95.0}) {
+      ostream << std::format(
+       "P{:<2g} profit: {:.2f}, max drawdown: {:.2f}%\n",
+       percent,
+       result.profit_percentile(percent),
+       result.drawdown_percentile(percent));
+    }
+    ostream << "\n\n";
+  }
+
+  const auto& clause_orders = backtest.condition_statistics().clause_orders();
+  if(!clause_orders.empty()) {
+    ostream << "CONDITIONS\n";
+    ostream << "----------\n";
+    for(const auto& clause_order : clause_orders) {
+      ostream << std::format("{} evaluated {} times, in clause order:\n",
+                             clause_order.deciding_result() ? "ANY_OF"
+                                                            : "ALL_OF",
+                             clause_order.evaluation_count());
+      for(const auto clause : clause_order.order()) {
+        const auto& statistics = clause_order.clauses()[clause];
+        ostream << std::format("  Clause {}: hit rate {:.2f}%, {:.1f} ns\n",
+                               clause + 1,
+                               statistics.hit_rate() * 100,
+                               statistics.cost());
       }
     }
+    ostream << "\n\n";
   }
 
+  // iterate through the trades
+  std::cout << "Trades: " << std::endl;
+  // auto is_in_trade = false;
+
+  const auto last_index = backtest_results.size() - 1;
+  backtest_results.for_each_summary(
+   [&](std::size_t i, const pludux::backtest::BacktestSummary& bar_summary) {
+     const auto& session = bar_summary.trade_session();
+     for(const auto& record : session.trade_record_range()) {
+       if(!record.is_open() || i == last_index) {
+         const auto entry_timestamp = record.entry_timestamp();
+         const auto exit_timestamp = record.exit_timestamp();
+         std::cout << "Entry date: "
+                   << pludux::format_datetime(entry_timestamp) << std::endl
+                   << "Exit date: "
+                   << (record.is_open()
+                        ? "N/A"
+                        : pludux::format_datetime(exit_timestamp))
+                   << std::endl
+                   << "Position size: " << record.position_size() << std::endl
+                   << "Reason: " << static_cast<int>(record.status())
+                   << std::endl
+                   << "Profit: " << record.pnl() << std::endl
+                   << std::endl;
+       }
+     }
+   });
+
   return 0;
 }
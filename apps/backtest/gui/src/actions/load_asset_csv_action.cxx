@@ -45,12 +45,10 @@ public:
       std::istringstream csv_stream{self.source_};
       self.load_asset_csv(self.asset_name_, csv_stream, app_state);
     } else if constexpr(std::same_as<std::filesystem::path, TSource>) {
-      std::ifstream csv_stream{self.source_};
-      if(!csv_stream.is_open()) {
-        throw std::runtime_error{"Failed to open file: " +
-                                 self.source_.string()};
-      }
-      self.load_asset_csv(self.asset_name_, csv_stream, app_state);
+      auto asset_ptr = std::make_shared<backtest::Asset>(self.asset_name_);
+      pludux::update_asset_from_csv_file(*asset_ptr, self.source_);
+
+      app_state.add_asset(std::move(asset_ptr));
     }
   }
 
@@ -230,8 +230,7 @@ public:
 
       self.profiles_window_.render(window_context);
 
-      auto trade_journal = TradeJournalWindow{};
-      trade_journal.render(window_context);
+      self.trade_journal_window_.render(window_context);
 
     } catch(const std::exception& e) {
       const auto error_message = std::format("Error: {}", e.what());
@@ -262,6 +261,7 @@ private:
   MarketsWindow markets_window_;
   BrokersWindow brokers_window_;
   ProfilesWindow profiles_window_;
+  TradeJournalWindow trade_journal_window_;
 
   ApplicationState app_state_;
   std::queue<PolyAction> actions_;
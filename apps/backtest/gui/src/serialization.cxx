@@ -20,6 +20,7 @@ module;
 #include <cereal/types/string.hpp>
 #include <cereal/types/unordered_map.hpp>
 #include <cereal/types/utility.hpp>
+#include <cereal/types/variant.hpp>
 #include <cereal/types/vector.hpp>
 
 export module pludux.apps.backtest:serialization;
@@ -32,7 +33,13 @@ export namespace cereal {
 template<class Archive>
 void save(Archive& archive, const pludux::SeriesResultsCollector& collector)
 {
-  archive(make_nvp("results", collector.results()));
+  auto results = std::unordered_map<std::string, std::vector<double>>{};
+  for(const auto& series_name : collector.series_names()) {
+    const auto column = collector.results(series_name).value();
+    results.emplace(series_name,
+                    std::vector<double>(column.begin(), column.end()));
+  }
+  archive(make_nvp("results", results));
 }
 
 template<class Archive>
@@ -40,7 +47,11 @@ void load(Archive& archive, pludux::SeriesResultsCollector& collector)
 {
   auto results = std::unordered_map<std::string, std::vector<double>>{};
   archive(make_nvp("results", results));
-  collector.results(std::move(results));
+
+  collector.clear();
+  for(auto& [series_name, column] : results) {
+    collector.results(series_name, std::move(column));
+  }
 }
 
 template<class Archive>
@@ -253,6 +264,142 @@ void load(Archive& archive, pludux::backtest::BacktestSummary& summary)
 
 /*--------------------------------------------------------------------------------------*/
 
+template<class Archive>
+void save(Archive& archive, const pludux::backtest::TradeEntry& trade_entry)
+{
+  archive(make_nvp("positionSize", trade_entry.position_size()),
+          make_nvp("price", trade_entry.price()),
+          make_nvp("stopLossPrice", trade_entry.stop_loss_price()),
+          make_nvp("stopLossTrailingEnabled",
+                   trade_entry.stop_loss_trailing_enabled()),
+          make_nvp("takeProfitPrice", trade_entry.take_profit_price()));
+}
+
+template<class Archive>
+void load(Archive& archive, pludux::backtest::TradeEntry& trade_entry)
+{
+  auto position_size = double{};
+  auto price = double{};
+  auto stop_loss_price = double{};
+  auto stop_loss_trailing_enabled = bool{};
+  auto take_profit_price = double{};
+
+  archive(make_nvp("positionSize", position_size),
+          make_nvp("price", price),
+          make_nvp("stopLossPrice", stop_loss_price),
+          make_nvp("stopLossTrailingEnabled", stop_loss_trailing_enabled),
+          make_nvp("takeProfitPrice", take_profit_price));
+
+  trade_entry = pludux::backtest::TradeEntry{position_size,
+                                             price,
+                                             stop_loss_price,
+                                             stop_loss_trailing_enabled,
+                                             take_profit_price};
+}
+
+template<class Archive>
+void save(Archive& archive, const pludux::backtest::TradeExit& trade_exit)
+{
+  const auto reason = static_cast<std::size_t>(trade_exit.reason());
+  archive(make_nvp("positionSize", trade_exit.position_size()),
+          make_nvp("price", trade_exit.price()),
+          make_nvp("reason", reason));
+}
+
+template<class Archive>
+void load(Archive& archive, pludux::backtest::TradeExit& trade_exit)
+{
+  auto position_size = double{};
+  auto price = double{};
+  auto reason = std::size_t{};
+
+  archive(make_nvp("positionSize", position_size),
+          make_nvp("price", price),
+          make_nvp("reason", reason));
+
+  trade_exit = pludux::backtest::TradeExit{
+   position_size,
+   price,
+   static_cast<pludux::backtest::TradeExit::Reason>(reason)};
+}
+
+template<class Archive>
+void save(Archive& archive,
+          const pludux::backtest::BacktestTradeEvent& trade_event)
+{
+  archive(
+   make_nvp("barIndex", trade_event.bar_index),
+   make_nvp("trade", trade_event.trade),
+   make_nvp("fee", trade_event.fee),
+   make_nvp("stopLossTrailingPrice", trade_event.stop_loss_trailing_price));
+}
+
+template<class Archive>
+void load(Archive& archive, pludux::backtest::BacktestTradeEvent& trade_event)
+{
+  archive(
+   make_nvp("barIndex", trade_event.bar_index),
+   make_nvp("trade", trade_event.trade),
+   make_nvp("fee", trade_event.fee),
+   make_nvp("stopLossTrailingPrice", trade_event.stop_loss_trailing_price));
+}
+
+template<class Archive>
+void save(Archive& archive, const pludux::backtest::BacktestResults& results)
+{
+  archive(make_nvp("initialCapital", results.initial_capital()),
+          make_nvp("marketTimestamps", results.market_timestamps()),
+          make_nvp("marketPrices", results.market_prices()),
+          make_nvp("marketLookbacks", results.market_lookbacks()),
+          make_nvp("stopLossTrailingPrices",
+                   results.stop_loss_trailing_prices()),
+          make_nvp("capitals", results.capitals()),
+          make_nvp("equities", results.equities()),
+          make_nvp("drawdowns", results.drawdowns()),
+          make_nvp("tradeEvents", results.trade_events()),
+          make_nvp("lastSummary", results.last_summary()));
+}
+
+template<class Archive>
+void load(Archive& archive, pludux::backtest::BacktestResults& results)
+{
+  auto initial_capital = double{};
+  auto market_timestamps = std::vector<std::time_t>{};
+  auto market_prices = std::vector<double>{};
+  auto market_lookbacks = std::vector<std::size_t>{};
+  auto stop_loss_trailing_prices = std::vector<double>{};
+  auto capitals = std::vector<double>{};
+  auto equities = std::vector<double>{};
+  auto drawdowns = std::vector<double>{};
+  auto trade_events = std::vector<pludux::backtest::BacktestTradeEvent>{};
+  auto last_summary = pludux::backtest::BacktestSummary{};
+
+  archive(make_nvp("initialCapital", initial_capital),
+          make_nvp("marketTimestamps", market_timestamps),
+          make_nvp("marketPrices", market_prices),
+          make_nvp("marketLookbacks", market_lookbacks),
+          make_nvp("stopLossTrailingPrices", stop_loss_trailing_prices),
+          make_nvp("capitals", capitals),
+          make_nvp("equities", equities),
+          make_nvp("drawdowns", drawdowns),
+          make_nvp("tradeEvents", trade_events),
+          make_nvp("lastSummary", last_summary));
+
+  results =
+   pludux::backtest::BacktestResults{initial_capital,
+                                     std::move(market_timestamps),
+                                     std::move(market_prices),
+                                     std::move(market_lookbacks),
+                                     std::move(stop_loss_trailing_prices),
+                                     std::move(capitals),
+                                     std::move(equities),
+                                     std::move(drawdowns),
+                                     std::move(trade_events),
+                                     std::move(last_summary)};
+}
+
+/*--------------------------------------------------------------------------------------*/
+
 template<class Archive>
 void save(Archive& archive, const pludux::backtest::Strategy& strategy)
 {
@@ -511,7 +658,7 @@ void save(Archive& archive, const pludux::backtest::Backtest& backtest)
    make_nvp("market", backtest.market_ptr()),
    make_nvp("broker", backtest.broker_ptr()),
    make_nvp("profile", backtest.profile_ptr()),
-   make_nvp("summaries", backtest.summaries()),
+   make_nvp("results", backtest.results()),
    make_nvp("isFailed", backtest.is_failed()),
    make_nvp("seriesResultsCollector", backtest.series_results_collector()));
 }
@@ -526,7 +673,7 @@ void load(Archive& archive, pludux::backtest::Backtest& backtest)
   auto market_ptr = std::shared_ptr<pludux::backtest::Market>{};
   auto broker_ptr = std::shared_ptr<pludux::backtest::Broker>{};
   auto profile_ptr = std::shared_ptr<pludux::backtest::Profile>{};
-  auto summaries = std::vector<pludux::backtest::BacktestSummary>{};
+  auto results = pludux::backtest::BacktestResults{};
   auto is_failed = bool{};
   auto series_results_collector = pludux::SeriesResultsCollector{};
 
@@ -537,7 +684,7 @@ void load(Archive& archive, pludux::backtest::Backtest& backtest)
           make_nvp("market", market_ptr),
           make_nvp("broker", broker_ptr),
           make_nvp("profile", profile_ptr),
-          make_nvp("summaries", summaries),
+          make_nvp("results", results),
           make_nvp("isFailed", is_failed),
           make_nvp("seriesResultsCollector", series_results_collector));
 
@@ -548,7 +695,7 @@ void load(Archive& archive, pludux::backtest::Backtest& backtest)
                                         market_ptr,
                                         broker_ptr,
                                         profile_ptr,
-                                        std::move(summaries),
+                                        std::move(results),
                                         std::move(series_results_collector)};
 
   if(is_failed) {
@@ -320,14 +320,8 @@ private:
          NFD::OpenDialog(in_path, filter_item.data(), filter_item.size());
         if(result == NFD_OKAY) {
           const auto selected_path = std::string(in_path.get());
-          auto csv_stream = std::ifstream{selected_path};
-          if(!csv_stream.is_open()) {
-            const auto error_message =
-             std::format("Failed to open file: {}", selected_path);
-            throw std::runtime_error(error_message);
-          }
-
-          pludux::update_asset_from_csv(*self.editing_asset_ptr_, csv_stream);
+          pludux::update_asset_from_csv_file(*self.editing_asset_ptr_,
+                                             selected_path);
 
           if(self.editing_asset_ptr_->name().empty()) {
             self.editing_asset_ptr_->name(
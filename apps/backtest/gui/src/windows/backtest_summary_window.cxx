@@ -30,11 +30,11 @@ public:
       ImGui::Text("%s", backtest_name.c_str());
       ImGui::Separator();
 
-      const auto& backtesting_summaries = backtest->summaries();
-      if(!backtesting_summaries.empty() &&
+      const auto& backtest_results = backtest->results();
+      if(!backtest_results.empty() &&
          ImGui::BeginTable(
           "TradeSummaryTable", 2, ImGuiTableFlags_BordersInnerH)) {
-        const auto& summary = backtesting_summaries.back();
+        const auto& summary = backtest_results.last_summary();
 
         self.draw_row("Asset", backtest->asset().name());
         self.draw_row("Strategy", backtest->strategy().name());
@@ -7,11 +7,12 @@ module;
 #include <format>
 #include <iomanip>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
 #include <imgui.h>
@@ -27,10 +28,9 @@ namespace pludux::apps {
 
 class PlotContext {
 public:
-  PlotContext(
-   const std::unordered_map<std::string, std::vector<double>>& series_results,
-   std::size_t results_size,
-   bool overlay)
+  PlotContext(const SeriesResultsCollector& series_results,
+              std::size_t results_size,
+              bool overlay)
   : series_results_{series_results}
   , results_size_{results_size}
   , overlay_{overlay}
@@ -38,7 +38,7 @@ public:
   }
 
   void render_plot_line(this const PlotContext& self,
-                        const std::vector<double>& data,
+                        std::span<const double> data,
                         std::uint32_t color)
   {
     const auto summaries_size = self.results_size_;
@@ -76,7 +76,7 @@ public:
   }
 
   void render_plot_histogram(this const PlotContext& self,
-                             const std::vector<double>& data,
+                             std::span<const double> data,
                              std::uint32_t color)
   {
     const auto summaries_size = self.results_size_;
@@ -114,12 +114,9 @@ public:
   }
 
   auto series_results(this const PlotContext& self, const std::string& name)
-   -> std::optional<std::reference_wrapper<const std::vector<double>>>
+   -> std::optional<std::span<const double>>
   {
-    const auto it = self.series_results_.find(name);
-    return it != self.series_results_.end()
-            ? std::make_optional(std::cref(it->second))
-            : std::nullopt;
+    return self.series_results_.results(name);
   }
 
   auto results_size(this const PlotContext& self) -> std::size_t
@@ -128,7 +125,7 @@ public:
   }
 
 private:
-  const std::unordered_map<std::string, std::vector<double>>& series_results_;
+  const SeriesResultsCollector& series_results_;
   std::size_t results_size_;
 
   bool overlay_;
@@ -160,7 +157,7 @@ public:
     }
 
     const auto& asset = backtest->asset();
-    const auto& backtest_summaries = backtest->summaries();
+    const auto& backtest_results = backtest->results();
     const auto is_backtest_should_run = backtest->should_run();
 
     const auto& plots = backtest->strategy().plots();
@@ -216,7 +213,7 @@ public:
         ImPlot::SetupAxis(ImAxis_Y1, "% Equity", axis_y_flags);
         ImPlot::SetupAxisFormat(ImAxis_Y1, "%.0f");
 
-        self.plot_equity(backtest_summaries);
+        self.plot_equity(backtest_results);
 
         ImPlot::EndPlot();
       }
@@ -230,9 +227,9 @@ public:
         ImPlot::SetupAxis(ImAxis_Y1, "Price", axis_y_flags);
         ImPlot::SetupAxisFormat(ImAxis_Y1, "%.0f");
 
-        self.draw_trades("Trades", backtest_summaries, asset);
-        self.ticker_tooltip(backtest_summaries, asset, true);
-        self.plot_ohlc("OHLC", backtest_summaries, asset);
+        self.draw_trades("Trades", backtest_results, asset);
+        self.ticker_tooltip(backtest_results, asset, true);
+        self.plot_ohlc("OHLC", backtest_results, asset);
         self.overlays_plots(context);
 
         ImPlot::EndPlot();
@@ -253,20 +250,20 @@ public:
          ImAxis_Y1, "Volume", axis_y_flags | ImPlotAxisFlags_LockMin);
         ImPlot::SetupAxisFormat(ImAxis_Y1, volume_formatter);
 
-        self.ticker_tooltip(backtest_summaries, asset, true);
-        self.plot_volume("Volume", backtest_summaries, asset);
+        self.ticker_tooltip(backtest_results, asset, true);
+        self.plot_volume("Volume", backtest_results, asset);
 
         ImPlot::EndPlot();
       }
 
-      const auto& series_results = backtest->series_results();
+      const auto& series_results = backtest->series_results_collector();
       // TODO: use std::view::enumerate when it's available
       auto i = 0;
       for(const auto& plot_group : plots | no_overlays_view) {
         const auto plot_id = std::format("##Plot{}", i);
 
         const auto context_for_plots = PlotContext{
-         series_results, backtest->summaries().size(), plot_group.is_overlay()};
+         series_results, backtest->results().size(), plot_group.is_overlay()};
 
         if(ImPlot::BeginPlot(plot_id.c_str(), plot_size, plot_flags)) {
           const auto is_last_plot = i == additional_plots_count - 1;
@@ -312,10 +309,11 @@ private:
 
   std::vector<float> row_ratios_;
 
-  static void ticker_tooltip(
-   const std::vector<backtest::BacktestSummary>& backtest_summaries,
-   const backtest::Asset& asset,
-   bool span_subplots)
+  backtest::BacktestTradeRecords trade_records_;
+
+  static void ticker_tooltip(const backtest::BacktestResults& backtest_results,
+                             const backtest::Asset& asset,
+                             bool span_subplots)
   {
     ImDrawList* draw_list = ImPlot::GetPlotDrawList();
     const double half_width = 0.5;
@@ -336,9 +334,8 @@ private:
 
       const auto idx = static_cast<int>(mouse.x);
       if(ImPlot::IsPlotHovered() && idx > -1 &&
-         idx < backtest_summaries.size()) {
-        const auto& summary = backtest_summaries[idx];
-        const auto snapshot = get_asset_snapshot(summary, asset);
+         idx < backtest_results.size()) {
+        const auto snapshot = get_asset_snapshot(backtest_results, idx, asset);
 
         if(ImGui::BeginTooltip()) {
           ImGui::Text("Date:");
@@ -386,17 +383,15 @@ private:
     auto& context = *reinterpret_cast<WindowContext*>(user_data);
     const auto& app_state = context.app_state();
     const auto& backtest = app_state.selected_backtest();
-    const auto& summaries = backtest->summaries();
+    const auto& backtest_results = backtest->results();
 
     const auto idx = static_cast<std::ptrdiff_t>(value);
-    if(idx < 0 || idx >= summaries.size()) {
+    if(idx < 0 || idx >= backtest_results.size()) {
       return snprintf(buff, size, "");
     }
 
-    const auto& backtest_summary = summaries.at(idx);
-
     const auto& asset = backtest->asset();
-    const auto& snapshot = get_asset_snapshot(backtest_summary, asset);
+    const auto& snapshot = get_asset_snapshot(backtest_results, idx, asset);
 
     const auto datetime = snapshot.datetime();
     const auto timestamp = static_cast<std::time_t>(datetime);
@@ -404,18 +399,18 @@ private:
     return std::strftime(buff, size, "%b %Y", &tm);
   }
 
-  static auto get_asset_snapshot(const backtest::BacktestSummary& summary,
+  static auto get_asset_snapshot(const backtest::BacktestResults& results,
+                                 std::size_t index,
                                  const backtest::Asset& asset) -> AssetSnapshot
   {
-    const auto& session = summary.trade_session();
-    const auto market_lookback = session.market_lookback();
+    const auto market_lookback = results.market_lookbacks()[index];
     return asset.get_snapshot(market_lookback);
   }
 
   void
   plot_ohlc(this const PlotDataWindow& self,
             const char* label_id,
-            const std::vector<backtest::BacktestSummary>& backtest_summaries,
+            const backtest::BacktestResults& backtest_results,
             const backtest::Asset& asset)
   {
     if(ImPlot::BeginItem(label_id)) {
@@ -423,9 +418,8 @@ private:
 
       auto* draw_list = ImPlot::GetPlotDrawList();
       constexpr double half_width = 0.3;
-      for(int i = 0, ii = backtest_summaries.size(); i < ii; ++i) {
-        const auto& summary = backtest_summaries[i];
-        const auto snapshot = get_asset_snapshot(summary, asset);
+      for(int i = 0, ii = backtest_results.size(); i < ii; ++i) {
+        const auto snapshot = get_asset_snapshot(backtest_results, i, asset);
 
         const auto open = snapshot.open();
         const auto high = snapshot.high();
@@ -461,9 +455,8 @@ private:
       }
 
       if(ImPlot::FitThisFrame()) {
-        for(int i = 0; i < backtest_summaries.size(); ++i) {
-          const auto& summary = backtest_summaries[i];
-          const auto snapshot = get_asset_snapshot(summary, asset);
+        for(int i = 0; i < backtest_results.size(); ++i) {
+          const auto snapshot = get_asset_snapshot(backtest_results, i, asset);
 
           ImPlot::FitPoint(ImPlotPoint(i, snapshot.low()));
           ImPlot::FitPoint(ImPlotPoint(i, snapshot.high()));
@@ -477,16 +470,15 @@ private:
   void
   plot_volume(this const PlotDataWindow& self,
               const char* label_id,
-              const std::vector<backtest::BacktestSummary>& backtest_summaries,
+              const backtest::BacktestResults& backtest_results,
               const backtest::Asset& asset)
   {
     if(ImPlot::BeginItem(label_id)) {
       ImPlot::GetCurrentItem()->Color = ImGui::GetColorU32(self.bullish_color_);
 
       if(ImPlot::FitThisFrame()) {
-        for(int i = 0; i < backtest_summaries.size(); ++i) {
-          const auto& summary = backtest_summaries[i];
-          const auto snapshot = get_asset_snapshot(summary, asset);
+        for(int i = 0; i < backtest_results.size(); ++i) {
+          const auto snapshot = get_asset_snapshot(backtest_results, i, asset);
 
           ImPlot::FitPoint(ImPlotPoint(i, 0));
           ImPlot::FitPoint(ImPlotPoint(i, snapshot.volume()));
@@ -495,9 +487,8 @@ private:
 
       auto* draw_list = ImPlot::GetPlotDrawList();
       constexpr auto half_width = 0.3;
-      for(int i = 0, ii = backtest_summaries.size(); i < ii; ++i) {
-        const auto& summary = backtest_summaries[i];
-        const auto snapshot = get_asset_snapshot(summary, asset);
+      for(int i = 0, ii = backtest_results.size(); i < ii; ++i) {
+        const auto snapshot = get_asset_snapshot(backtest_results, i, asset);
 
         const auto open = snapshot.open();
         const auto close = snapshot.close();
@@ -526,9 +517,9 @@ private:
   }
 
   void
-  draw_trades(this const PlotDataWindow& self,
+  draw_trades(this PlotDataWindow& self,
               const char* label_id,
-              const std::vector<backtest::BacktestSummary>& backtest_summaries,
+              const backtest::BacktestResults& backtest_results,
               const backtest::Asset& asset)
   {
     constexpr auto marker_offset = 50.0f;
@@ -539,16 +530,17 @@ private:
     constexpr float half_width = 0.5f;
     if(ImPlot::BeginItem(label_id)) {
       const auto asset_size = asset.history().size();
-      const auto summaries_size = backtest_summaries.size();
+      const auto summaries_size = backtest_results.size();
       auto trailing_stop_lines = std::vector<ImVec2>{};
       trailing_stop_lines.reserve(summaries_size);
 
-      for(auto i = std::size_t{0}; i < summaries_size; ++i) {
-        const auto& summary = backtest_summaries[i];
-        const auto snapshot = get_asset_snapshot(summary, asset);
-        const auto& session = summary.trade_session();
+      // The trade records are replayed only when the results change.
+      self.trade_records_.update(backtest_results);
+      for(const auto& bar_trades : self.trade_records_.bars()) {
+        const auto i = bar_trades.bar_index;
+        const auto snapshot = get_asset_snapshot(backtest_results, i, asset);
 
-        for(const auto& record : session.trade_record_range()) {
+        for(const auto& record : bar_trades.trade_records) {
           const auto is_long_position = record.is_long_position();
           const auto exit_price = record.exit_price();
           const auto take_profit_price = record.take_profit_price();
@@ -626,8 +618,9 @@ private:
             // TODO: Visual Studio 2026 have bug with include <format> causing
             // compile error
             const auto trade_count_str =
-             std::string("#") + std::to_string(summary.trade_count() + 1);
-            const auto text_size = ImGui::CalcTextSize(trade_count_str.c_str());
+             std::string("#") + std::to_string(bar_trades.trade_count + 1);
+            const auto text_size =
+             ImGui::CalcTextSize(trade_count_str.c_str());
             draw_list->AddText(
              ImVec2{entry_pos.x - text_size.x * 0.5f, entry_pos.y},
              marker_text_color,
@@ -647,10 +640,10 @@ private:
                ImVec2{exit_pos.x, exit_pos.y + 10},
                ImGui::GetColorU32(self.bearish_color_));
 
-              // TODO: Visual Studio 2026 have bug with include <format> causing
-              // compile error
+              // TODO: Visual Studio 2026 have bug with include <format>
+              // causing compile error
               const auto trade_count_str =
-               std::string("#") + std::to_string(summary.trade_count());
+               std::string("#") + std::to_string(bar_trades.trade_count);
               const auto text_size =
                ImGui::CalcTextSize(trade_count_str.c_str());
               draw_list->AddText(
@@ -702,17 +695,17 @@ private:
     }
   }
 
-  void
-  plot_equity(this const PlotDataWindow& self,
-              const std::vector<backtest::BacktestSummary>& backtest_summaries)
+  void plot_equity(this const PlotDataWindow& self,
+                   const backtest::BacktestResults& backtest_results)
   {
-    const auto summaries_size = backtest_summaries.size();
+    const auto& equities = backtest_results.equities();
+    const auto initial_capital = backtest_results.initial_capital();
+    const auto summaries_size = equities.size();
     auto xs = std::vector<double>{};
     auto ys = std::vector<double>{};
     for(auto summary_i = 0; summary_i < summaries_size; ++summary_i) {
-      const auto& summary = backtest_summaries[summary_i];
-      const auto equity = summary.equity();
-      const auto equity_percentage = equity / summary.initial_capital() * 100.0;
+      const auto equity = equities[summary_i];
+      const auto equity_percentage = equity / initial_capital * 100.0;
       const auto plot_idx = summary_i;
       xs.push_back(plot_idx);
       ys.push_back(equity_percentage);
@@ -758,12 +751,12 @@ private:
   {
     const auto& app_state = context.app_state();
     const auto& backtest = app_state.selected_backtest();
-    const auto& series_results = backtest->series_results();
+    const auto& series_results = backtest->series_results_collector();
     const auto& strategy = backtest->strategy();
     const auto& plots = strategy.plots();
 
     const auto context_for_plots =
-     PlotContext{series_results, backtest->summaries().size(), true};
+     PlotContext{series_results, backtest->results().size(), true};
 
     for(const auto& plot_group :
         plots | std::views::filter([](const auto& plot_group) {
@@ -1,10 +1,13 @@
 module;
 
 #include <chrono>
+#include <cstddef>
 #include <ctime>
 #include <format>
 #include <ranges>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <imgui.h>
 
@@ -16,7 +19,7 @@ export namespace pludux::apps {
 
 class TradeJournalWindow {
 public:
-  void render(this const TradeJournalWindow, WindowContext& context)
+  void render(this TradeJournalWindow& self, WindowContext& context)
   {
     const auto& app_state = context.app_state();
     const auto& backtests = context.backtests();
@@ -58,18 +61,16 @@ public:
 
         ImGui::TableHeadersRow();
 
-        const auto& backtest_summaries = backtest->summaries();
-        const auto backtest_summaries_size = backtest_summaries.size();
-        for(int i = backtest_summaries_size - 1; i >= 0; --i) {
-          const auto& summary = backtest_summaries.at(i);
-          const auto& trade_session = summary.trade_session();
-          const auto asset_index = backtest_summaries_size - i - 1;
-
+        // The trade records are replayed only when the results change, then
+        // listed latest first.
+        self.trade_records_.update(backtest->results());
+        for(const auto& bar_trades :
+            self.trade_records_.bars() | std::views::reverse) {
           auto id_counter = 0;
-          for(const auto& trade_record : trade_session.trade_record_range()) {
-            if(trade_record.is_closed() || i == 0) {
+          for(const auto& trade_record : bar_trades.trade_records) {
+            if(trade_record.is_closed() || bar_trades.bar_index == 0) {
               const auto trade_count =
-               summary.trade_count() + (trade_record.is_open() ? 1 : 0);
+               bar_trades.trade_count + (trade_record.is_open() ? 1 : 0);
 
               ImGui::PushID(id_counter++);
               draw_trade_row(trade_count, trade_record);
@@ -86,6 +87,8 @@ public:
   }
 
 private:
+  backtest::BacktestTradeRecords trade_records_;
+
   static void draw_trade_row(int trade_count,
                              const backtest::TradeRecord& trade)
   {
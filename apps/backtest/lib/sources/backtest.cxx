@@ -4,20 +4,25 @@ module;
 #include <chrono>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <filesystem>
 #include <format>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
 #include <vector>
 
-#include <ctre.hpp>
-#include <rapidcsv.h>
-
 export module pludux.backtest;
 
 export import pludux;
 
 export import :asset;
+export import :asset_csv_reader;
+export import :asset_cache;
 export import :strategy;
 export import :market;
 export import :broker;
@@ -29,6 +34,12 @@ export import :trade_position;
 export import :trade_session;
 export import :backtest;
 export import :backtest_summary;
+export import :backtest_results;
+export import :column_cache;
+export import :parameter_sweep;
+export import :walk_forward;
+export import :monte_carlo;
+export import :portfolio_backtest;
 export import :plot_group;
 export import :plots;
 
@@ -44,91 +55,83 @@ auto get_env_var(std::string_view var_name) -> std::optional<std::string>
 
 void update_asset_from_csv(backtest::Asset& asset, std::istream& csv_stream)
 {
-  auto csv_doc = rapidcsv::Document(csv_stream);
-  const auto column_count = csv_doc.GetColumnCount();
+  auto [headers, columns] = backtest::read_asset_csv_columns(csv_stream);
 
-  if(column_count == 0) {
+  if(headers.empty()) {
     return;
   }
 
-  constexpr auto date_record_index = 0;
-  const auto first_records = csv_doc.GetColumn<std::string>(date_record_index);
-  auto date_records = std::vector<double>{};
-
-  constexpr auto date_regex_match =
-   ctre::match<"^"
-               "(\\d{4})-(\\d{2})-(\\d{2})" // YYYY-MM-DD
-               "(?:[T ](\\d{2}):(\\d{2})"   // hh:mm
-               "(?::(\\d{2}(?:\\.\\d+)?))?" // :ss.s
-               "(Z|[+\\-]\\d{2}:\\d{2})"    // Z or +hh:mm or -hh:mm
-               ")?"
-               "$">;
-
-  std::transform(
-   first_records.cbegin(),
-   first_records.cend(),
-   std::back_inserter(date_records),
-   [&date_regex_match](const std::string& date) -> double {
-     const auto date_match = date_regex_match(date);
-
-     if(!date_match) {
-       auto timestamp = std::stod(date);
-       return timestamp;
-     }
-
-     const auto year = date_match.template get<1>().str();
-     const auto month = date_match.template get<2>().str();
-     const auto day = date_match.template get<3>().str();
-     const auto hour =
-      date_match.template get<4>().to_optional_string().value_or("00");
-     const auto minute =
-      date_match.template get<5>().to_optional_string().value_or("00");
-     const auto second =
-      date_match.template get<6>().to_optional_string().value_or("00");
-     const auto timezone =
-      date_match.template get<7>().to_optional_string().value_or("Z");
-
-     const auto date_str = std::format(
-      "{}-{}-{}T{}:{}:{}{}", year, month, day, hour, minute, second, timezone);
-     auto datetime_tm = std::tm{};
-     auto date_stream = std::istringstream{date_str};
-     date_stream >> std::get_time(&datetime_tm, "%Y-%m-%dT%H:%M:%S%z");
-     const auto timestamp = std::mktime(&datetime_tm);
-     return static_cast<double>(timestamp);
-   });
-
-  const auto should_reverse = date_records.front() < date_records.back();
-  if(should_reverse) {
-    std::reverse(date_records.begin(), date_records.end());
-  }
+  // Assets are stored in chronological order, which is how most sources list
+  // them. Only sources listing the latest bar first need to be reversed.
+  const auto& date_records = columns.front();
+  const auto is_latest_first =
+   !date_records.empty() && date_records.front() > date_records.back();
 
   auto field_data = std::vector<std::pair<std::string, pludux::AssetData>>{};
+  field_data.reserve(headers.size());
 
-  const auto date_record_header = csv_doc.GetColumnName(date_record_index);
-  field_data.emplace_back(
-   date_record_header,
-   pludux::AssetData(date_records.begin(), date_records.end()));
-
-  for(auto i = 1; i < column_count; ++i) {
-    auto column = csv_doc.GetColumn<double>(i);
-    if(should_reverse) {
+  for(auto i = 0uz; i < headers.size(); ++i) {
+    auto& column = columns[i];
+    if(is_latest_first) {
       std::reverse(column.begin(), column.end());
     }
 
-    const auto column_header = csv_doc.GetColumnName(i);
-    field_data.emplace_back(column_header,
-                            pludux::AssetData(column.begin(), column.end()));
+    field_data.emplace_back(headers[i], pludux::AssetData{std::move(column)});
   }
 
   auto asset_history = AssetHistory{field_data.begin(), field_data.end()};
 
   auto asset_field_resolver = AssetQuoteFieldResolver{};
-  asset_field_resolver.datetime_field(date_record_header);
+  asset_field_resolver.datetime_field(headers.front());
 
   asset.history(std::move(asset_history));
   asset.field_resolver(std::move(asset_field_resolver));
 }
 
+/**
+ * Update the asset from a CSV file like `update_asset_from_csv`, through the
+ * binary cache next to the file. A cache at least as new as the file is
+ * opened in place of parsing the file; otherwise the file is parsed and the
+ * cache is written again. Caches that cannot be read or written are skipped.
+ */
+void update_asset_from_csv_file(backtest::Asset& asset,
+                                const std::filesystem::path& csv_path)
+{
+  const auto cache_path = backtest::asset_cache_path(csv_path);
+
+  auto error = std::error_code{};
+  const auto csv_time = std::filesystem::last_write_time(csv_path, error);
+  if(error) {
+    throw std::runtime_error{
+     std::format("Failed to open file: {}", csv_path.string())};
+  }
+
+  const auto cache_time = std::filesystem::last_write_time(cache_path, error);
+  if(!error && cache_time >= csv_time) {
+    try {
+      auto cached_asset = backtest::read_asset_cache(cache_path);
+      asset.history(cached_asset.history());
+      asset.field_resolver(cached_asset.field_resolver());
+      return;
+    } catch(const std::runtime_error&) {
+      // The cache is stale or corrupted, so it is written again below.
+    }
+  }
+
+  auto csv_stream = std::ifstream{csv_path};
+  if(!csv_stream.is_open()) {
+    throw std::runtime_error{
+     std::format("Failed to open file: {}", csv_path.string())};
+  }
+  update_asset_from_csv(asset, csv_stream);
+
+  try {
+    backtest::write_asset_cache(asset, cache_path);
+  } catch(const std::exception&) {
+    // The cache only speeds up loading, e.g. read-only directories go without.
+  }
+}
+
 auto format_duration(std::size_t duration_in_seconds) -> std::string
 {
   using namespace std::chrono;
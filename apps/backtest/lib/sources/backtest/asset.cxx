@@ -96,20 +96,20 @@ public:
       return false;
     }
 
-    const auto& self_field_data = self.history().field_data();
-    const auto& other_field_data = other.history().field_data();
+    const auto& self_history = self.history();
+    const auto& other_history = other.history();
 
-    if(self_field_data.size() != other_field_data.size()) {
+    if(self_history.fields().size() != other_history.fields().size()) {
       return false;
     }
 
-    for(const auto& [field, self_series] : self_field_data) {
-      const auto other_it = other_field_data.find(field);
-      if(other_it == other_field_data.end()) {
+    for(const auto& field : self_history.fields()) {
+      if(!other_history.contains(field)) {
         return false;
       }
 
-      const auto& other_series = other_it->second;
+      const auto self_series = self_history[field];
+      const auto other_series = other_history[field];
       if(self_series.size() != other_series.size()) {
         return false;
       }
@@ -0,0 +1,382 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>) && !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PLUDUX_BACKTEST_ASSET_CACHE_MMAP 1
+#endif
+
+export module pludux.backtest:asset_cache;
+
+import pludux;
+
+import :asset;
+
+export namespace pludux::backtest {
+
+/**
+ * The binary asset cache is laid out as:
+ *
+ * - the header,
+ * - the metadata: the asset name, the six quote fields of the field resolver
+ *   and the field names, each as its byte size followed by its bytes, then
+ *   the size of every field, all padded to a multiple of 8 bytes,
+ * - the values: the columns of the asset history as stored by `AssetHistory`,
+ *   so they can be viewed in place once the file is mapped.
+ *
+ * Every integer is 64-bit in the byte order of the machine that wrote the
+ * cache, and the checksum covers the metadata and the values.
+ */
+struct AssetCacheHeader {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint64_t size;
+  std::uint64_t field_count;
+  std::uint64_t metadata_size;
+  std::uint64_t checksum;
+};
+
+static_assert(sizeof(AssetCacheHeader) % 8 == 0);
+
+inline constexpr auto asset_cache_magic =
+ std::array<char, 8>{'P', 'L', 'U', 'D', 'U', 'X', 'A', 'C'};
+inline constexpr auto asset_cache_version = std::uint32_t{1};
+inline constexpr auto asset_cache_byte_order = std::uint32_t{0x01020304};
+
+/**
+ * The cache of a CSV file, stored next to it.
+ */
+auto asset_cache_path(std::filesystem::path csv_path) -> std::filesystem::path;
+
+/**
+ * Write the asset to a binary cache file. The file is written to a temporary
+ * path and renamed, so readers never see a partial cache.
+ */
+void write_asset_cache(const Asset& asset, const std::filesystem::path& path);
+
+/**
+ * Open a binary cache file. On platforms with `mmap` the file is mapped and
+ * the asset history views its columns in place; elsewhere the file is read
+ * into memory. Throws `std::runtime_error` if the file is not a valid cache.
+ */
+auto read_asset_cache(const std::filesystem::path& path,
+                      bool verify_checksum = true) -> Asset;
+
+} // namespace pludux::backtest
+
+namespace pludux::backtest {
+
+auto asset_cache_checksum(std::span<const std::byte> bytes) noexcept
+ -> std::uint64_t
+{
+  auto checksum = std::uint64_t{0xcbf29ce484222325};
+  for(auto i = 0uz; i + sizeof(std::uint64_t) <= bytes.size();
+      i += sizeof(std::uint64_t)) {
+    auto word = std::uint64_t{};
+    std::memcpy(&word, bytes.data() + i, sizeof(word));
+    checksum = (checksum ^ word) * 0x9e3779b97f4a7c15;
+    checksum ^= checksum >> 29;
+  }
+  return checksum;
+}
+
+void append_cache_integer(std::string& metadata, std::uint64_t value)
+{
+  metadata.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append_cache_string(std::string& metadata, std::string_view value)
+{
+  append_cache_integer(metadata, value.size());
+  metadata.append(value);
+}
+
+/**
+ * Reads the metadata of a cache, throwing when it runs past its end.
+ */
+class AssetCacheMetadataReader {
+public:
+  explicit AssetCacheMetadataReader(std::span<const std::byte> metadata)
+  : metadata_{metadata}
+  {
+  }
+
+  auto integer(this AssetCacheMetadataReader& self) -> std::uint64_t
+  {
+    auto value = std::uint64_t{};
+    std::memcpy(&value, self.bytes_(sizeof(value)).data(), sizeof(value));
+    return value;
+  }
+
+  auto string(this AssetCacheMetadataReader& self) -> std::string
+  {
+    const auto size = self.integer();
+    const auto bytes = self.bytes_(size);
+    return std::string{reinterpret_cast<const char*>(bytes.data()),
+                       bytes.size()};
+  }
+
+private:
+  std::span<const std::byte> metadata_;
+
+  auto bytes_(this AssetCacheMetadataReader& self, std::uint64_t size)
+   -> std::span<const std::byte>
+  {
+    if(size > self.metadata_.size()) {
+      throw std::runtime_error{"Asset cache metadata is truncated"};
+    }
+    const auto bytes = self.metadata_.first(size);
+    self.metadata_ = self.metadata_.subspan(size);
+    return bytes;
+  }
+};
+
+/**
+ * Map the file, or read it into memory where it cannot be mapped. The bytes
+ * stay valid while the returned storage is alive and are aligned for doubles.
+ */
+auto map_asset_cache(const std::filesystem::path& path)
+ -> std::pair<std::shared_ptr<const void>, std::span<const std::byte>>
+{
+#ifdef PLUDUX_BACKTEST_ASSET_CACHE_MMAP
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+  if(fd < 0) {
+    throw std::runtime_error{
+     std::format("Failed to open asset cache: {}", path.string())};
+  }
+
+  struct ::stat file_stat{};
+  if(::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    ::close(fd);
+    throw std::runtime_error{
+     std::format("Failed to read asset cache: {}", path.string())};
+  }
+
+  const auto file_size = static_cast<std::size_t>(file_stat.st_size);
+  auto* const address =
+   ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+
+  if(address == MAP_FAILED) {
+    throw std::runtime_error{
+     std::format("Failed to map asset cache: {}", path.string())};
+  }
+
+  auto storage = std::shared_ptr<const void>{
+   address, [file_size](const void* mapped_address) {
+     ::munmap(const_cast<void*>(mapped_address), file_size);
+   }};
+  const auto bytes =
+   std::span<const std::byte>{static_cast<const std::byte*>(address),
+                              file_size};
+  return {std::move(storage), bytes};
+#else
+  auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+  if(!file.is_open()) {
+    throw std::runtime_error{
+     std::format("Failed to open asset cache: {}", path.string())};
+  }
+
+  const auto file_size = static_cast<std::size_t>(file.tellg());
+  auto words = std::make_shared<std::vector<std::uint64_t>>(
+   (file_size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(words->data()),
+            static_cast<std::streamsize>(file_size));
+  if(!file) {
+    throw std::runtime_error{
+     std::format("Failed to read asset cache: {}", path.string())};
+  }
+
+  const auto bytes = std::as_bytes(std::span{*words}).first(file_size);
+  return {std::move(words), bytes};
+#endif
+}
+
+auto asset_cache_path(std::filesystem::path csv_path) -> std::filesystem::path
+{
+  csv_path += ".pludux-cache";
+  return csv_path;
+}
+
+void write_asset_cache(const Asset& asset, const std::filesystem::path& path)
+{
+  const auto& history = asset.history();
+  const auto& field_resolver = asset.field_resolver();
+  const auto& fields = history.fields();
+
+  auto metadata = std::string{};
+  append_cache_string(metadata, asset.name());
+  append_cache_string(metadata, field_resolver.datetime_field());
+  append_cache_string(metadata, field_resolver.open_field());
+  append_cache_string(metadata, field_resolver.high_field());
+  append_cache_string(metadata, field_resolver.low_field());
+  append_cache_string(metadata, field_resolver.close_field());
+  append_cache_string(metadata, field_resolver.volume_field());
+  for(const auto& field : fields) {
+    append_cache_string(metadata, field);
+  }
+  for(auto handle = 0uz; handle < fields.size(); ++handle) {
+    append_cache_integer(metadata, history.series(handle).size());
+  }
+  metadata.resize((metadata.size() + 7) / 8 * 8, '\0');
+
+  auto values = std::vector<double>{};
+  values.reserve(fields.size() * history.size());
+  for(auto handle = 0uz; handle < fields.size(); ++handle) {
+    const auto column = history.series(handle).data();
+    values.insert(values.end(),
+                  history.size() - column.size(),
+                  std::numeric_limits<double>::quiet_NaN());
+    values.insert(values.end(), column.begin(), column.end());
+  }
+
+  const auto metadata_bytes = std::as_bytes(std::span{metadata});
+  const auto values_bytes = std::as_bytes(std::span{values});
+
+  auto header = AssetCacheHeader{
+   .magic = asset_cache_magic,
+   .version = asset_cache_version,
+   .byte_order = asset_cache_byte_order,
+   .size = history.size(),
+   .field_count = fields.size(),
+   .metadata_size = metadata.size(),
+   .checksum = asset_cache_checksum(metadata_bytes) ^
+               asset_cache_checksum(values_bytes)};
+
+  auto temporary_path = path;
+  temporary_path += ".tmp";
+
+  {
+    auto file = std::ofstream{temporary_path, std::ios::binary};
+    if(!file.is_open()) {
+      throw std::runtime_error{std::format("Failed to write asset cache: {}",
+                                           temporary_path.string())};
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values_bytes.size()));
+
+    if(!file) {
+      throw std::runtime_error{std::format("Failed to write asset cache: {}",
+                                           temporary_path.string())};
+    }
+  }
+
+  std::filesystem::rename(temporary_path, path);
+}
+
+auto read_asset_cache(const std::filesystem::path& path, bool verify_checksum)
+ -> Asset
+{
+  const auto [storage, bytes] = map_asset_cache(path);
+
+  const auto invalid_cache = [&](std::string_view reason) {
+    return std::runtime_error{
+     std::format("Invalid asset cache {}: {}", path.string(), reason)};
+  };
+
+  auto header = AssetCacheHeader{};
+  if(bytes.size() < sizeof(header)) {
+    throw invalid_cache("file is truncated");
+  }
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  if(header.magic != asset_cache_magic) {
+    throw invalid_cache("not an asset cache");
+  }
+  if(header.version != asset_cache_version) {
+    throw invalid_cache(std::format("unsupported version {}", header.version));
+  }
+  if(header.byte_order != asset_cache_byte_order) {
+    throw invalid_cache("written with another byte order");
+  }
+
+  const auto payload = bytes.subspan(sizeof(header));
+  const auto value_count = header.size * header.field_count;
+  if(header.metadata_size % 8 != 0 || header.metadata_size > payload.size() ||
+     (header.field_count != 0 &&
+      header.size > payload.size() / sizeof(double) / header.field_count) ||
+     payload.size() - header.metadata_size != value_count * sizeof(double)) {
+    throw invalid_cache("sizes do not match the file");
+  }
+
+  const auto metadata_bytes = payload.first(header.metadata_size);
+  const auto values_bytes = payload.subspan(header.metadata_size);
+  if(verify_checksum) {
+    const auto checksum = asset_cache_checksum(metadata_bytes) ^
+                          asset_cache_checksum(values_bytes);
+    if(checksum != header.checksum) {
+      throw invalid_cache("checksum mismatch");
+    }
+  }
+
+  auto metadata = AssetCacheMetadataReader{metadata_bytes};
+  auto name = metadata.string();
+  auto datetime_field = metadata.string();
+  auto open_field = metadata.string();
+  auto high_field = metadata.string();
+  auto low_field = metadata.string();
+  auto close_field = metadata.string();
+  auto volume_field = metadata.string();
+
+  auto fields = std::vector<std::string>{};
+  fields.reserve(header.field_count);
+  for(auto i = 0uz; i < header.field_count; ++i) {
+    fields.push_back(metadata.string());
+  }
+
+  auto field_sizes = std::vector<std::size_t>{};
+  field_sizes.reserve(header.field_count);
+  for(auto i = 0uz; i < header.field_count; ++i) {
+    const auto field_size = metadata.integer();
+    if(field_size > header.size) {
+      throw invalid_cache("field is larger than the history");
+    }
+    field_sizes.push_back(field_size);
+  }
+
+  // The header and the metadata are multiples of 8 bytes and the file is
+  // mapped at a page boundary, so the values are aligned for doubles.
+  const auto values = std::span<const double>{
+   reinterpret_cast<const double*>(values_bytes.data()), value_count};
+
+  auto history = AssetHistory{std::move(fields),
+                              std::move(field_sizes),
+                              header.size,
+                              values,
+                              storage};
+
+  auto field_resolver = AssetQuoteFieldResolver{std::move(datetime_field),
+                                                std::move(open_field),
+                                                std::move(high_field),
+                                                std::move(low_field),
+                                                std::move(close_field),
+                                                std::move(volume_field)};
+
+  return Asset{std::move(name), std::move(history), std::move(field_resolver)};
+}
+
+} // namespace pludux::backtest
@@ -0,0 +1,574 @@
+module;
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <istream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+export module pludux.backtest:asset_csv_reader;
+
+export namespace pludux::backtest {
+
+/**
+ * The columns of an asset CSV file, with their values in the order of the
+ * rows.
+ */
+struct AssetCsvColumns {
+  std::vector<std::string> headers;
+  std::vector<std::vector<double>> columns;
+};
+
+/**
+ * Parse a number of a CSV field. Surrounding spaces are ignored and an empty
+ * field is NaN.
+ */
+auto parse_csv_number(std::string_view field) -> double;
+
+/**
+ * Parse an ISO-8601 date, e.g. `2024-01-31`, `2024-01-31 09:30` or
+ * `2024-01-31T09:30:00.5+07:00`, to seconds since the Unix epoch. Dates
+ * without a time zone are in UTC.
+ */
+auto parse_iso8601_datetime(std::string_view field) noexcept
+ -> std::optional<double>;
+
+/**
+ * Read the columns of a CSV file whose first row holds the headers. The first
+ * column holds the datetime of the bars, either as an ISO-8601 date or as a
+ * Unix timestamp; every other column is numeric.
+ *
+ * The stream is read in chunks of `chunk_size` bytes. The complete lines of
+ * a chunk are split into newline-aligned parts which are parsed on up to
+ * `thread_count` threads, or one per hardware thread if it is 0, and
+ * appended to the columns in the order of the rows. The threads are started
+ * once per file and take the parts of every chunk from a queue. Quoted fields
+ * may not span lines.
+ */
+auto read_asset_csv_columns(std::istream& csv_stream,
+                            std::size_t chunk_size = 1uz << 24,
+                            std::size_t thread_count = 0) -> AssetCsvColumns;
+
+} // namespace pludux::backtest
+
+namespace pludux::backtest {
+
+auto trim_csv_field(std::string_view field) noexcept -> std::string_view
+{
+  const auto is_space = [](char c) { return c == ' ' || c == '\t'; };
+
+  while(!field.empty() && is_space(field.front())) {
+    field.remove_prefix(1);
+  }
+  while(!field.empty() && is_space(field.back())) {
+    field.remove_suffix(1);
+  }
+
+  if(field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+    field = field.substr(1, field.size() - 2);
+  }
+
+  return field;
+}
+
+/**
+ * Split a CSV line on commas, keeping the commas inside quoted fields. The
+ * fields are views into the line.
+ */
+void split_csv_line(std::string_view line,
+                    std::vector<std::string_view>& fields)
+{
+  fields.clear();
+
+  auto is_quoted = false;
+  auto field_begin = 0uz;
+  for(auto i = 0uz; i < line.size(); ++i) {
+    const auto c = line[i];
+    if(c == '"') {
+      is_quoted = !is_quoted;
+    } else if(c == ',' && !is_quoted) {
+      const auto field = line.substr(field_begin, i - field_begin);
+      fields.push_back(trim_csv_field(field));
+      field_begin = i + 1;
+    }
+  }
+  fields.push_back(trim_csv_field(line.substr(field_begin)));
+}
+
+auto unquote_csv_header(std::string_view header) -> std::string
+{
+  auto result = std::string{};
+  result.reserve(header.size());
+
+  for(auto i = 0uz; i < header.size(); ++i) {
+    result.push_back(header[i]);
+    if(header[i] == '"' && i + 1 < header.size() && header[i + 1] == '"') {
+      ++i;
+    }
+  }
+
+  return result;
+}
+
+auto parse_digits(std::string_view text,
+                  std::size_t position,
+                  std::size_t count) noexcept -> std::optional<int>
+{
+  if(position + count > text.size()) {
+    return std::nullopt;
+  }
+
+  auto value = 0;
+  for(auto i = position; i < position + count; ++i) {
+    const auto c = text[i];
+    if(c < '0' || c > '9') {
+      return std::nullopt;
+    }
+    value = value * 10 + (c - '0');
+  }
+
+  return value;
+}
+
+auto parse_csv_number(std::string_view field) -> double
+{
+  field = trim_csv_field(field);
+  if(field.empty()) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  if(field.front() == '+') {
+    field.remove_prefix(1);
+  }
+
+  auto value = 0.0;
+  const auto* const field_end = field.data() + field.size();
+  const auto [parse_end, error] =
+   std::from_chars(field.data(), field_end, value);
+
+  if(error != std::errc{} || parse_end != field_end) {
+    throw std::invalid_argument{
+     std::format("Invalid number in CSV: '{}'", field)};
+  }
+
+  return value;
+}
+
+auto parse_iso8601_datetime(std::string_view field) noexcept
+ -> std::optional<double>
+{
+  using namespace std::chrono;
+
+  // YYYY-MM-DD
+  const auto year_value = parse_digits(field, 0, 4);
+  const auto month_value = parse_digits(field, 5, 2);
+  const auto day_value = parse_digits(field, 8, 2);
+  if(!year_value || !month_value || !day_value || field[4] != '-' ||
+     field[7] != '-') {
+    return std::nullopt;
+  }
+
+  const auto date = year{*year_value} / month(*month_value) / day(*day_value);
+  if(!date.ok()) {
+    return std::nullopt;
+  }
+
+  auto seconds_of_day = 0.0;
+  auto position = 10uz;
+
+  // [T ]hh:mm[:ss[.s]]
+  if(position < field.size() &&
+     (field[position] == 'T' || field[position] == ' ')) {
+    const auto hour_value = parse_digits(field, position + 1, 2);
+    const auto minute_value = parse_digits(field, position + 4, 2);
+    if(!hour_value || !minute_value || field[position + 3] != ':' ||
+       *hour_value > 24 || *minute_value > 59) {
+      return std::nullopt;
+    }
+    seconds_of_day = *hour_value * 3600.0 + *minute_value * 60.0;
+    position += 6;
+
+    if(position < field.size() && field[position] == ':') {
+      const auto second_value = parse_digits(field, position + 1, 2);
+      if(!second_value || *second_value > 60) {
+        return std::nullopt;
+      }
+      seconds_of_day += *second_value;
+      position += 3;
+
+      if(position < field.size() &&
+         (field[position] == '.' || field[position] == ',')) {
+        auto scale = 0.1;
+        ++position;
+        const auto fraction_begin = position;
+        while(position < field.size() && field[position] >= '0' &&
+              field[position] <= '9') {
+          seconds_of_day += (field[position] - '0') * scale;
+          scale /= 10;
+          ++position;
+        }
+        if(position == fraction_begin) {
+          return std::nullopt;
+        }
+      }
+    }
+  }
+
+  // Z, +hh:mm, +hhmm or +hh
+  auto offset_seconds = 0.0;
+  if(position < field.size()) {
+    const auto designator = field[position];
+    if(designator == 'Z') {
+      ++position;
+    } else if(designator == '+' || designator == '-') {
+      const auto hour_value = parse_digits(field, position + 1, 2);
+      if(!hour_value) {
+        return std::nullopt;
+      }
+      position += 3;
+
+      auto minute_value = std::optional<int>{0};
+      if(position < field.size()) {
+        const auto minute_position =
+         field[position] == ':' ? position + 1 : position;
+        minute_value = parse_digits(field, minute_position, 2);
+        position = minute_position + 2;
+      }
+      if(!minute_value) {
+        return std::nullopt;
+      }
+
+      const auto sign = designator == '-' ? -1.0 : 1.0;
+      offset_seconds = sign * (*hour_value * 3600.0 + *minute_value * 60.0);
+    }
+  }
+
+  if(position != field.size()) {
+    return std::nullopt;
+  }
+
+  const auto days_since_epoch = sys_days{date}.time_since_epoch().count();
+  return days_since_epoch * 86400.0 + seconds_of_day - offset_seconds;
+}
+
+auto parse_csv_datetime(std::string_view field) -> double
+{
+  field = trim_csv_field(field);
+  if(const auto datetime = parse_iso8601_datetime(field)) {
+    return *datetime;
+  }
+
+  return parse_csv_number(field);
+}
+
+auto read_csv_headers(std::string_view& rows, std::vector<std::string>& headers)
+ -> bool
+{
+  while(!rows.empty()) {
+    const auto line_end = rows.find('\n');
+    auto line = rows.substr(0, line_end);
+    rows = line_end == std::string_view::npos ? std::string_view{}
+                                              : rows.substr(line_end + 1);
+
+    if(!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if(line.empty()) {
+      continue;
+    }
+
+    auto fields = std::vector<std::string_view>{};
+    split_csv_line(line, fields);
+    for(const auto field : fields) {
+      headers.push_back(unquote_csv_header(field));
+    }
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Parse the rows into the columns, appending one value per row to every
+ * column. Missing fields are NaN.
+ */
+void parse_csv_rows(std::string_view rows,
+                    std::vector<std::vector<double>>& columns)
+{
+  auto fields = std::vector<std::string_view>{};
+  while(!rows.empty()) {
+    const auto line_end = rows.find('\n');
+    auto line = rows.substr(0, line_end);
+    rows = line_end == std::string_view::npos ? std::string_view{}
+                                              : rows.substr(line_end + 1);
+
+    if(!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if(line.empty()) {
+      continue;
+    }
+
+    split_csv_line(line, fields);
+
+    for(auto i = 0uz; i < columns.size(); ++i) {
+      if(i >= fields.size()) {
+        columns[i].push_back(std::numeric_limits<double>::quiet_NaN());
+      } else if(i == 0) {
+        columns[i].push_back(parse_csv_datetime(fields[i]));
+      } else {
+        columns[i].push_back(parse_csv_number(fields[i]));
+      }
+    }
+  }
+}
+
+/**
+ * Parses the newline-aligned parts of the rows of a CSV file on worker
+ * threads started once per file. The parts of each chunk are queued for the
+ * workers, while the calling thread parses the first part and then helps with
+ * the queue.
+ */
+class CsvPartParser {
+public:
+  explicit CsvPartParser(std::size_t worker_count)
+  {
+    workers_.reserve(worker_count);
+    for(auto i = 0uz; i < worker_count; ++i) {
+      workers_.emplace_back(
+       [this](std::stop_token stop_token) { run_worker_(stop_token); });
+    }
+  }
+
+  CsvPartParser(const CsvPartParser&) = delete;
+  auto operator=(const CsvPartParser&) -> CsvPartParser& = delete;
+
+  auto worker_count(this const CsvPartParser& self) noexcept -> std::size_t
+  {
+    return self.workers_.size();
+  }
+
+  /**
+   * Parse the parts concurrently and append their values to the columns in
+   * the order of the rows.
+   */
+  void parse(this CsvPartParser& self,
+             std::span<const std::string_view> parts,
+             std::vector<std::vector<double>>& columns)
+  {
+    {
+      const auto lock = std::lock_guard{self.mutex_};
+      self.parts_ = parts;
+      self.column_count_ = columns.size();
+      self.errors_.assign(parts.size(), nullptr);
+      if(self.part_columns_.size() < parts.size()) {
+        self.part_columns_.resize(parts.size());
+      }
+      self.remaining_part_count_ = parts.size() - 1;
+      for(auto i = 1uz; i < parts.size(); ++i) {
+        self.queued_parts_.push(i);
+      }
+    }
+    self.part_queued_.notify_all();
+
+    try {
+      parse_csv_rows(parts.front(), columns);
+    } catch(...) {
+      self.errors_.front() = std::current_exception();
+    }
+
+    while(const auto part = self.pop_part_()) {
+      self.parse_part_(*part);
+    }
+
+    {
+      auto lock = std::unique_lock{self.mutex_};
+      self.part_parsed_.wait(
+       lock, [&self] { return self.remaining_part_count_ == 0; });
+    }
+
+    for(const auto& error : self.errors_) {
+      if(error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    for(auto i = 1uz; i < parts.size(); ++i) {
+      const auto& part_columns = self.part_columns_[i];
+      for(auto j = 0uz; j < columns.size(); ++j) {
+        columns[j].insert(
+         columns[j].end(), part_columns[j].begin(), part_columns[j].end());
+      }
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable_any part_queued_;
+  std::condition_variable part_parsed_;
+  std::queue<std::size_t> queued_parts_;
+  std::size_t remaining_part_count_{0};
+
+  // Written by `parse` before it queues the parts of a chunk; each part is
+  // parsed into the columns and error of its own index.
+  std::span<const std::string_view> parts_;
+  std::size_t column_count_{0};
+  std::vector<std::vector<std::vector<double>>> part_columns_;
+  std::vector<std::exception_ptr> errors_;
+
+  // Declared last so the workers stop before the state they read goes away.
+  std::vector<std::jthread> workers_;
+
+  auto pop_part_(this CsvPartParser& self) -> std::optional<std::size_t>
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    if(self.queued_parts_.empty()) {
+      return std::nullopt;
+    }
+
+    const auto part = self.queued_parts_.front();
+    self.queued_parts_.pop();
+    return part;
+  }
+
+  void parse_part_(this CsvPartParser& self, std::size_t part)
+  {
+    auto& part_columns = self.part_columns_[part];
+    try {
+      part_columns.resize(self.column_count_);
+      for(auto& column : part_columns) {
+        column.clear();
+      }
+      parse_csv_rows(self.parts_[part], part_columns);
+    } catch(...) {
+      self.errors_[part] = std::current_exception();
+    }
+
+    {
+      const auto lock = std::lock_guard{self.mutex_};
+      --self.remaining_part_count_;
+    }
+    self.part_parsed_.notify_one();
+  }
+
+  void run_worker_(this CsvPartParser& self, std::stop_token stop_token)
+  {
+    while(true) {
+      auto part = 0uz;
+      {
+        auto lock = std::unique_lock{self.mutex_};
+        if(!self.part_queued_.wait(lock, stop_token, [&self] {
+             return !self.queued_parts_.empty();
+           })) {
+          return;
+        }
+
+        part = self.queued_parts_.front();
+        self.queued_parts_.pop();
+      }
+
+      self.parse_part_(part);
+    }
+  }
+};
+
+/**
+ * Split the rows into newline-aligned parts, one per thread of the parser,
+ * and parse them concurrently. Rows too small to be worth a thread are parsed
+ * on the calling thread.
+ */
+void parse_csv_rows_parallel(std::string_view rows,
+                             std::vector<std::vector<double>>& columns,
+                             CsvPartParser& part_parser)
+{
+  constexpr auto min_part_size = 64uz << 10;
+
+  const auto part_count = std::clamp(
+   rows.size() / min_part_size, 1uz, part_parser.worker_count() + 1);
+  if(part_count == 1) {
+    parse_csv_rows(rows, columns);
+    return;
+  }
+
+  auto parts = std::vector<std::string_view>{};
+  auto part_begin = 0uz;
+  for(auto i = 1uz; i < part_count; ++i) {
+    const auto part_end = rows.find(
+     '\n', std::max(rows.size() * i / part_count, part_begin));
+    if(part_end == std::string_view::npos) {
+      break;
+    }
+    parts.push_back(rows.substr(part_begin, part_end + 1 - part_begin));
+    part_begin = part_end + 1;
+  }
+  parts.push_back(rows.substr(part_begin));
+
+  part_parser.parse(parts, columns);
+}
+
+auto read_asset_csv_columns(std::istream& csv_stream,
+                            std::size_t chunk_size,
+                            std::size_t thread_count) -> AssetCsvColumns
+{
+  auto result = AssetCsvColumns{};
+  auto& headers = result.headers;
+  auto& columns = result.columns;
+
+#ifdef __EMSCRIPTEN__
+  thread_count = 1;
+#else
+  if(thread_count == 0) {
+    thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+#endif
+
+  // The calling thread parses the first part of every chunk.
+  auto part_parser = CsvPartParser{thread_count - 1};
+
+  auto buffer = std::string{};
+  auto chunk = std::string(std::max(chunk_size, 1uz), '\0');
+  auto is_stream_end = false;
+  while(!is_stream_end) {
+    csv_stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    const auto read_size = static_cast<std::size_t>(csv_stream.gcount());
+    buffer.append(chunk.data(), read_size);
+    is_stream_end = !csv_stream;
+
+    // Only complete lines are parsed; the rest waits for the next chunk.
+    auto rows_size = buffer.size();
+    if(!is_stream_end) {
+      const auto last_line_end = buffer.rfind('\n');
+      rows_size = last_line_end == std::string::npos ? 0 : last_line_end + 1;
+    }
+
+    auto rows = std::string_view{buffer}.substr(0, rows_size);
+    if(headers.empty() && read_csv_headers(rows, headers)) {
+      columns.resize(headers.size());
+    }
+    if(!headers.empty()) {
+      parse_csv_rows_parallel(rows, columns, part_parser);
+    }
+
+    buffer.erase(0, rows_size);
+  }
+
+  return result;
+}
+
+} // namespace pludux::backtest
@@ -3,6 +3,7 @@ module;
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <ctime>
 #include <format>
@@ -10,7 +11,7 @@ module;
 #include <limits>
 #include <memory>
 #include <optional>
-#include <unordered_map>
+#include <string>
 #include <vector>
 
 export module pludux.backtest:backtest;
@@ -25,9 +26,11 @@ import :trade_record;
 import :trade_position;
 import :trade_session;
 import :backtest_summary;
+import :backtest_results;
 import :strategy;
 import :broker;
 import :market;
+import :column_cache;
 
 export namespace pludux::backtest {
 
@@ -52,7 +55,7 @@ public:
              std::move(market_ptr),
              std::move(broker_ptr),
              std::move(profile_ptr),
-             std::vector<BacktestSummary>{},
+             BacktestResults{initial_capital},
              SeriesResultsCollector{}}
   {
   }
@@ -64,7 +67,7 @@ public:
            std::shared_ptr<Market> market_ptr,
            std::shared_ptr<Broker> broker_ptr,
            std::shared_ptr<Profile> profile_ptr,
-           std::vector<BacktestSummary> summaries,
+           BacktestResults results,
            SeriesResultsCollector series_results_collector)
   : name_{std::move(name)}
   , initial_capital_{initial_capital}
@@ -74,7 +77,8 @@ public:
   , broker_weak_ptr_{broker_ptr}
   , profile_weak_ptr_{profile_ptr}
   , is_failed_{false}
-  , summaries_{std::move(summaries)}
+  , warmup_bar_count_{0}
+  , results_{std::move(results)}
   , series_results_collector_{std::move(series_results_collector)}
   {
   }
@@ -109,6 +113,10 @@ public:
                     std::shared_ptr<Strategy> new_strategy_ptr) noexcept
   {
     self.strategy_weak_ptr_ = std::move(new_strategy_ptr);
+    self.shared_strategy_.reset();
+    self.shared_strategy_source_.reset();
+    self.linked_series_.clear();
+    self.condition_statistics_.clear();
   }
 
   auto strategy(this const Backtest& self) noexcept -> const Strategy&
@@ -194,10 +202,41 @@ public:
     return self.is_failed_;
   }
 
-  auto summaries(this const Backtest& self) noexcept
-   -> const std::vector<BacktestSummary>&
+  auto results(this const Backtest& self) noexcept -> const BacktestResults&
   {
-    return self.summaries_;
+    return self.results_;
+  }
+
+  auto column_cache_ptr(this const Backtest& self) noexcept
+   -> const std::shared_ptr<ColumnCache>&
+  {
+    return self.column_cache_ptr_;
+  }
+
+  /**
+   * Share the series and filter columns of the run through the cache, with
+   * other backtests on the same asset whose strategies have methods in
+   * common. A null cache computes every column for this run alone.
+   */
+  void column_cache_ptr(this Backtest& self,
+                        std::shared_ptr<ColumnCache> new_column_cache_ptr)
+  {
+    self.column_cache_ptr_ = std::move(new_column_cache_ptr);
+  }
+
+  auto warmup_bar_count(this const Backtest& self) noexcept -> std::size_t
+  {
+    return self.warmup_bar_count_;
+  }
+
+  /**
+   * Run the first bars of the asset only to warm up the series, without
+   * entering trades on them, e.g. the bars before a window under test.
+   */
+  void warmup_bar_count(this Backtest& self,
+                        std::size_t new_warmup_bar_count) noexcept
+  {
+    self.warmup_bar_count_ = new_warmup_bar_count;
   }
 
   auto series_results_collector(this const Backtest& self) noexcept
@@ -206,10 +245,14 @@ public:
     return self.series_results_collector_;
   }
 
-  auto series_results(this const Backtest& self) noexcept
-   -> const std::unordered_map<std::string, std::vector<double>>&
+  /**
+   * The clause orders and hit rates of the ALL_OF and ANY_OF conditions
+   * evaluated bar by bar in the run.
+   */
+  auto condition_statistics(this const Backtest& self) noexcept
+   -> const ConditionStatistics&
   {
-    return self.series_results_collector().results();
+    return self.condition_statistics_;
   }
 
   auto equal_rules(this const Backtest& self, const Backtest& other) noexcept
@@ -246,8 +289,15 @@ public:
   void reset(this Backtest& self) noexcept
   {
     self.is_failed_ = false;
-    self.summaries_.clear();
+    self.results_ = BacktestResults{self.initial_capital()};
     self.series_results_collector_.clear();
+    self.series_columns_.clear();
+    self.column_order_.reset();
+    self.filter_columns_ = FilterColumns{};
+    self.indicator_cache_.clear();
+    self.condition_statistics_.clear();
+    self.linked_series_.clear();
+    self.pending_bar_.reset();
   }
 
   auto should_run(this const Backtest& self) noexcept -> bool
@@ -256,45 +306,102 @@ public:
       return false;
     }
 
-    const auto summaries_size = self.summaries_.size();
+    const auto results_size = self.results_.size();
     const auto asset_size = self.asset().size();
 
-    return summaries_size < asset_size && !self.is_failed();
+    return results_size < asset_size && !self.is_failed();
   }
 
   void run(this Backtest& self)
+  {
+    if(!self.should_run()) {
+      return;
+    }
+
+    auto entry_trade = self.run_exits(self.get_risk_value());
+    self.run_entry(std::move(entry_trade));
+  }
+
+  /**
+   * Evaluate the series and filter columns of the strategy, which the first
+   * bar of the run otherwise does. Backtests of many assets prepare their
+   * columns in parallel before stepping through the bars. Each step is done
+   * once per run, so preparing again does nothing.
+   */
+  void prepare(this Backtest& self)
+  {
+    if(!self.is_valid_rules()) {
+      return;
+    }
+
+    // The repeated methods are shared once per strategy, not once per run, so
+    // only an edited strategy is shared again.
+    if(self.shared_strategy_source_ != self.strategy()) {
+      self.shared_strategy_ = share_common_methods(self.strategy());
+      self.shared_strategy_source_ = self.strategy();
+      self.linked_series_.clear();
+      self.condition_statistics_.clear();
+    }
+
+    if(!self.column_order_) {
+      self.compute_series_columns();
+    }
+
+    if(self.linked_series_.size() !=
+       self.run_strategy().series_registry().size()) {
+      self.link_series();
+    }
+
+    if(!self.filter_columns_.is_computed) {
+      self.compute_filter_columns();
+    }
+  }
+
+  /**
+   * Start the next bar: update the market, exit the open position when its
+   * stops or the exit filter say so, and return the trade the strategy enters
+   * on the bar with `risk_value` at risk, if the session is free to enter.
+   *
+   * The bar is recorded by `run_entry`, which has to follow. Backtests
+   * sharing one capital start their bars in parallel and then size and enter
+   * their trades one at a time.
+   */
+  auto run_exits(this Backtest& self, double risk_value)
+   -> std::optional<TradeEntry>
   {
     using namespace backtest;
 
     if(!self.should_run()) {
-      return;
+      return std::nullopt;
     }
 
-    const auto summaries_size = self.summaries_.size();
+    const auto results_size = self.results_.size();
     const auto asset_size = self.asset().size();
     const auto last_index = asset_size - 1;
     const auto asset_lookback =
-     last_index - std::min(summaries_size, last_index);
+     last_index - std::min(results_size, last_index);
     const auto asset_snapshot = self.asset().get_snapshot(asset_lookback);
-    const auto& strategy = self.strategy();
-    const auto& profile = self.profile();
     const auto& broker = self.broker();
-    const auto& market = self.market();
+
+    self.prepare();
 
     {
-      const auto& series_registry = strategy.series_registry();
-      auto context = self.create_default_method_context();
-      for(const auto& [series_name, series] : series_registry) {
-        const auto series_value = series(asset_snapshot, context);
-        self.series_results_collector_.collect(series_name, series_value);
+      const auto context = self.create_default_method_context();
+      for(auto slot = 0uz; slot < self.linked_series_.size(); ++slot) {
+        const auto series_value =
+         context.call_series_slot(slot, asset_snapshot);
+        self.series_results_collector_.collect(
+         *self.linked_series_.results_slot(slot), series_value);
       }
     }
 
-    auto summary = !self.summaries_.empty()
-                    ? self.summaries_.back()
-                    : BacktestSummary{self.initial_capital()};
+    if(self.results_.empty()) {
+      self.results_ = BacktestResults{self.initial_capital()};
+    }
 
-    auto trade_session = summary.trade_session();
+    auto summary = self.results_.take_last_summary();
+    auto trade_session = std::move(summary).trade_session();
+    auto trade_events = std::vector<BacktestTradeEvent>{};
 
     trade_session.market_update(
      static_cast<std::time_t>(asset_snapshot.datetime()),
@@ -316,44 +423,78 @@ public:
 
       if(exit_trade) {
         const auto fee = broker.calculate_fee(*exit_trade);
+        trade_events.push_back(
+         BacktestTradeEvent{results_size,
+                            *exit_trade,
+                            fee,
+                            open_position->stop_loss_trailing_price()});
         trade_session.exit_position(*exit_trade, fee);
       }
     }
 
-    if(trade_session.is_flat() || trade_session.is_closed()) {
-      const auto risk_value = self.get_risk_value();
-
-      auto entry_trade = self.entry_trade(asset_snapshot, risk_value);
-      if(entry_trade) {
-        {
-          const auto quantity_step = market.quantity_step();
-          const auto min_order_quantity = market.min_order_quantity();
-
-          auto position_size = entry_trade->position_size();
-          if(quantity_step > 0.0 &&
-             std::fmod(position_size, quantity_step) != 0.0) {
-            position_size =
-             quantity_step * std::round(position_size / quantity_step);
-          }
-
-          if(position_size > 0.0 && position_size < min_order_quantity) {
-            position_size = min_order_quantity;
-          } else if(position_size < 0.0 &&
-                    position_size > -min_order_quantity) {
-            position_size = -min_order_quantity;
-          }
-
-          entry_trade->position_size(position_size);
+    auto entry_trade = std::optional<TradeEntry>{};
+    const auto is_warmed_up = results_size >= self.warmup_bar_count_;
+    if(is_warmed_up && (trade_session.is_flat() || trade_session.is_closed())) {
+      entry_trade = self.entry_trade(asset_snapshot, risk_value);
+    }
+
+    self.pending_bar_ = PendingBar{std::move(summary),
+                                   std::move(trade_session),
+                                   std::move(trade_events)};
+    return entry_trade;
+  }
+
+  /**
+   * Finish the bar started by `run_exits`, entering the trade, if any, with
+   * its size rounded to the quantity step of the market.
+   */
+  void run_entry(this Backtest& self, std::optional<TradeEntry> entry_trade)
+  {
+    if(!self.pending_bar_) {
+      return;
+    }
+
+    auto [summary, trade_session, trade_events] =
+     std::move(*self.pending_bar_);
+    self.pending_bar_.reset();
+
+    if(entry_trade) {
+      const auto& broker = self.broker();
+      const auto& market = self.market();
+
+      {
+        const auto quantity_step = market.quantity_step();
+        const auto min_order_quantity = market.min_order_quantity();
+
+        auto position_size = entry_trade->position_size();
+        if(quantity_step > 0.0 &&
+           std::fmod(position_size, quantity_step) != 0.0) {
+          position_size =
+           quantity_step * std::round(position_size / quantity_step);
         }
 
-        const auto fee = broker.calculate_fee(*entry_trade);
-        trade_session.entry_position(*entry_trade, fee);
+        if(position_size > 0.0 && position_size < min_order_quantity) {
+          position_size = min_order_quantity;
+        } else if(position_size < 0.0 && position_size > -min_order_quantity) {
+          position_size = -min_order_quantity;
+        }
+
+        entry_trade->position_size(position_size);
       }
+
+      const auto& open_position = trade_session.open_position();
+      const auto fee = broker.calculate_fee(*entry_trade);
+      trade_events.push_back(BacktestTradeEvent{
+       self.results_.size(),
+       *entry_trade,
+       fee,
+       open_position ? open_position->stop_loss_trailing_price() : NAN});
+      trade_session.entry_position(*entry_trade, fee);
     }
 
     summary.update_to_next_summary(std::move(trade_session));
 
-    self.summaries_.emplace_back(std::move(summary));
+    self.results_.append(std::move(summary), trade_events);
   }
 
   auto entry_long_trade(this const Backtest& self,
@@ -362,12 +503,15 @@ public:
   {
     auto result = std::optional<TradeEntry>{};
 
-    const auto& strategy = self.strategy();
+    const auto& strategy = self.run_strategy();
     const auto& profile = self.profile();
     const auto prev_snapshot = asset_snapshot[1];
     auto context = self.create_default_method_context();
 
-    if(strategy.long_entry_filter()(prev_snapshot, context)) {
+    if(self.test_filter(self.filter_columns_.long_entry,
+                        strategy.long_entry_filter(),
+                        prev_snapshot,
+                        context)) {
       const auto entry_price = asset_snapshot.open();
       const auto r_distance =
        profile.get_r_distance(entry_price, prev_snapshot, context);
@@ -398,12 +542,15 @@ public:
   {
     auto result = std::optional<TradeEntry>{};
 
-    const auto& strategy = self.strategy();
+    const auto& strategy = self.run_strategy();
     const auto& profile = self.profile();
     auto context = self.create_default_method_context();
     const auto prev_snapshot = asset_snapshot[1];
 
-    if(strategy.short_entry_filter()(prev_snapshot, context)) {
+    if(self.test_filter(self.filter_columns_.short_entry,
+                        strategy.short_entry_filter(),
+                        prev_snapshot,
+                        context)) {
       const auto entry_price = asset_snapshot.open();
       const auto r_distance =
        -profile.get_r_distance(entry_price, prev_snapshot, context);
@@ -444,16 +591,22 @@ public:
     const auto is_short_direction = position_size < 0;
     const auto exit_price = asset_snapshot.open();
 
-    auto const& strategy = self.strategy();
+    auto const& strategy = self.run_strategy();
     auto context = self.create_default_method_context();
     const auto prev_snapshot = asset_snapshot[1];
 
     if(is_long_direction) {
-      if(strategy.long_exit_filter()(prev_snapshot, context)) {
+      if(self.test_filter(self.filter_columns_.long_exit,
+                          strategy.long_exit_filter(),
+                          prev_snapshot,
+                          context)) {
         return TradeExit{position_size, exit_price, TradeExit::Reason::signal};
       }
     } else if(is_short_direction) {
-      if(strategy.short_exit_filter()(prev_snapshot, context)) {
+      if(self.test_filter(self.filter_columns_.short_exit,
+                          strategy.short_exit_filter(),
+                          prev_snapshot,
+                          context)) {
         return TradeExit{position_size, exit_price, TradeExit::Reason::signal};
       }
     }
@@ -472,16 +625,203 @@ private:
   std::weak_ptr<Profile> profile_weak_ptr_;
 
   bool is_failed_;
+  std::size_t warmup_bar_count_;
 
-  std::vector<BacktestSummary> summaries_;
+  BacktestResults results_;
   SeriesResultsCollector series_results_collector_;
+  SeriesResultsCollector series_columns_;
+  std::optional<StrategyColumnOrder> column_order_;
+  mutable IndicatorCache indicator_cache_;
+  mutable ConditionStatistics condition_statistics_;
+  std::optional<Strategy> shared_strategy_;
+  std::optional<Strategy> shared_strategy_source_;
+  LinkedSeries linked_series_;
+  std::shared_ptr<ColumnCache> column_cache_ptr_;
+
+  /**
+   * A bar started by `run_exits` and waiting for its entry.
+   */
+  struct PendingBar {
+    BacktestSummary summary;
+    TradeSession trade_session;
+    std::vector<BacktestTradeEvent> trade_events;
+  };
+
+  std::optional<PendingBar> pending_bar_;
+
+  /**
+   * The entry and exit filters of the strategy evaluated over the whole asset
+   * history, one bit per bar. A filter evaluated bar by bar has an empty
+   * column.
+   */
+  struct FilterColumns {
+    ConditionColumn long_entry;
+    ConditionColumn short_entry;
+    ConditionColumn long_exit;
+    ConditionColumn short_exit;
+    bool is_computed{false};
+  };
+
+  FilterColumns filter_columns_;
+
+  /**
+   * The strategy the run evaluates: the edited strategy with its repeated
+   * methods shared, once the run has started.
+   */
+  auto run_strategy(this const Backtest& self) noexcept -> const Strategy&
+  {
+    return self.shared_strategy_ ? *self.shared_strategy_ : self.strategy();
+  }
 
   auto create_default_method_context(this const Backtest& self)
    -> DefaultMethodContext
   {
-    return DefaultMethodContext{self.strategy().series_registry(),
-                                self.series_results_collector_,
-                                self.summaries_.size()};
+    return DefaultMethodContext{
+     self.run_strategy().series_registry(),
+     self.series_results_collector_,
+     {.series_columns = &self.series_columns_,
+      .indicator_cache = &self.indicator_cache_,
+      .linked_series = &self.linked_series_,
+      .condition_statistics = &self.condition_statistics_},
+     self.results_.size()};
+  }
+
+  /**
+   * Give every registered series a results column with room for the whole
+   * asset history, and link the series slots to their method, precomputed
+   * column and results column.
+   */
+  void link_series(this Backtest& self)
+  {
+    const auto& series_registry = self.run_strategy().series_registry();
+
+    auto series_names = std::vector<std::string>{};
+    series_names.reserve(series_registry.size());
+    for(const auto& [series_name, _] : series_registry) {
+      series_names.push_back(series_name);
+    }
+
+    self.series_results_collector_.reserve(series_names, self.asset().size());
+    self.linked_series_.link(
+     series_registry, self.series_results_collector_, self.series_columns_);
+  }
+
+  /**
+   * The keys of the columns of the strategy in the column cache, if the run
+   * has a cache and the strategy can be keyed.
+   */
+  auto column_keys(this const Backtest& self)
+   -> std::optional<StrategyColumnKeys>
+  {
+    if(!self.column_cache_ptr_) {
+      return std::nullopt;
+    }
+
+    return strategy_column_keys(self.strategy(), self.asset());
+  }
+
+  /**
+   * Evaluate the registered series over the whole asset history at once, so
+   * each bar of the run only has to read its value from the column. Series
+   * are computed after the series they reference; the ones reading their own
+   * earlier bars are left without a column and evaluated bar by bar.
+   */
+  void compute_series_columns(this Backtest& self)
+  {
+    const auto& series_registry = self.run_strategy().series_registry();
+    const auto asset_snapshot = self.asset().get_snapshot(0);
+    const auto context = self.create_default_method_context();
+    const auto column_keys = self.column_keys();
+
+    self.column_order_ = strategy_column_order(self.strategy());
+    for(const auto& series_name : self.column_order_->series) {
+      const auto series_opt = series_registry.get(series_name);
+      if(!series_opt) {
+        continue;
+      }
+
+      const auto& series = *series_opt;
+      const auto compute = [&] {
+        return compute_series_column(series, asset_snapshot, context);
+      };
+
+      auto column = std::vector<double>{};
+      if(column_keys && column_keys->series.contains(series_name)) {
+        column = self.column_cache_ptr_->series_column(
+         column_keys->series.at(series_name), compute);
+      } else {
+        column = compute();
+      }
+      self.series_columns_.results(series_name, std::move(column));
+    }
+  }
+
+  /**
+   * Evaluate the entry and exit filters over the whole asset history at once,
+   * so each bar of the run only has to test one bit per filter.
+   *
+   * The clauses of an ALL_OF or ANY_OF condition in a filter column are
+   * computed in their declared order. Only the filters evaluated bar by bar
+   * reorder their clauses by measured cost.
+   */
+  void compute_filter_columns(this Backtest& self)
+  {
+    const auto& strategy = self.run_strategy();
+    const auto asset_snapshot = self.asset().get_snapshot(0);
+    const auto context = self.create_default_method_context();
+    const auto column_keys = self.column_keys();
+
+    const auto compute_column = [&](const AnyConditionMethod& filter,
+                                    bool is_by_bar,
+                                    const std::string* key) {
+      if(is_by_bar) {
+        return ConditionColumn{};
+      }
+
+      const auto compute = [&] {
+        return filter.compute_column(asset_snapshot, context);
+      };
+      return key ? self.column_cache_ptr_->condition_column(*key, compute)
+                 : compute();
+    };
+
+    const auto& column_order = *self.column_order_;
+
+    self.filter_columns_ = FilterColumns{
+     .long_entry =
+      compute_column(strategy.long_entry_filter(),
+                     column_order.is_long_entry_by_bar,
+                     column_keys ? &column_keys->long_entry : nullptr),
+     .short_entry =
+      compute_column(strategy.short_entry_filter(),
+                     column_order.is_short_entry_by_bar,
+                     column_keys ? &column_keys->short_entry : nullptr),
+     .long_exit =
+      compute_column(strategy.long_exit_filter(),
+                     column_order.is_long_exit_by_bar,
+                     column_keys ? &column_keys->long_exit : nullptr),
+     .short_exit =
+      compute_column(strategy.short_exit_filter(),
+                     column_order.is_short_exit_by_bar,
+                     column_keys ? &column_keys->short_exit : nullptr),
+     .is_computed = true};
+  }
+
+  /**
+   * The result of a filter at the bar of the snapshot, read from its column
+   * when the bar is in it. A snapshot before the first bar is evaluated.
+   */
+  auto test_filter(this const Backtest&,
+                   const ConditionColumn& column,
+                   const AnyConditionMethod& filter,
+                   AssetSnapshot asset_snapshot,
+                   const DefaultMethodContext& context) -> bool
+  {
+    if(asset_snapshot.size() != 0 && asset_snapshot.index() < column.size()) {
+      return column[asset_snapshot.index()];
+    }
+
+    return filter(asset_snapshot, context);
   }
 };
 
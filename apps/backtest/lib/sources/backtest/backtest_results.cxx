@@ -0,0 +1,358 @@
+module;
+
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <ctime>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+export module pludux.backtest:backtest_results;
+
+import :trade_entry;
+import :trade_exit;
+import :trade_record;
+import :trade_session;
+import :backtest_summary;
+
+export namespace pludux::backtest {
+
+/**
+ * An entry or an exit made by the trade session at a bar of a run.
+ */
+struct BacktestTradeEvent {
+  std::size_t bar_index;
+  std::variant<TradeEntry, TradeExit> trade;
+  double fee;
+
+  /**
+   * The trailing stop of the open position right before the trade, which the
+   * records of the trade keep.
+   */
+  double stop_loss_trailing_price;
+};
+
+/**
+ * The results of a run. Every bar keeps one row of columns: the market it was
+ * run at, the trailing stop of the open position, and the capital, equity and
+ * drawdown. The entries and exits are kept in an append-only event log.
+ *
+ * Only the summary of the latest bar is kept whole; the summary of any other
+ * bar is rebuilt by replaying the log over the columns.
+ */
+class BacktestResults {
+public:
+  BacktestResults()
+  : BacktestResults{0.0}
+  {
+  }
+
+  explicit BacktestResults(double initial_capital)
+  : BacktestResults{initial_capital,
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    {},
+                    BacktestSummary{initial_capital}}
+  {
+  }
+
+  BacktestResults(double initial_capital,
+                  std::vector<std::time_t> market_timestamps,
+                  std::vector<double> market_prices,
+                  std::vector<std::size_t> market_lookbacks,
+                  std::vector<double> stop_loss_trailing_prices,
+                  std::vector<double> capitals,
+                  std::vector<double> equities,
+                  std::vector<double> drawdowns,
+                  std::vector<BacktestTradeEvent> trade_events,
+                  BacktestSummary last_summary)
+  : initial_capital_{initial_capital}
+  , market_timestamps_{std::move(market_timestamps)}
+  , market_prices_{std::move(market_prices)}
+  , market_lookbacks_{std::move(market_lookbacks)}
+  , stop_loss_trailing_prices_{std::move(stop_loss_trailing_prices)}
+  , capitals_{std::move(capitals)}
+  , equities_{std::move(equities)}
+  , drawdowns_{std::move(drawdowns)}
+  , trade_events_{std::move(trade_events)}
+  , last_summary_{std::move(last_summary)}
+  , revision_{next_revision_()}
+  {
+  }
+
+  auto initial_capital(this const BacktestResults& self) noexcept -> double
+  {
+    return self.initial_capital_;
+  }
+
+  auto size(this const BacktestResults& self) noexcept -> std::size_t
+  {
+    return self.market_timestamps_.size();
+  }
+
+  /**
+   * Identify the content of the results. The results get a unique revision
+   * when they are created and a new one whenever a bar is appended, so views
+   * built from them can be reused while the revision is unchanged.
+   */
+  auto revision(this const BacktestResults& self) noexcept -> std::size_t
+  {
+    return self.revision_;
+  }
+
+  auto empty(this const BacktestResults& self) noexcept -> bool
+  {
+    return self.market_timestamps_.empty();
+  }
+
+  /**
+   * The summary of the latest bar, or the initial summary before any bar.
+   */
+  auto last_summary(this const BacktestResults& self) noexcept
+   -> const BacktestSummary&
+  {
+    return self.last_summary_;
+  }
+
+  /**
+   * Move the summary of the latest bar out to run the next bar from it. The
+   * summary of the next bar is given back by `append`.
+   */
+  auto take_last_summary(this BacktestResults& self) noexcept
+   -> BacktestSummary
+  {
+    return std::move(self.last_summary_);
+  }
+
+  /**
+   * Add the summary of the next bar with the trades made at that bar.
+   */
+  void append(this BacktestResults& self,
+              BacktestSummary summary,
+              std::span<const BacktestTradeEvent> trade_events)
+  {
+    const auto& trade_session = summary.trade_session();
+    const auto& open_position = trade_session.open_position();
+
+    self.market_timestamps_.push_back(trade_session.market_timestamp());
+    self.market_prices_.push_back(trade_session.market_price());
+    self.market_lookbacks_.push_back(trade_session.market_lookback());
+    self.stop_loss_trailing_prices_.push_back(
+     open_position ? open_position->stop_loss_trailing_price() : NAN);
+    self.capitals_.push_back(summary.capital());
+    self.equities_.push_back(summary.equity());
+    self.drawdowns_.push_back(summary.drawdown());
+
+    self.trade_events_.insert(
+     self.trade_events_.end(), trade_events.begin(), trade_events.end());
+
+    self.last_summary_ = std::move(summary);
+    self.revision_ = next_revision_();
+  }
+
+  /**
+   * Rebuild the summary of the bar by replaying the run up to it.
+   */
+  auto summary(this const BacktestResults& self, std::size_t bar_index)
+   -> BacktestSummary
+  {
+    if(bar_index + 1 == self.size()) {
+      return self.last_summary_;
+    }
+
+    auto result = BacktestSummary{self.initial_capital_};
+    self.replay_(bar_index + 1,
+                 [&](std::size_t index, const BacktestSummary& summary) {
+                   if(index == bar_index) {
+                     result = summary;
+                   }
+                 });
+    return result;
+  }
+
+  /**
+   * Call the function with the index and the rebuilt summary of every bar, in
+   * the order of the run.
+   */
+  void for_each_summary(
+   this const BacktestResults& self,
+   std::invocable<std::size_t, const BacktestSummary&> auto function)
+  {
+    self.replay_(self.size(), function);
+  }
+
+  auto market_timestamps(this const BacktestResults& self) noexcept
+   -> const std::vector<std::time_t>&
+  {
+    return self.market_timestamps_;
+  }
+
+  auto market_prices(this const BacktestResults& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.market_prices_;
+  }
+
+  auto market_lookbacks(this const BacktestResults& self) noexcept
+   -> const std::vector<std::size_t>&
+  {
+    return self.market_lookbacks_;
+  }
+
+  auto stop_loss_trailing_prices(this const BacktestResults& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.stop_loss_trailing_prices_;
+  }
+
+  auto capitals(this const BacktestResults& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.capitals_;
+  }
+
+  auto equities(this const BacktestResults& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.equities_;
+  }
+
+  auto drawdowns(this const BacktestResults& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.drawdowns_;
+  }
+
+  auto trade_events(this const BacktestResults& self) noexcept
+   -> const std::vector<BacktestTradeEvent>&
+  {
+    return self.trade_events_;
+  }
+
+private:
+  double initial_capital_;
+
+  std::vector<std::time_t> market_timestamps_;
+  std::vector<double> market_prices_;
+  std::vector<std::size_t> market_lookbacks_;
+  std::vector<double> stop_loss_trailing_prices_;
+  std::vector<double> capitals_;
+  std::vector<double> equities_;
+  std::vector<double> drawdowns_;
+
+  std::vector<BacktestTradeEvent> trade_events_;
+
+  BacktestSummary last_summary_;
+
+  std::size_t revision_;
+
+  static auto next_revision_() noexcept -> std::size_t
+  {
+    static auto last_revision = std::atomic<std::size_t>{0};
+    return ++last_revision;
+  }
+
+  void replay_(this const BacktestResults& self,
+               std::size_t bar_count,
+               auto&& function)
+  {
+    auto summary = BacktestSummary{self.initial_capital_};
+    auto trade_session = TradeSession{};
+    auto event_it = self.trade_events_.begin();
+
+    for(auto i = 0uz; i < bar_count; ++i) {
+      trade_session.market_update(self.market_timestamps_[i],
+                                  self.market_prices_[i],
+                                  self.market_lookbacks_[i]);
+
+      for(; event_it != self.trade_events_.end() && event_it->bar_index == i;
+          ++event_it) {
+        trade_session.update_stop_loss_trailing_price(
+         event_it->stop_loss_trailing_price);
+
+        if(const auto* entry = std::get_if<TradeEntry>(&event_it->trade)) {
+          trade_session.entry_position(*entry, event_it->fee);
+        } else {
+          trade_session.exit_position(std::get<TradeExit>(event_it->trade),
+                                      event_it->fee);
+        }
+      }
+
+      trade_session.update_stop_loss_trailing_price(
+       self.stop_loss_trailing_prices_[i]);
+
+      summary.update_to_next_summary(std::move(trade_session));
+      function(i, std::as_const(summary));
+      trade_session = std::move(summary).trade_session();
+    }
+  }
+};
+
+/**
+ * The trade records of one bar of a run.
+ */
+struct BacktestBarTrades {
+  std::size_t bar_index;
+
+  /**
+   * The number of trades closed by the end of the bar.
+   */
+  std::size_t trade_count;
+
+  std::vector<TradeRecord> trade_records;
+};
+
+/**
+ * The trade records of the bars of a run that have any, rebuilt only when the
+ * results change, so a view drawn every frame does not replay the run each
+ * time.
+ */
+class BacktestTradeRecords {
+public:
+  /**
+   * Replay the results into trade records, unless they are still at the
+   * revision of the last update.
+   */
+  void update(this BacktestTradeRecords& self, const BacktestResults& results)
+  {
+    if(self.revision_ == results.revision()) {
+      return;
+    }
+
+    self.bars_.clear();
+    results.for_each_summary(
+     [&self](std::size_t i, const BacktestSummary& summary) {
+       auto trade_records = std::vector<TradeRecord>{};
+       for(const auto& trade_record :
+           summary.trade_session().trade_record_range()) {
+         trade_records.push_back(trade_record);
+       }
+
+       if(!trade_records.empty()) {
+         self.bars_.push_back(BacktestBarTrades{
+          i, summary.trade_count(), std::move(trade_records)});
+       }
+     });
+    self.revision_ = results.revision();
+  }
+
+  auto bars(this const BacktestTradeRecords& self) noexcept
+   -> const std::vector<BacktestBarTrades>&
+  {
+    return self.bars_;
+  }
+
+private:
+  std::size_t revision_{0};
+  std::vector<BacktestBarTrades> bars_;
+};
+
+} // namespace pludux::backtest
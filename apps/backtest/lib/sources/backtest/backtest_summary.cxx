@@ -68,6 +68,15 @@ public:
     return self.trade_session_;
   }
 
+  /**
+   * Move the trade session out, to update it for the next bar without copying
+   * its positions.
+   */
+  auto trade_session(this BacktestSummary&& self) noexcept -> TradeSession
+  {
+    return std::move(self.trade_session_);
+  }
+
   void trade_session(this BacktestSummary& self,
                      TradeSession trade_session) noexcept
   {
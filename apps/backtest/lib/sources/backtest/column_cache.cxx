@@ -0,0 +1,373 @@
+module;
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+export module pludux.backtest:column_cache;
+
+import pludux;
+
+import :asset;
+import :strategy;
+
+export namespace pludux::backtest {
+
+/**
+ * Series and condition columns computed once and shared by many backtests,
+ * such as the variants of a parameter sweep.
+ *
+ * Each column is kept under a key naming the asset history and the method
+ * tree that computes it, so backtests whose strategies share a method tree
+ * share its column while a method that differs gets a column of its own.
+ * Backtests on different threads may share one cache: the first backtest
+ * asking for a column computes it while the others wait for it.
+ */
+class ColumnCache {
+public:
+  auto series_column(this ColumnCache& self,
+                     const std::string& key,
+                     std::invocable auto compute) -> std::vector<double>
+  {
+    return get_or_compute_(self.mutex_, self.series_columns_, key, compute);
+  }
+
+  auto condition_column(this ColumnCache& self,
+                        const std::string& key,
+                        std::invocable auto compute) -> ConditionColumn
+  {
+    return get_or_compute_(self.mutex_, self.condition_columns_, key, compute);
+  }
+
+  auto series_column_count(this const ColumnCache& self) -> std::size_t
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    return self.series_columns_.size();
+  }
+
+  auto condition_column_count(this const ColumnCache& self) -> std::size_t
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    return self.condition_columns_.size();
+  }
+
+  void clear(this ColumnCache& self)
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    self.series_columns_.clear();
+    self.condition_columns_.clear();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_future<std::vector<double>>>
+   series_columns_;
+  std::unordered_map<std::string, std::shared_future<ConditionColumn>>
+   condition_columns_;
+
+  /**
+   * The column of the key, computed outside the lock by the first caller. A
+   * computation that throws rethrows for every caller of the key.
+   */
+  template<typename T>
+  static auto
+  get_or_compute_(std::mutex& mutex,
+                  std::unordered_map<std::string, std::shared_future<T>>& map,
+                  const std::string& key,
+                  std::invocable auto& compute) -> T
+  {
+    auto promise = std::promise<T>{};
+    auto future = std::shared_future<T>{};
+    auto is_owner = false;
+    {
+      const auto lock = std::lock_guard{mutex};
+      const auto [it, is_inserted] = map.try_emplace(key);
+      if(is_inserted) {
+        it->second = promise.get_future().share();
+        is_owner = true;
+      }
+      future = it->second;
+    }
+
+    if(is_owner) {
+      try {
+        promise.set_value(compute());
+      } catch(...) {
+        promise.set_exception(std::current_exception());
+      }
+    }
+
+    return future.get();
+  }
+};
+
+/**
+ * The keys of the columns of a strategy in a `ColumnCache`.
+ */
+struct StrategyColumnKeys {
+  std::unordered_map<std::string, std::string> series;
+  std::string long_entry;
+  std::string short_entry;
+  std::string long_exit;
+  std::string short_exit;
+};
+
+/**
+ * The keys of the series and filter columns of a strategy run on an asset.
+ * A key is the serialized method followed by the keys of the series it
+ * references, so a series changes the key of every method reading it.
+ * Strategies whose methods cannot be serialized have no keys.
+ */
+auto strategy_column_keys(const Strategy& strategy, const Asset& asset)
+ -> std::optional<StrategyColumnKeys>;
+
+/**
+ * The order a run computes the columns of a strategy in.
+ *
+ * The columns of `series` are computed in their order, each after the series
+ * it references. A series referencing itself, directly or through other
+ * series, reads the results of the bars before the current one, which a
+ * column computed ahead of the run does not have yet. Such a series, every
+ * series referencing it and every filter reading any of them are evaluated
+ * bar by bar instead, with their results collected as the run goes.
+ */
+struct StrategyColumnOrder {
+  std::vector<std::string> series;
+  std::set<std::string> bar_series;
+  bool is_long_entry_by_bar{false};
+  bool is_short_entry_by_bar{false};
+  bool is_long_exit_by_bar{false};
+  bool is_short_exit_by_bar{false};
+};
+
+/**
+ * The column order of a strategy. A method that cannot be serialized may
+ * reference any series, so the series and filters holding one are evaluated
+ * bar by bar.
+ */
+auto strategy_column_order(const Strategy& strategy) -> StrategyColumnOrder;
+
+} // namespace pludux::backtest
+
+namespace pludux::backtest {
+
+class ColumnKeyBuilder {
+public:
+  ColumnKeyBuilder(std::string asset_key, const jsoncons::ojson& series_json)
+  : asset_key_{std::move(asset_key)}
+  , series_json_{series_json}
+  {
+  }
+
+  auto series_key(this ColumnKeyBuilder& self, const std::string& name)
+   -> std::string
+  {
+    if(const auto it = self.series_keys_.find(name);
+       it != self.series_keys_.end()) {
+      return it->second;
+    }
+
+    if(!self.series_json_.contains(name)) {
+      return std::format("unknown:{}", name);
+    }
+
+    // A series reading itself, directly or not, cannot be keyed by its
+    // references, so the cycle is cut at its name.
+    if(!self.visiting_.insert(name).second) {
+      return std::format("cycle:{}", name);
+    }
+    auto key = self.method_key(self.series_json_.at(name));
+    self.visiting_.erase(name);
+
+    self.series_keys_.emplace(name, key);
+    return key;
+  }
+
+  auto method_key(this ColumnKeyBuilder& self, const jsoncons::ojson& config)
+   -> std::string
+  {
+    auto names = std::set<std::string>{};
+    collect_series_references(config, names);
+
+    auto key = std::format("{}|{}", self.asset_key_, config.to_string());
+    for(const auto& name : names) {
+      key += std::format("|{}=({})", name, self.series_key(name));
+    }
+    return key;
+  }
+
+private:
+  std::string asset_key_;
+  const jsoncons::ojson& series_json_;
+  std::unordered_map<std::string, std::string> series_keys_;
+  std::unordered_set<std::string> visiting_;
+};
+
+/**
+ * Orders the series of a strategy so each comes after the series it
+ * references, and finds the series that have to be evaluated bar by bar.
+ */
+class ColumnOrderBuilder {
+public:
+  ColumnOrderBuilder(const jsoncons::ojson& series_json,
+                     StrategyColumnOrder& order)
+  : series_json_{series_json}
+  , order_{order}
+  {
+  }
+
+  void visit(this ColumnOrderBuilder& self, const std::string& name)
+  {
+    if(!self.series_json_.contains(name) ||
+       !self.visited_.insert(name).second) {
+      return;
+    }
+
+    const auto& config = self.series_json_.at(name);
+    auto is_by_bar = has_unserialized_method(config);
+
+    auto names = std::set<std::string>{};
+    collect_series_references(config, names);
+
+    self.path_.push_back(name);
+    for(const auto& reference : names) {
+      // A reference back into the path closes a cycle through every series
+      // of the path from the referenced one on.
+      if(const auto it = std::ranges::find(self.path_, reference);
+         it != self.path_.end()) {
+        self.order_.bar_series.insert(it, self.path_.end());
+      } else {
+        self.visit(reference);
+      }
+
+      is_by_bar = is_by_bar || self.order_.bar_series.contains(reference);
+    }
+    self.path_.pop_back();
+
+    if(is_by_bar || self.order_.bar_series.contains(name)) {
+      self.order_.bar_series.insert(name);
+    } else {
+      self.order_.series.push_back(name);
+    }
+  }
+
+  /**
+   * Whether a filter has to be evaluated bar by bar.
+   */
+  auto is_by_bar(this const ColumnOrderBuilder& self,
+                 const jsoncons::ojson& config) -> bool
+  {
+    if(has_unserialized_method(config)) {
+      return true;
+    }
+
+    auto names = std::set<std::string>{};
+    collect_series_references(config, names);
+    return std::ranges::any_of(names, [&](const std::string& name) {
+      return self.order_.bar_series.contains(name);
+    });
+  }
+
+private:
+  const jsoncons::ojson& series_json_;
+  StrategyColumnOrder& order_;
+  std::vector<std::string> path_;
+  std::unordered_set<std::string> visited_;
+};
+
+auto strategy_column_order(const Strategy& strategy) -> StrategyColumnOrder
+{
+  auto order = StrategyColumnOrder{};
+
+  auto strategy_json = jsoncons::ojson{};
+  try {
+    strategy_json = stringify_backtest_strategy(strategy);
+  } catch(const std::exception&) {
+    for(const auto& [series_name, _] : strategy.series_registry()) {
+      order.bar_series.insert(series_name);
+    }
+    order.is_long_entry_by_bar = true;
+    order.is_short_entry_by_bar = true;
+    order.is_long_exit_by_bar = true;
+    order.is_short_exit_by_bar = true;
+    return order;
+  }
+
+  auto order_builder = ColumnOrderBuilder{strategy_json.at("series"), order};
+  for(const auto& [series_name, _] : strategy.series_registry()) {
+    order_builder.visit(series_name);
+  }
+
+  const auto& positions_json = strategy_json.at("positions");
+  const auto is_by_bar = [&](const char* side, const char* action) {
+    return order_builder.is_by_bar(
+     positions_json.at(side).at(action).at("signal"));
+  };
+  order.is_long_entry_by_bar = is_by_bar("long", "entry");
+  order.is_short_entry_by_bar = is_by_bar("short", "entry");
+  order.is_long_exit_by_bar = is_by_bar("long", "exit");
+  order.is_short_exit_by_bar = is_by_bar("short", "exit");
+
+  return order;
+}
+
+auto strategy_column_keys(const Strategy& strategy, const Asset& asset)
+ -> std::optional<StrategyColumnKeys>
+{
+  auto strategy_json = jsoncons::ojson{};
+  try {
+    strategy_json = stringify_backtest_strategy(strategy);
+  } catch(const std::exception&) {
+    return std::nullopt;
+  }
+
+  if(has_unserialized_method(strategy_json.at("series")) ||
+     has_unserialized_method(strategy_json.at("positions"))) {
+    return std::nullopt;
+  }
+
+  const auto& field_resolver = asset.field_resolver();
+  auto asset_key = std::format("{}:{}:{}:{}:{}:{}:{}",
+                               asset.history().revision(),
+                               field_resolver.datetime_field(),
+                               field_resolver.open_field(),
+                               field_resolver.high_field(),
+                               field_resolver.low_field(),
+                               field_resolver.close_field(),
+                               field_resolver.volume_field());
+
+  const auto& series_json = strategy_json.at("series");
+  auto key_builder = ColumnKeyBuilder{std::move(asset_key), series_json};
+
+  auto keys = StrategyColumnKeys{};
+  for(const auto& [series_name, _] : strategy.series_registry()) {
+    keys.series.emplace(series_name, key_builder.series_key(series_name));
+  }
+
+  const auto& positions_json = strategy_json.at("positions");
+  const auto filter_key = [&](const char* side, const char* action) {
+    return key_builder.method_key(
+     positions_json.at(side).at(action).at("signal"));
+  };
+  keys.long_entry = filter_key("long", "entry");
+  keys.short_entry = filter_key("short", "entry");
+  keys.long_exit = filter_key("long", "exit");
+  keys.short_exit = filter_key("short", "exit");
+
+  return keys;
+}
+
+} // namespace pludux::backtest
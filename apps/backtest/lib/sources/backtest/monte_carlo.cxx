@@ -0,0 +1,330 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+export module pludux.backtest:monte_carlo;
+
+import :trade_session;
+import :backtest_summary;
+import :backtest_results;
+
+export namespace pludux::backtest {
+
+/**
+ * The profits of the trades closed by a run, in the order they closed.
+ */
+auto closed_trade_pnls(const BacktestResults& results) -> std::vector<double>;
+
+/**
+ * The value below which `percent` percent of the sorted values fall,
+ * interpolated between the two nearest values.
+ */
+auto sorted_percentile(const std::vector<double>& sorted_values,
+                       double percent) noexcept -> double;
+
+/**
+ * The distributions of the total profit and the maximum drawdown over the
+ * iterations of a Monte Carlo run, each sorted from the lowest value.
+ * Drawdowns are in percent of the peak equity, as in `BacktestSummary`.
+ */
+struct MonteCarloResult {
+  std::vector<double> total_profits;
+  std::vector<double> max_drawdowns;
+
+  auto profit_percentile(this const MonteCarloResult& self,
+                         double percent) noexcept -> double
+  {
+    return sorted_percentile(self.total_profits, percent);
+  }
+
+  auto drawdown_percentile(this const MonteCarloResult& self,
+                           double percent) noexcept -> double
+  {
+    return sorted_percentile(self.max_drawdowns, percent);
+  }
+
+  /**
+   * The share of the iterations ending with a loss.
+   */
+  auto loss_probability(this const MonteCarloResult& self) noexcept -> double
+  {
+    if(self.total_profits.empty()) {
+      return 0.0;
+    }
+
+    const auto loss_end = std::ranges::lower_bound(self.total_profits, 0.0);
+    return static_cast<double>(loss_end - self.total_profits.begin()) /
+           static_cast<double>(self.total_profits.size());
+  }
+};
+
+/**
+ * Stress a trade sequence by replaying it in random orders.
+ *
+ * Every iteration draws a sequence of as many trades as the run closed,
+ * either by shuffling the trades or by resampling them with replacement, and
+ * skips each drawn trade with the skip rate. The iteration then replays the
+ * sequence from the initial capital to get its total profit and maximum
+ * drawdown.
+ *
+ * Iterations are split into chunks that threads take in turn. Each chunk
+ * draws from its own random stream seeded by the seed and the chunk, so the
+ * results do not depend on the number of threads.
+ */
+class MonteCarlo {
+public:
+  enum class Sampling { Shuffle, Resample };
+
+  MonteCarlo(std::vector<double> trade_pnls, double initial_capital)
+  : trade_pnls_{std::move(trade_pnls)}
+  , initial_capital_{initial_capital}
+  , iteration_count_{10'000}
+  , sampling_{Sampling::Shuffle}
+  , skip_rate_{0.0}
+  , seed_{0}
+  {
+  }
+
+  auto trade_pnls(this const MonteCarlo& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.trade_pnls_;
+  }
+
+  auto initial_capital(this const MonteCarlo& self) noexcept -> double
+  {
+    return self.initial_capital_;
+  }
+
+  auto iteration_count(this const MonteCarlo& self) noexcept -> std::size_t
+  {
+    return self.iteration_count_;
+  }
+
+  void iteration_count(this MonteCarlo& self,
+                       std::size_t new_iteration_count) noexcept
+  {
+    self.iteration_count_ = new_iteration_count;
+  }
+
+  auto sampling(this const MonteCarlo& self) noexcept -> Sampling
+  {
+    return self.sampling_;
+  }
+
+  void sampling(this MonteCarlo& self, Sampling new_sampling) noexcept
+  {
+    self.sampling_ = new_sampling;
+  }
+
+  auto skip_rate(this const MonteCarlo& self) noexcept -> double
+  {
+    return self.skip_rate_;
+  }
+
+  /**
+   * The probability of skipping each drawn trade, as a missed signal would.
+   */
+  void skip_rate(this MonteCarlo& self, double new_skip_rate) noexcept
+  {
+    self.skip_rate_ = std::clamp(new_skip_rate, 0.0, 1.0);
+  }
+
+  auto seed(this const MonteCarlo& self) noexcept -> std::uint64_t
+  {
+    return self.seed_;
+  }
+
+  void seed(this MonteCarlo& self, std::uint64_t new_seed) noexcept
+  {
+    self.seed_ = new_seed;
+  }
+
+  /**
+   * Run the iterations on `thread_count` threads, or one per core when it is
+   * zero.
+   */
+  auto run(this const MonteCarlo& self, std::size_t thread_count = 0)
+   -> MonteCarloResult
+  {
+    const auto chunk_count =
+     (self.iteration_count_ + chunk_size_ - 1) / chunk_size_;
+
+#ifdef __EMSCRIPTEN__
+    thread_count = 1;
+#else
+    if(thread_count == 0) {
+      thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+#endif
+    thread_count = std::max(std::min(thread_count, chunk_count), 1uz);
+
+    auto result = MonteCarloResult{};
+    result.total_profits.resize(self.iteration_count_);
+    result.max_drawdowns.resize(self.iteration_count_);
+
+    auto next_chunk = std::atomic<std::size_t>{0};
+    const auto run_chunks = [&] {
+      auto samples = std::vector<double>(self.trade_pnls_.size() * lane_count_);
+      auto order = std::vector<std::size_t>(self.trade_pnls_.size());
+
+      for(auto i = next_chunk.fetch_add(1); i < chunk_count;
+          i = next_chunk.fetch_add(1)) {
+        self.run_chunk_(i, samples, order, result);
+      }
+    };
+
+    {
+      // The calling thread runs chunks alongside the workers.
+      auto workers = std::vector<std::jthread>{};
+      workers.reserve(thread_count - 1);
+      for(auto i = 1uz; i < thread_count; ++i) {
+        workers.emplace_back(run_chunks);
+      }
+      run_chunks();
+    }
+
+    std::ranges::sort(result.total_profits);
+    std::ranges::sort(result.max_drawdowns);
+    return result;
+  }
+
+private:
+  static constexpr auto chunk_size_ = 1024uz;
+
+  // The iterations replayed together, one per lane.
+  static constexpr auto lane_count_ = 8uz;
+
+  std::vector<double> trade_pnls_;
+  double initial_capital_;
+  std::size_t iteration_count_;
+  Sampling sampling_;
+  double skip_rate_;
+  std::uint64_t seed_;
+
+  /**
+   * Run the iterations of a chunk, `lane_count_` at a time. The drawn trades
+   * of the lanes are laid out trade by trade, so the replay steps every lane
+   * through one trade with contiguous loads the compiler can vectorize.
+   */
+  void run_chunk_(this const MonteCarlo& self,
+                  std::size_t chunk_index,
+                  std::vector<double>& samples,
+                  std::vector<std::size_t>& order,
+                  MonteCarloResult& result)
+  {
+    auto seed_sequence =
+     std::seed_seq{static_cast<std::uint32_t>(self.seed_),
+                   static_cast<std::uint32_t>(self.seed_ >> 32),
+                   static_cast<std::uint32_t>(chunk_index),
+                   static_cast<std::uint32_t>(chunk_index >> 32)};
+    auto random_engine = std::mt19937_64{seed_sequence};
+    auto skip_distribution = std::bernoulli_distribution{self.skip_rate_};
+
+    const auto trade_count = self.trade_pnls_.size();
+    auto trade_distribution = std::uniform_int_distribution<std::size_t>{
+     0, std::max(trade_count, 1uz) - 1};
+
+    // The shuffles of a chunk start from the trade order, whatever chunks
+    // the thread ran before.
+    std::iota(order.begin(), order.end(), 0uz);
+
+    const auto chunk_begin = chunk_index * chunk_size_;
+    const auto chunk_end =
+     std::min(chunk_begin + chunk_size_, self.iteration_count_);
+
+    for(auto lanes_begin = chunk_begin; lanes_begin < chunk_end;
+        lanes_begin += lane_count_) {
+      const auto lanes_size = std::min(lane_count_, chunk_end - lanes_begin);
+
+      for(auto lane = 0uz; lane < lanes_size; ++lane) {
+        if(self.sampling_ == Sampling::Shuffle) {
+          std::ranges::shuffle(order, random_engine);
+        }
+
+        for(auto i = 0uz; i < trade_count; ++i) {
+          const auto trade_index = self.sampling_ == Sampling::Shuffle
+                                    ? order[i]
+                                    : trade_distribution(random_engine);
+          const auto is_skipped =
+           self.skip_rate_ > 0.0 && skip_distribution(random_engine);
+
+          samples[i * lane_count_ + lane] =
+           is_skipped ? 0.0 : self.trade_pnls_[trade_index];
+        }
+      }
+
+      auto equities = std::array<double, lane_count_>{};
+      auto peak_equities = std::array<double, lane_count_>{};
+      auto max_drawdowns = std::array<double, lane_count_>{};
+      equities.fill(self.initial_capital_);
+      peak_equities.fill(self.initial_capital_);
+
+      for(auto i = 0uz; i < trade_count; ++i) {
+        const auto* trade_samples = samples.data() + i * lane_count_;
+        for(auto lane = 0uz; lane < lane_count_; ++lane) {
+          equities[lane] += trade_samples[lane];
+          peak_equities[lane] = std::max(peak_equities[lane], equities[lane]);
+
+          const auto drawdown =
+           peak_equities[lane] != 0.0
+            ? (peak_equities[lane] - equities[lane]) / peak_equities[lane] *
+               100.0
+            : 0.0;
+          max_drawdowns[lane] = std::max(max_drawdowns[lane], drawdown);
+        }
+      }
+
+      for(auto lane = 0uz; lane < lanes_size; ++lane) {
+        result.total_profits[lanes_begin + lane] =
+         equities[lane] - self.initial_capital_;
+        result.max_drawdowns[lanes_begin + lane] = max_drawdowns[lane];
+      }
+    }
+  }
+};
+
+} // namespace pludux::backtest
+
+namespace pludux::backtest {
+
+auto closed_trade_pnls(const BacktestResults& results) -> std::vector<double>
+{
+  auto pnls = std::vector<double>{};
+  results.for_each_summary([&](std::size_t, const BacktestSummary& summary) {
+    const auto& trade_session = summary.trade_session();
+    if(trade_session.closed_position()) {
+      pnls.push_back(trade_session.realized_pnl());
+    }
+  });
+  return pnls;
+}
+
+auto sorted_percentile(const std::vector<double>& sorted_values,
+                       double percent) noexcept -> double
+{
+  if(sorted_values.empty()) {
+    return std::nan("");
+  }
+
+  const auto position = std::clamp(percent, 0.0, 100.0) / 100.0 *
+                        static_cast<double>(sorted_values.size() - 1);
+  const auto lower_index = static_cast<std::size_t>(std::floor(position));
+  const auto upper_index = std::min(lower_index + 1, sorted_values.size() - 1);
+  const auto fraction = position - static_cast<double>(lower_index);
+
+  return sorted_values[lower_index] +
+         (sorted_values[upper_index] - sorted_values[lower_index]) * fraction;
+}
+
+} // namespace pludux::backtest
@@ -0,0 +1,475 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+export module pludux.backtest:parameter_sweep;
+
+import pludux;
+
+import :asset;
+import :strategy;
+import :market;
+import :broker;
+import :profile;
+import :backtest;
+import :column_cache;
+
+export namespace pludux::backtest {
+
+/**
+ * A parameter of a sweep and the values it takes.
+ *
+ * Paths starting with `/strategy` are JSON pointers into the strategy JSON,
+ * e.g. `/strategy/series/ma/params/period` or
+ * `/strategy/takeProfit/rMultiple`. Paths starting with `/profile` name a
+ * parameter of the profile: `capitalRisk`, `atrPeriod`, `atrMultiplier`,
+ * `percentage` or `price`.
+ */
+struct SweepParameter {
+  std::string path;
+  std::vector<double> values;
+};
+
+/**
+ * The parameter values of one variant of a sweep and the summary of its
+ * backtest. A variant whose strategy cannot be built or run keeps the error
+ * and ranks last.
+ */
+struct SweepResult {
+  std::size_t variant_index{0};
+  std::vector<double> values;
+  std::string error;
+
+  double total_profit{0.0};
+  double max_drawdown{0.0};
+  double expected_value{0.0};
+  double profit_rate{0.0};
+  double profit_factor{0.0};
+  std::size_t trade_count{0};
+
+  auto is_failed(this const SweepResult& self) noexcept -> bool
+  {
+    return !self.error.empty();
+  }
+};
+
+/**
+ * Rank the results by their total profit, the most profitable first. Ties
+ * keep the order of the variants.
+ */
+void rank_sweep_results(std::vector<SweepResult>& results)
+{
+  std::ranges::sort(results, [](const auto& lhs, const auto& rhs) {
+    if(lhs.is_failed() != rhs.is_failed()) {
+      return rhs.is_failed();
+    }
+    if(lhs.total_profit != rhs.total_profit) {
+      return lhs.total_profit > rhs.total_profit;
+    }
+    return lhs.variant_index < rhs.variant_index;
+  });
+}
+
+/**
+ * Set one parameter of a variant, either in the strategy JSON or in the
+ * profile. Whole numbers replacing integers, such as periods, stay integers.
+ */
+void apply_sweep_parameter(jsoncons::ojson& strategy_json,
+                           Profile& profile,
+                           std::string_view path,
+                           double value)
+{
+  constexpr auto strategy_prefix = std::string_view{"/strategy"};
+  constexpr auto profile_prefix = std::string_view{"/profile/"};
+
+  if(path.starts_with(profile_prefix)) {
+    const auto name = path.substr(profile_prefix.size());
+    if(name == "capitalRisk") {
+      profile.capital_risk(value);
+    } else if(name == "atrPeriod") {
+      profile.r_mode_atr(
+       {static_cast<std::size_t>(value), profile.r_mode_atr().second});
+    } else if(name == "atrMultiplier") {
+      profile.r_mode_atr({profile.r_mode_atr().first, value});
+    } else if(name == "percentage") {
+      profile.r_mode_percentage(value);
+    } else if(name == "price") {
+      profile.r_mode_price(value);
+    } else {
+      throw std::runtime_error{
+       std::format("Unknown profile sweep parameter: {}", path)};
+    }
+    return;
+  }
+
+  if(!path.starts_with(strategy_prefix)) {
+    throw std::runtime_error{std::format("Invalid sweep parameter: {}", path)};
+  }
+
+  auto pointer = path.substr(strategy_prefix.size());
+  if(pointer.empty() || pointer.front() != '/') {
+    throw std::runtime_error{std::format("Invalid sweep parameter: {}", path)};
+  }
+
+  auto* target = &strategy_json;
+  while(!pointer.empty()) {
+    pointer.remove_prefix(1);
+    const auto token_end = std::min(pointer.find('/'), pointer.size());
+
+    // JSON pointer escapes: `~1` is `/` and `~0` is `~`.
+    auto token = std::string{};
+    for(auto i = 0uz; i < token_end; ++i) {
+      if(pointer[i] == '~' && i + 1 < token_end) {
+        token += pointer[i + 1] == '1' ? '/' : '~';
+        ++i;
+      } else {
+        token += pointer[i];
+      }
+    }
+    pointer.remove_prefix(token_end);
+
+    if(target->is_array()) {
+      auto index = 0uz;
+      const auto [end, error] =
+       std::from_chars(token.data(), token.data() + token.size(), index);
+      if(error != std::errc{} || end != token.data() + token.size() ||
+         index >= target->size()) {
+        throw std::runtime_error{
+         std::format("Invalid sweep parameter: {}", path)};
+      }
+      target = &(*target)[index];
+    } else if(target->is_object() &&
+              (target->contains(token) || pointer.empty())) {
+      if(!target->contains(token)) {
+        target->try_emplace(token, jsoncons::null_type{});
+      }
+      target = &target->at(token);
+    } else {
+      throw std::runtime_error{
+       std::format("Invalid sweep parameter: {}", path)};
+    }
+  }
+
+  if(!target->is_double() && std::trunc(value) == value) {
+    *target = jsoncons::ojson{static_cast<std::int64_t>(value)};
+  } else {
+    *target = jsoncons::ojson{value};
+  }
+}
+
+/**
+ * Read the parameters of a sweep. Each parameter lists its values, or spans
+ * them from `from` to `to` inclusive by `step`:
+ *
+ * ```json
+ * {"parameters": [
+ *   {"path": "/strategy/series/ma/params/period", "values": [9, 21, 50]},
+ *   {"path": "/profile/capitalRisk", "from": 0.005, "to": 0.02, "step": 0.005}
+ * ]}
+ * ```
+ */
+auto parse_parameter_sweep_json(const jsoncons::ojson& sweep_json)
+ -> std::vector<SweepParameter>
+{
+  if(!sweep_json.is_object() || !sweep_json.contains("parameters")) {
+    throw std::runtime_error(
+     "Invalid sweep JSON: expected an object with parameters");
+  }
+
+  auto parameters = std::vector<SweepParameter>{};
+  for(const auto& parameter_json : sweep_json.at("parameters").array_range()) {
+    auto parameter = SweepParameter{};
+    parameter.path = parameter_json.at("path").as<std::string>();
+
+    if(parameter_json.contains("values")) {
+      for(const auto& value : parameter_json.at("values").array_range()) {
+        parameter.values.push_back(value.as<double>());
+      }
+    } else {
+      const auto from = parameter_json.at("from").as<double>();
+      const auto to = parameter_json.at("to").as<double>();
+      const auto step = parameter_json.get_value_or<double>("step", 1.0);
+      if(!(step > 0.0) || to < from) {
+        throw std::runtime_error{
+         std::format("Invalid sweep range of {}", parameter.path)};
+      }
+
+      // The tolerance keeps `to` in the range despite rounding of the step.
+      const auto count =
+       static_cast<std::size_t>(std::floor((to - from) / step + 1e-9)) + 1;
+      for(auto i = 0uz; i < count; ++i) {
+        parameter.values.push_back(from + static_cast<double>(i) * step);
+      }
+    }
+
+    if(parameter.values.empty()) {
+      throw std::runtime_error{
+       std::format("Sweep parameter {} has no values", parameter.path)};
+    }
+    parameters.push_back(std::move(parameter));
+  }
+
+  return parameters;
+}
+
+/**
+ * Backtest every combination of the values of the sweep parameters.
+ *
+ * Every variant builds its own strategy and profile from the base ones and
+ * runs its own backtest, while the asset, market and broker are shared by all
+ * of them and only read. Variants are numbered with the last parameter
+ * changing fastest.
+ *
+ * The backtests share their series and filter columns through the column
+ * cache of the sweep, so a column is computed once for all the variants whose
+ * strategies agree on its method tree. A sweep of trade management
+ * parameters, such as the take profit, computes its indicators once.
+ */
+class ParameterSweep {
+public:
+  ParameterSweep(jsoncons::ojson strategy_json,
+                 Profile profile,
+                 std::shared_ptr<Asset> asset_ptr,
+                 std::shared_ptr<Market> market_ptr,
+                 std::shared_ptr<Broker> broker_ptr,
+                 double initial_capital,
+                 std::vector<SweepParameter> parameters)
+  : strategy_json_{std::move(strategy_json)}
+  , profile_{std::move(profile)}
+  , asset_ptr_{std::move(asset_ptr)}
+  , market_ptr_{std::move(market_ptr)}
+  , broker_ptr_{std::move(broker_ptr)}
+  , initial_capital_{initial_capital}
+  , parameters_{std::move(parameters)}
+  , column_cache_ptr_{std::make_shared<ColumnCache>()}
+  , warmup_bar_count_{0}
+  {
+    // Plots do not change the trades, so the variants skip parsing them.
+    if(strategy_json_.is_object()) {
+      strategy_json_.erase("plots");
+    }
+  }
+
+  auto parameters(this const ParameterSweep& self) noexcept
+   -> const std::vector<SweepParameter>&
+  {
+    return self.parameters_;
+  }
+
+  /**
+   * The columns computed by the variants run so far, kept for the following
+   * runs of the sweep until it is cleared.
+   */
+  auto column_cache(this const ParameterSweep& self) noexcept -> ColumnCache&
+  {
+    return *self.column_cache_ptr_;
+  }
+
+  auto warmup_bar_count(this const ParameterSweep& self) noexcept
+   -> std::size_t
+  {
+    return self.warmup_bar_count_;
+  }
+
+  /**
+   * Warm up the series of every variant on the first bars of the asset
+   * without trading them, see `Backtest::warmup_bar_count`.
+   */
+  void warmup_bar_count(this ParameterSweep& self,
+                        std::size_t new_warmup_bar_count) noexcept
+  {
+    self.warmup_bar_count_ = new_warmup_bar_count;
+  }
+
+  auto variant_count(this const ParameterSweep& self) noexcept -> std::size_t
+  {
+    auto count = 1uz;
+    for(const auto& parameter : self.parameters_) {
+      count *= parameter.values.size();
+    }
+    return count;
+  }
+
+  auto variant_values(this const ParameterSweep& self,
+                      std::size_t variant_index) -> std::vector<double>
+  {
+    auto values = std::vector<double>(self.parameters_.size());
+    for(auto i = self.parameters_.size(); i-- > 0;) {
+      const auto& parameter_values = self.parameters_[i].values;
+      values[i] = parameter_values[variant_index % parameter_values.size()];
+      variant_index /= parameter_values.size();
+    }
+    return values;
+  }
+
+  /**
+   * Set the parameters of a variant in copies of the base strategy JSON and
+   * profile.
+   */
+  auto variant_rules(this const ParameterSweep& self,
+                     std::size_t variant_index)
+   -> std::pair<jsoncons::ojson, Profile>
+  {
+    auto strategy_json = self.strategy_json_;
+    auto profile = self.profile_;
+
+    const auto values = self.variant_values(variant_index);
+    for(auto i = 0uz; i < values.size(); ++i) {
+      apply_sweep_parameter(
+       strategy_json, profile, self.parameters_[i].path, values[i]);
+    }
+
+    return {std::move(strategy_json), std::move(profile)};
+  }
+
+  auto run_variant(this const ParameterSweep& self, std::size_t variant_index)
+   -> SweepResult
+  {
+    auto result = SweepResult{};
+    result.variant_index = variant_index;
+    result.values = self.variant_values(variant_index);
+
+    try {
+      auto [strategy_json, profile] = self.variant_rules(variant_index);
+
+      auto config_parser = make_default_registered_config_parser();
+      const auto name = std::format("Variant {}", variant_index);
+      auto strategy_ptr = std::make_shared<Strategy>(
+       parse_backtest_strategy_json(name, strategy_json, config_parser));
+      auto profile_ptr = std::make_shared<Profile>(std::move(profile));
+
+      // The backtest only observes its rules, so the variant keeps them.
+      auto backtest = Backtest{name,
+                               self.initial_capital_,
+                               self.asset_ptr_,
+                               strategy_ptr,
+                               self.market_ptr_,
+                               self.broker_ptr_,
+                               profile_ptr};
+      backtest.column_cache_ptr(self.column_cache_ptr_);
+      backtest.warmup_bar_count(self.warmup_bar_count_);
+      while(backtest.should_run()) {
+        backtest.run();
+      }
+
+      if(backtest.is_failed() || backtest.results().empty()) {
+        result.error = "Backtest failed";
+        return result;
+      }
+
+      const auto& summary = backtest.results().last_summary();
+      result.total_profit = summary.cumulative_pnls();
+      result.max_drawdown = summary.max_drawdown();
+      result.expected_value = summary.expected_value();
+      result.profit_rate = summary.profit_rate();
+      result.profit_factor = summary.profit_factor();
+      result.trade_count = summary.trade_count();
+    } catch(const std::exception& error) {
+      result.error = error.what();
+    }
+
+    return result;
+  }
+
+  /**
+   * Run every variant on `thread_count` threads, or one per core when it is
+   * zero, and return the results ranked by `rank_sweep_results`.
+   * `on_result` receives each result as soon as its variant finishes, one at a
+   * time, in the order the variants finish.
+   *
+   * Invalid parameter paths throw before any variant runs.
+   */
+  auto run(this const ParameterSweep& self,
+           std::size_t thread_count = 0,
+           std::function<void(const SweepResult&)> on_result = {})
+   -> std::vector<SweepResult>
+  {
+    const auto count = self.variant_count();
+    if(count == 0) {
+      return {};
+    }
+    self.variant_rules(0);
+
+#ifdef __EMSCRIPTEN__
+    thread_count = 1;
+#else
+    if(thread_count == 0) {
+      thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+#endif
+    thread_count = std::min(thread_count, count);
+
+    auto results = std::vector<SweepResult>(count);
+    auto next_variant = std::atomic<std::size_t>{0};
+    auto result_mutex = std::mutex{};
+    auto error = std::exception_ptr{};
+
+    const auto run_variants = [&] {
+      for(auto i = next_variant.fetch_add(1); i < count;
+          i = next_variant.fetch_add(1)) {
+        results[i] = self.run_variant(i);
+
+        if(on_result) {
+          const auto lock = std::lock_guard{result_mutex};
+          if(error) {
+            break;
+          }
+          try {
+            on_result(results[i]);
+          } catch(...) {
+            error = std::current_exception();
+            next_variant = count;
+          }
+        }
+      }
+    };
+
+    {
+      // The calling thread runs variants alongside the workers.
+      auto workers = std::vector<std::jthread>{};
+      workers.reserve(thread_count - 1);
+      for(auto i = 1uz; i < thread_count; ++i) {
+        workers.emplace_back(run_variants);
+      }
+      run_variants();
+    }
+
+    if(error) {
+      std::rethrow_exception(error);
+    }
+
+    rank_sweep_results(results);
+    return results;
+  }
+
+private:
+  jsoncons::ojson strategy_json_;
+  Profile profile_;
+  std::shared_ptr<Asset> asset_ptr_;
+  std::shared_ptr<Market> market_ptr_;
+  std::shared_ptr<Broker> broker_ptr_;
+  double initial_capital_;
+  std::vector<SweepParameter> parameters_;
+  std::shared_ptr<ColumnCache> column_cache_ptr_;
+  std::size_t warmup_bar_count_;
+};
+
+} // namespace pludux::backtest
@@ -5,9 +5,9 @@ module;
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
-#include <vector>
 
 export module pludux.backtest:plots.any_plot_method_context;
 
@@ -22,7 +22,7 @@ public:
   AnyPlotMethodContext(TPlotMethodContext plot_method_context)
   : impl_{std::move(plot_method_context)}
   , render_plot_line_{[](const std::any& impl,
-                         const std::vector<double>& data,
+                         std::span<const double> data,
                          std::uint32_t color) {
     auto* context = std::any_cast<TPlotMethodContext>(&impl);
     if(context) {
@@ -31,7 +31,7 @@ public:
     // TODO: handle error case (e.g., log an error message)
   }}
   , render_plot_histogram_{[](const std::any& impl,
-                              const std::vector<double>& data,
+                              std::span<const double> data,
                               std::uint32_t color) {
     auto* context = std::any_cast<TPlotMethodContext>(&impl);
     if(context) {
@@ -40,8 +40,7 @@ public:
     // TODO: handle error case (e.g., log an error message)
   }}
   , series_results_{[](const std::any& impl, const std::string& series_name)
-                     -> std::optional<
-                      std::reference_wrapper<const std::vector<double>>> {
+                     -> std::optional<std::span<const double>> {
     auto* context = std::any_cast<TPlotMethodContext>(&impl);
     if(context) {
       return context->series_results(series_name);
@@ -59,14 +58,14 @@ public:
   }
 
   void render_plot_line(this const AnyPlotMethodContext& self,
-                        const std::vector<double>& data,
+                        std::span<const double> data,
                         std::uint32_t color)
   {
     self.render_plot_line_(self.impl_, data, color);
   }
 
   void render_plot_histogram(this const AnyPlotMethodContext& self,
-                             const std::vector<double>& data,
+                             std::span<const double> data,
                              std::uint32_t color)
   {
     self.render_plot_histogram_(self.impl_, data, color);
@@ -74,7 +73,7 @@ public:
 
   auto series_results(this const AnyPlotMethodContext& self,
                       const std::string& series_name)
-   -> std::optional<std::reference_wrapper<const std::vector<double>>>
+   -> std::optional<std::span<const double>>
   {
     return self.series_results_(self.impl_, series_name);
   }
@@ -103,17 +102,14 @@ public:
 private:
   std::any impl_;
 
-  std::function<void(
-   const std::any&, const std::vector<double>&, std::uint32_t)>
+  std::function<void(const std::any&, std::span<const double>, std::uint32_t)>
    render_plot_line_;
 
-  std::function<void(
-   const std::any&, const std::vector<double>&, std::uint32_t)>
+  std::function<void(const std::any&, std::span<const double>, std::uint32_t)>
    render_plot_histogram_;
 
-  std::function<
-   auto(const std::any&, const std::string&)
-    ->std::optional<std::reference_wrapper<const std::vector<double>>>>
+  std::function<auto(const std::any&, const std::string&)
+                 ->std::optional<std::span<const double>>>
    series_results_;
 
   std::function<auto(const std::any&)->std::size_t> results_size_;
@@ -2,7 +2,6 @@ module;
 
 #include <cstdint>
 #include <utility>
-#include <vector>
 
 export module pludux.backtest:plots.histogram_plot_method;
 
@@ -33,7 +32,7 @@ public:
   void operator()(this const HistogramPlotMethod& self,
                   PlotMethodContextable auto context)
   {
-    const auto& data = self.source_(context);
+    const auto data = self.source_(context);
 
     context.render_plot_histogram(data, self.color_);
   }
@@ -2,7 +2,6 @@ module;
 
 #include <cstdint>
 #include <utility>
-#include <vector>
 
 export module pludux.backtest:plots.line_plot_method;
 
@@ -33,7 +32,7 @@ public:
   void operator()(this const LinePlotMethod& self,
                   PlotMethodContextable auto context)
   {
-    const auto& data = self.source_(context);
+    const auto data = self.source_(context);
 
     context.render_plot_line(data, self.color_);
   }
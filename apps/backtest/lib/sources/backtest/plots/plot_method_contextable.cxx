@@ -3,10 +3,9 @@ module;
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <optional>
+#include <span>
 #include <string>
-#include <vector>
 
 export module pludux.backtest:plots.plot_method_contextable;
 
@@ -14,7 +13,7 @@ export namespace pludux::backtest {
 
 template<typename TContext>
 concept PlotMethodContextable = requires(TContext context,
-                                         std::vector<double> data,
+                                         std::span<const double> data,
                                          std::string series_name,
                                          std::uint32_t color) {
   context.render_plot_line(data, color);
@@ -23,8 +22,7 @@ concept PlotMethodContextable = requires(TContext context,
 
   {
     context.series_results(series_name)
-  } -> std::same_as<
-   std::optional<std::reference_wrapper<const std::vector<double>>>>;
+  } -> std::same_as<std::optional<std::span<const double>>>;
 
   { context.results_size() } -> std::convertible_to<std::size_t>;
 };
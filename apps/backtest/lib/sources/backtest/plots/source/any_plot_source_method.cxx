@@ -2,7 +2,8 @@ module;
 
 #include <any>
 #include <functional>
-#include <vector>
+#include <span>
+#include <utility>
 
 export module pludux.backtest:plots.any_plot_source_method;
 
@@ -22,14 +23,12 @@ public:
   AnyPlotSourceMethod(TPlotSourceMethod plot_source_method)
   : impl_{std::move(plot_source_method)}
   , func_{[](const std::any& impl,
-             AnyPlotMethodContext context) -> const std::vector<double>& {
-    static const auto empty_result = std::vector<double>{};
-
+             AnyPlotMethodContext context) -> std::span<const double> {
     auto* method = std::any_cast<TPlotSourceMethod>(&impl);
     if(method) {
       return (*method)(context);
     }
-    return empty_result;
+    return {};
   }}
   , equals_{[](const std::any& impl, const AnyPlotSourceMethod& other) {
     if(auto other_method = std::any_cast<TPlotSourceMethod>(&other.impl_)) {
@@ -62,7 +61,7 @@ public:
 
   auto operator()(this const AnyPlotSourceMethod& self,
                   PlotMethodContextable auto context)
-   -> const std::vector<double>&
+   -> std::span<const double>
   {
     return self.func_(self.impl_, std::forward<decltype(context)>(context));
   }
@@ -84,8 +83,8 @@ public:
 private:
   std::any impl_;
 
-  std::function<
-   auto(const std::any&, AnyPlotMethodContext)->const std::vector<double>&>
+  std::function<auto(const std::any&, AnyPlotMethodContext)
+                 ->std::span<const double>>
    func_;
 
   std::function<auto(const std::any&, const AnyPlotSourceMethod&)->bool>
@@ -1,5 +1,6 @@
 module;
 
+#include <span>
 #include <vector>
 
 export module pludux.backtest:plots.constant_plot_source_method;
@@ -21,7 +22,7 @@ public:
   // TODO: use std::generator<double> when it's available
   auto operator()(this const ConstantPlotSourceMethod& self,
                   PlotMethodContextable auto context)
-   -> const std::vector<double>&
+   -> std::span<const double>
   {
     const auto size = context.results_size();
     if(self.cached_data_.size() != size) {
@@ -1,8 +1,8 @@
 module;
 
+#include <span>
 #include <string>
 #include <utility>
-#include <vector>
 
 export module pludux.backtest:plots.series_plot_source_method;
 
@@ -22,11 +22,10 @@ public:
 
   auto operator()(this const SeriesPlotSourceMethod& self,
                   PlotMethodContextable auto context)
-   -> const std::vector<double>&
+   -> std::span<const double>
   {
-    static const auto empty_result = std::vector<double>{};
-    const auto series_results_opt = context.series_results(self.series_name_);
-    return series_results_opt ? series_results_opt->get() : empty_result;
+    return context.series_results(self.series_name_)
+     .value_or(std::span<const double>{});
   }
 
   auto series_name(this const SeriesPlotSourceMethod& self) noexcept
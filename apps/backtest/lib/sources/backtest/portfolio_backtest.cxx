@@ -0,0 +1,383 @@
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <exception>
+#include <format>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+export module pludux.backtest:portfolio_backtest;
+
+import pludux;
+
+import :asset;
+import :strategy;
+import :market;
+import :broker;
+import :profile;
+import :trade_entry;
+import :backtest;
+
+export namespace pludux::backtest {
+
+/**
+ * Backtest one strategy on many assets sharing one capital.
+ *
+ * Every asset runs in a backtest of its own, and the backtests step together
+ * through the timeline merged from the datetimes of their bars. A step runs
+ * the assets with a bar at its datetime, so assets whose bars do not line up
+ * wait for their next bar while the others move on.
+ *
+ * The assets of a step start their bars in parallel: series, filters and
+ * exits only read their own asset. Their entries are then sized and entered
+ * one asset at a time, in the order of the assets, risking the capital risk
+ * of the profile on the capital of the portfolio at the start of the step.
+ * The series and filter columns of every asset are computed in parallel
+ * before the first step.
+ */
+class PortfolioBacktest {
+public:
+  PortfolioBacktest(std::string name,
+                    double initial_capital,
+                    std::vector<std::shared_ptr<Asset>> asset_ptrs,
+                    std::shared_ptr<Strategy> strategy_ptr,
+                    std::shared_ptr<Market> market_ptr,
+                    std::shared_ptr<Broker> broker_ptr,
+                    std::shared_ptr<Profile> profile_ptr)
+  : name_{std::move(name)}
+  , initial_capital_{initial_capital}
+  , asset_ptrs_{std::move(asset_ptrs)}
+  , strategy_ptr_{std::move(strategy_ptr)}
+  , market_ptr_{std::move(market_ptr)}
+  , broker_ptr_{std::move(broker_ptr)}
+  , profile_ptr_{std::move(profile_ptr)}
+  , capital_{initial_capital}
+  {
+  }
+
+  auto name(this const PortfolioBacktest& self) noexcept -> const std::string&
+  {
+    return self.name_;
+  }
+
+  auto initial_capital(this const PortfolioBacktest& self) noexcept -> double
+  {
+    return self.initial_capital_;
+  }
+
+  auto asset_ptrs(this const PortfolioBacktest& self) noexcept
+   -> const std::vector<std::shared_ptr<Asset>>&
+  {
+    return self.asset_ptrs_;
+  }
+
+  /**
+   * The backtests of the assets, in the order of the assets, with the trades
+   * of each asset in its results.
+   */
+  auto backtests(this const PortfolioBacktest& self) noexcept
+   -> const std::vector<std::shared_ptr<Backtest>>&
+  {
+    return self.backtests_;
+  }
+
+  /**
+   * The datetime of every step of the run.
+   */
+  auto timestamps(this const PortfolioBacktest& self) noexcept
+   -> const std::vector<std::time_t>&
+  {
+    return self.timestamps_;
+  }
+
+  /**
+   * The capital of the portfolio after every step: the initial capital and
+   * the profits of the closed trades of every asset.
+   */
+  auto capitals(this const PortfolioBacktest& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.capitals_;
+  }
+
+  /**
+   * The equity of the portfolio after every step: its capital and the
+   * unrealized profits of the open positions.
+   */
+  auto equities(this const PortfolioBacktest& self) noexcept
+   -> const std::vector<double>&
+  {
+    return self.equities_;
+  }
+
+  auto capital(this const PortfolioBacktest& self) noexcept -> double
+  {
+    return self.capital_;
+  }
+
+  /**
+   * Run every step on `thread_count` threads, or one per core when it is
+   * zero, starting over from the initial capital. The run throws if an asset
+   * is missing, or if any rule of the backtests is missing.
+   */
+  void run(this PortfolioBacktest& self, std::size_t thread_count = 0)
+  {
+    self.reset_();
+
+    const auto asset_count = self.backtests_.size();
+
+#ifdef __EMSCRIPTEN__
+    thread_count = 1;
+#else
+    if(thread_count == 0) {
+      thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+#endif
+    thread_count = std::clamp(thread_count, 1uz, std::max(asset_count, 1uz));
+
+    auto step_state = StepState_{};
+    step_state.bar_datetimes.resize(asset_count);
+    step_state.bar_indices.resize(asset_count, 0);
+    step_state.entry_trades.resize(asset_count);
+    step_state.asset_capitals.resize(asset_count, self.initial_capital_);
+    step_state.asset_unrealized_pnls.resize(asset_count, 0.0);
+    step_state.task_count = asset_count;
+
+    auto next_task = std::atomic<std::size_t>{0};
+    auto error = std::exception_ptr{};
+    auto error_mutex = std::mutex{};
+
+    const auto keep_error = [&] {
+      const auto lock = std::lock_guard{error_mutex};
+      if(!error) {
+        error = std::current_exception();
+      }
+    };
+
+    // Once every thread is done with the tasks of a phase, one of them enters
+    // the trades of the step and picks the assets of the next one.
+    const auto finish_phase = [&]() noexcept {
+      try {
+        if(step_state.is_preparing) {
+          step_state.is_preparing = false;
+        } else {
+          self.finish_step_(step_state);
+        }
+
+        if(!error) {
+          self.start_step_(step_state);
+        }
+      } catch(...) {
+        keep_error();
+      }
+
+      step_state.is_done = error || step_state.step_assets.empty();
+      step_state.task_count = step_state.step_assets.size();
+      next_task = 0;
+    };
+
+    auto barrier = std::barrier{static_cast<std::ptrdiff_t>(thread_count),
+                                finish_phase};
+
+    const auto run_phases = [&] {
+      while(!step_state.is_done) {
+        for(auto i = next_task.fetch_add(1); i < step_state.task_count;
+            i = next_task.fetch_add(1)) {
+          try {
+            if(step_state.is_preparing) {
+              self.prepare_asset_(i, step_state);
+            } else {
+              const auto asset_index = step_state.step_assets[i];
+              step_state.entry_trades[asset_index] =
+               self.backtests_[asset_index]->run_exits(1.0);
+            }
+          } catch(...) {
+            keep_error();
+          }
+        }
+
+        barrier.arrive_and_wait();
+      }
+    };
+
+    {
+      // The calling thread runs tasks alongside the workers.
+      auto workers = std::vector<std::jthread>{};
+      workers.reserve(thread_count - 1);
+      for(auto i = 1uz; i < thread_count; ++i) {
+        workers.emplace_back(run_phases);
+      }
+      run_phases();
+    }
+
+    if(error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+private:
+  std::string name_;
+  double initial_capital_;
+  std::vector<std::shared_ptr<Asset>> asset_ptrs_;
+  std::shared_ptr<Strategy> strategy_ptr_;
+  std::shared_ptr<Market> market_ptr_;
+  std::shared_ptr<Broker> broker_ptr_;
+  std::shared_ptr<Profile> profile_ptr_;
+
+  std::vector<std::shared_ptr<Backtest>> backtests_;
+  std::vector<std::time_t> timestamps_;
+  std::vector<double> capitals_;
+  std::vector<double> equities_;
+  double capital_;
+
+  /**
+   * The progress of a run through the merged timeline, written by one thread
+   * between the phases and read by every thread during them.
+   */
+  struct StepState_ {
+    std::vector<std::vector<double>> bar_datetimes;
+    std::vector<std::size_t> bar_indices;
+    std::vector<std::optional<TradeEntry>> entry_trades;
+    std::vector<double> asset_capitals;
+    std::vector<double> asset_unrealized_pnls;
+    double unrealized_pnl{0.0};
+
+    std::vector<std::size_t> step_assets;
+    double step_datetime{0.0};
+
+    std::size_t task_count{0};
+    bool is_preparing{true};
+    bool is_done{false};
+  };
+
+  void reset_(this PortfolioBacktest& self)
+  {
+    self.backtests_.clear();
+    self.backtests_.reserve(self.asset_ptrs_.size());
+    for(const auto& asset_ptr : self.asset_ptrs_) {
+      self.backtests_.push_back(
+       std::make_shared<Backtest>(asset_ptr ? asset_ptr->name() : "",
+                                  self.initial_capital_,
+                                  asset_ptr,
+                                  self.strategy_ptr_,
+                                  self.market_ptr_,
+                                  self.broker_ptr_,
+                                  self.profile_ptr_));
+    }
+
+    self.timestamps_.clear();
+    self.capitals_.clear();
+    self.equities_.clear();
+    self.capital_ = self.initial_capital_;
+  }
+
+  /**
+   * Compute the columns of the asset and read the datetimes of its bars,
+   * from the oldest.
+   */
+  void prepare_asset_(this const PortfolioBacktest& self,
+                      std::size_t asset_index,
+                      StepState_& step_state)
+  {
+    auto& backtest = *self.backtests_[asset_index];
+    if(!backtest.is_valid_rules()) {
+      throw std::runtime_error{
+       std::format("Backtest {} of the portfolio is missing its asset, "
+                   "strategy, market, broker or profile",
+                   asset_index)};
+    }
+    backtest.prepare();
+
+    const auto& asset = backtest.asset();
+    const auto datetimes = asset.get_snapshot(0).datetimes();
+    const auto bar_count = asset.size();
+
+    auto& bar_datetimes = step_state.bar_datetimes[asset_index];
+    bar_datetimes.reserve(bar_count);
+    for(auto lookback = bar_count; lookback-- > 0;) {
+      const auto datetime = datetimes[lookback];
+      if(std::isnan(datetime)) {
+        throw std::runtime_error{
+         std::format("Asset {} has a bar without datetime", asset.name())};
+      }
+      bar_datetimes.push_back(datetime);
+    }
+  }
+
+  /**
+   * Pick the assets whose next bar is the earliest of all the next bars.
+   */
+  void start_step_(this const PortfolioBacktest&, StepState_& step_state)
+  {
+    auto step_datetime = std::numeric_limits<double>::infinity();
+    for(auto i = 0uz; i < step_state.bar_datetimes.size(); ++i) {
+      const auto& bar_datetimes = step_state.bar_datetimes[i];
+      const auto bar_index = step_state.bar_indices[i];
+      if(bar_index < bar_datetimes.size()) {
+        step_datetime = std::min(step_datetime, bar_datetimes[bar_index]);
+      }
+    }
+
+    step_state.step_assets.clear();
+    step_state.step_datetime = step_datetime;
+    for(auto i = 0uz; i < step_state.bar_datetimes.size(); ++i) {
+      const auto& bar_datetimes = step_state.bar_datetimes[i];
+      const auto bar_index = step_state.bar_indices[i];
+      if(bar_index < bar_datetimes.size() &&
+         bar_datetimes[bar_index] == step_datetime) {
+        step_state.step_assets.push_back(i);
+      }
+    }
+  }
+
+  /**
+   * Size and enter the trades of the step, one asset at a time, and record
+   * the capital and equity of the portfolio after it.
+   */
+  void finish_step_(this PortfolioBacktest& self, StepState_& step_state)
+  {
+    const auto risk_value = self.profile_ptr_->capital_risk() * self.capital_;
+
+    for(const auto asset_index : step_state.step_assets) {
+      auto& entry_trade = step_state.entry_trades[asset_index];
+      if(entry_trade && risk_value > 0.0) {
+        entry_trade->position_size(entry_trade->position_size() * risk_value);
+      } else {
+        entry_trade.reset();
+      }
+
+      auto& backtest = *self.backtests_[asset_index];
+      backtest.run_entry(std::exchange(entry_trade, std::nullopt));
+      ++step_state.bar_indices[asset_index];
+
+      const auto& summary = backtest.results().last_summary();
+      const auto unrealized_pnl = summary.equity() - summary.capital();
+
+      self.capital_ +=
+       summary.capital() - step_state.asset_capitals[asset_index];
+      step_state.unrealized_pnl +=
+       unrealized_pnl - step_state.asset_unrealized_pnls[asset_index];
+      step_state.asset_capitals[asset_index] = summary.capital();
+      step_state.asset_unrealized_pnls[asset_index] = unrealized_pnl;
+    }
+
+    self.timestamps_.push_back(
+     static_cast<std::time_t>(step_state.step_datetime));
+    self.capitals_.push_back(self.capital_);
+    self.equities_.push_back(self.capital_ + step_state.unrealized_pnl);
+  }
+};
+
+} // namespace pludux::backtest
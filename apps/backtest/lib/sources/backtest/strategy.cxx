@@ -2,12 +2,17 @@ module;
 
 #include <cctype>
 #include <cstdint>
+#include <exception>
+#include <format>
 #include <istream>
 #include <memory>
 #include <optional>
+#include <set>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <jsoncons/json.hpp>
 
@@ -224,15 +229,71 @@ private:
   std::vector<PlotGroup> plots_;
 };
 
-auto parse_backtest_strategy_json(std::string_view strategy_name,
-                                  std::istream& json_strategy_stream)
- -> backtest::Strategy
+/**
+ * Collect the names of the series referenced anywhere in a method config.
+ */
+void collect_series_references(const jsoncons::ojson& config,
+                               std::set<std::string>& names)
 {
-  auto config_parser = make_default_registered_config_parser();
+  if(config.is_array()) {
+    for(const auto& item : config.array_range()) {
+      collect_series_references(item, names);
+    }
+    return;
+  }
 
-  auto strategy_json = jsoncons::ojson::parse(
-   json_strategy_stream, jsoncons::json_options{}.allow_comments(true));
+  if(!config.is_object()) {
+    return;
+  }
+
+  if(config.contains("method") && config.at("method").is_string()) {
+    const auto method = config.at("method").as_string();
+    if(method == "SERIES_NODE" || method == "SERIES_VALUE") {
+      const auto& params =
+       config.contains("params") ? config.at("params") : config;
+      if(params.contains("name")) {
+        names.insert(params.at("name").as_string());
+      }
+    }
+  }
+
+  for(const auto& [_, member_config] : config.object_range()) {
+    collect_series_references(member_config, names);
+  }
+}
 
+/**
+ * Whether a config holds a method the parser could not serialize, which is
+ * left null and so cannot tell two methods apart.
+ */
+auto has_unserialized_method(const jsoncons::ojson& config) -> bool
+{
+  if(config.is_null()) {
+    return true;
+  }
+
+  if(config.is_array()) {
+    for(const auto& item : config.array_range()) {
+      if(has_unserialized_method(item)) {
+        return true;
+      }
+    }
+  } else if(config.is_object()) {
+    for(const auto& [_, member_config] : config.object_range()) {
+      if(has_unserialized_method(member_config)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+auto parse_backtest_strategy_json(std::string_view strategy_name,
+                                  const jsoncons::ojson& strategy_json,
+                                  ConfigParser& config_parser)
+ -> backtest::Strategy
+{
   if(!strategy_json.is_object()) {
     throw std::runtime_error(
      "Invalid strategy JSON: expected an object at the root");
@@ -251,6 +312,24 @@ auto parse_backtest_strategy_json(std::string_view strategy_name,
     ? config_parser.parse_registered_methods(strategy_json.at("series"))
     : SeriesMethodRegistry{};
 
+  {
+    auto series_references = std::set<std::string>{};
+    if(strategy_json.contains("series")) {
+      collect_series_references(strategy_json.at("series"), series_references);
+    }
+    if(strategy_json.contains("positions")) {
+      collect_series_references(strategy_json.at("positions"),
+                                series_references);
+    }
+
+    for(const auto& series_name : series_references) {
+      if(!series_registry.has(series_name)) {
+        throw std::runtime_error(
+         std::format("Unknown series: {}", series_name));
+      }
+    }
+  }
+
   auto long_entry_filter = AnyConditionMethod{NeverMethod{}};
   auto long_exit_filter = AnyConditionMethod{NeverMethod{}};
 
@@ -358,6 +437,19 @@ auto parse_backtest_strategy_json(std::string_view strategy_name,
                   plots};
 }
 
+auto parse_backtest_strategy_json(std::string_view strategy_name,
+                                  std::istream& json_strategy_stream)
+ -> backtest::Strategy
+{
+  auto config_parser = make_default_registered_config_parser();
+
+  const auto strategy_json = jsoncons::ojson::parse(
+   json_strategy_stream, jsoncons::json_options{}.allow_comments(true));
+
+  return parse_backtest_strategy_json(
+   strategy_name, strategy_json, config_parser);
+}
+
 auto parse_backtest_strategy_json(std::string_view strategy_name,
                                   const std::string& json_strategy_str)
  -> backtest::Strategy
@@ -428,4 +520,50 @@ auto stringify_backtest_strategy(const backtest::Strategy& strategy)
   return strategy_json;
 }
 
+/**
+ * Build the method graph a backtest evaluates. Methods repeated across the
+ * series and signals of the strategy become shared nodes that are evaluated
+ * once per bar, and series references are linked to the slots of their series
+ * in the registry. The shared nodes do not match the method types the editor
+ * expects, so the result is only meant to be run. A backtest builds it once
+ * per strategy and keeps it across resets.
+ *
+ * Only the methods written in the strategy are compared. The subtrees a
+ * method builds itself, like the RSI that STOCH_RSI reads twice, are shared
+ * inside that method.
+ *
+ * Strategies parsed from JSON have their series references checked when they
+ * are loaded. A strategy built in code referencing a series it does not
+ * define fails here, before its first bar runs.
+ */
+auto share_common_methods(const backtest::Strategy& strategy)
+ -> backtest::Strategy
+{
+  auto config_parser = make_default_registered_config_parser();
+  auto strategy_json = jsoncons::ojson{};
+
+  // Methods that cannot be serialized cannot be compared either, so the
+  // strategy is run as it is.
+  try {
+    strategy_json = stringify_backtest_strategy(strategy);
+  } catch(const std::exception&) {
+    return strategy;
+  }
+
+  if(has_unserialized_method(strategy_json.at("series")) ||
+     has_unserialized_method(strategy_json.at("positions"))) {
+    return strategy;
+  }
+  config_parser.share_common_methods(strategy_json);
+
+  auto series_names = std::vector<std::string>{};
+  for(const auto& [series_name, _] : strategy.series_registry()) {
+    series_names.push_back(series_name);
+  }
+  config_parser.link_series(series_names);
+
+  return parse_backtest_strategy_json(
+   strategy.name(), strategy_json, config_parser);
+}
+
 } // namespace pludux::backtest
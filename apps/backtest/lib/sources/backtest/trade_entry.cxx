@@ -10,6 +10,11 @@ export namespace pludux::backtest {
 
 class TradeEntry {
 public:
+  TradeEntry()
+  : TradeEntry{0.0, 0.0}
+  {
+  }
+
   TradeEntry(double position_size, double price)
   : TradeEntry{position_size, price, NAN, false, NAN}
   {
@@ -12,6 +12,11 @@ class TradeExit {
 public:
   enum class Reason { signal, stop_loss, take_profit };
 
+  TradeExit()
+  : TradeExit{0.0, 0.0, Reason::signal}
+  {
+  }
+
   TradeExit(double position_size, double price, Reason reason)
   : reason_(reason)
   , position_size_(position_size)
@@ -287,6 +287,17 @@ public:
     }
   }
 
+  /**
+   * Set the trailing stop of the open position, if any.
+   */
+  void update_stop_loss_trailing_price(this TradeSession& self,
+                                       double price) noexcept
+  {
+    if(self.open_position_) {
+      self.open_position_->stop_loss_trailing_price(price);
+    }
+  }
+
   void market_update(this TradeSession& self,
                      std::time_t timestamp,
                      double price,
@@ -0,0 +1,313 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <format>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+export module pludux.backtest:walk_forward;
+
+import pludux;
+
+import :asset;
+import :strategy;
+import :market;
+import :broker;
+import :profile;
+import :backtest;
+import :parameter_sweep;
+
+export namespace pludux::backtest {
+
+/**
+ * One step of a walk-forward run: the parameters optimized on the train bars
+ * and their out-of-sample backtest on the test bars that follow. Bounds are
+ * positions in the asset history, from `begin` up to `end`.
+ *
+ * A window whose optimization or test fails keeps the error and stays flat
+ * in the stitched equity.
+ */
+struct WalkForwardWindow {
+  std::size_t train_begin{0};
+  std::size_t train_end{0};
+  std::size_t test_begin{0};
+  std::size_t test_end{0};
+
+  std::vector<double> values;
+  std::string error;
+
+  double train_profit{0.0};
+  double test_profit{0.0};
+  std::size_t test_trade_count{0};
+
+  /**
+   * The equity of the test backtest on every test bar.
+   */
+  std::vector<double> test_equities;
+
+  auto is_failed(this const WalkForwardWindow& self) noexcept -> bool
+  {
+    return !self.error.empty();
+  }
+};
+
+/**
+ * The windows of a walk-forward run and the out-of-sample equity stitched
+ * from their test backtests, one value per tested bar.
+ */
+struct WalkForwardResult {
+  std::vector<WalkForwardWindow> windows;
+  std::vector<double> equities;
+  double total_profit{0.0};
+};
+
+/**
+ * Optimize the parameters of a strategy on rolling windows of the asset and
+ * test each optimum on the bars after its window.
+ *
+ * The history is split into train windows of `train_bar_count` bars, each
+ * followed by `test_bar_count` test bars, and the windows move forward by
+ * the test bars so the test windows cover the rest of the history once. An
+ * anchored run keeps every train window starting at the first bar.
+ *
+ * Windows are zero-copy views of the asset history. Each backtest also reads
+ * up to `warmup_bar_count` bars before its window to warm up its series,
+ * without trading them. Nothing else is carried over from the bars before:
+ * indicators start from the first warmup bar. One that looks back no further
+ * than the warmup bars, such as an SMA, starts the window with the values it
+ * has in the full history; a recursive one, such as an EMA, only converges
+ * to them over the warmup bars.
+ */
+class WalkForward {
+public:
+  WalkForward(jsoncons::ojson strategy_json,
+              Profile profile,
+              std::shared_ptr<Asset> asset_ptr,
+              std::shared_ptr<Market> market_ptr,
+              std::shared_ptr<Broker> broker_ptr,
+              double initial_capital,
+              std::vector<SweepParameter> parameters,
+              std::size_t train_bar_count,
+              std::size_t test_bar_count)
+  : strategy_json_{std::move(strategy_json)}
+  , profile_{std::move(profile)}
+  , asset_ptr_{std::move(asset_ptr)}
+  , market_ptr_{std::move(market_ptr)}
+  , broker_ptr_{std::move(broker_ptr)}
+  , initial_capital_{initial_capital}
+  , parameters_{std::move(parameters)}
+  , train_bar_count_{train_bar_count}
+  , test_bar_count_{test_bar_count}
+  , warmup_bar_count_{0}
+  , is_anchored_{false}
+  {
+    if(train_bar_count_ == 0 || test_bar_count_ == 0) {
+      throw std::runtime_error(
+       "Walk-forward windows need at least one train and one test bar");
+    }
+  }
+
+  auto train_bar_count(this const WalkForward& self) noexcept -> std::size_t
+  {
+    return self.train_bar_count_;
+  }
+
+  auto test_bar_count(this const WalkForward& self) noexcept -> std::size_t
+  {
+    return self.test_bar_count_;
+  }
+
+  auto warmup_bar_count(this const WalkForward& self) noexcept -> std::size_t
+  {
+    return self.warmup_bar_count_;
+  }
+
+  void warmup_bar_count(this WalkForward& self,
+                        std::size_t new_warmup_bar_count) noexcept
+  {
+    self.warmup_bar_count_ = new_warmup_bar_count;
+  }
+
+  auto is_anchored(this const WalkForward& self) noexcept -> bool
+  {
+    return self.is_anchored_;
+  }
+
+  void is_anchored(this WalkForward& self, bool new_is_anchored) noexcept
+  {
+    self.is_anchored_ = new_is_anchored;
+  }
+
+  /**
+   * The bounds of the windows, without results.
+   */
+  auto windows(this const WalkForward& self) -> std::vector<WalkForwardWindow>
+  {
+    const auto asset_size = self.asset_ptr_ ? self.asset_ptr_->size() : 0;
+
+    auto windows = std::vector<WalkForwardWindow>{};
+    for(auto test_begin = self.train_bar_count_; test_begin < asset_size;
+        test_begin += self.test_bar_count_) {
+      auto window = WalkForwardWindow{};
+      window.train_begin =
+       self.is_anchored_ ? 0 : test_begin - self.train_bar_count_;
+      window.train_end = test_begin;
+      window.test_begin = test_begin;
+      window.test_end = std::min(test_begin + self.test_bar_count_, asset_size);
+      windows.push_back(std::move(window));
+    }
+    return windows;
+  }
+
+  /**
+   * Run the windows in order, each sweeping its train bars on `thread_count`
+   * threads as `ParameterSweep::run` does, and stitch their test equities.
+   * `on_window` receives each window once it is tested.
+   *
+   * The stitched equity starts at the initial capital and adds the change of
+   * equity of every test bar. Positions still open at the end of a test
+   * window count at their unrealized value, and the next window starts flat.
+   */
+  auto run(this const WalkForward& self,
+           std::size_t thread_count = 0,
+           std::function<void(const WalkForwardWindow&)> on_window = {})
+   -> WalkForwardResult
+  {
+    auto result = WalkForwardResult{};
+    auto capital = self.initial_capital_;
+
+    for(auto& window : self.windows()) {
+      self.run_window_(window, thread_count);
+
+      if(on_window) {
+        on_window(window);
+      }
+
+      const auto start_capital = capital;
+      for(auto i = 0uz; i < window.test_end - window.test_begin; ++i) {
+        if(i < window.test_equities.size()) {
+          capital =
+           start_capital + window.test_equities[i] - self.initial_capital_;
+        }
+        result.equities.push_back(capital);
+      }
+
+      result.windows.push_back(std::move(window));
+    }
+
+    result.total_profit = capital - self.initial_capital_;
+    return result;
+  }
+
+private:
+  jsoncons::ojson strategy_json_;
+  Profile profile_;
+  std::shared_ptr<Asset> asset_ptr_;
+  std::shared_ptr<Market> market_ptr_;
+  std::shared_ptr<Broker> broker_ptr_;
+  double initial_capital_;
+  std::vector<SweepParameter> parameters_;
+  std::size_t train_bar_count_;
+  std::size_t test_bar_count_;
+  std::size_t warmup_bar_count_;
+  bool is_anchored_;
+
+  /**
+   * The bars of the asset from `begin` up to `end`, viewed in place, and the
+   * number of bars before `begin` read to warm up the series.
+   */
+  auto window_asset_(this const WalkForward& self,
+                     std::size_t begin,
+                     std::size_t end)
+   -> std::pair<std::shared_ptr<Asset>, std::size_t>
+  {
+    const auto warmup_bar_count = std::min(self.warmup_bar_count_, begin);
+    const auto& asset = *self.asset_ptr_;
+
+    auto asset_ptr = std::make_shared<Asset>(
+     asset.name(),
+     asset.history().window(begin - warmup_bar_count, end),
+     asset.field_resolver());
+    return {std::move(asset_ptr), warmup_bar_count};
+  }
+
+  void run_window_(this const WalkForward& self,
+                   WalkForwardWindow& window,
+                   std::size_t thread_count)
+  {
+    const auto [train_asset_ptr, train_warmup_bar_count] =
+     self.window_asset_(window.train_begin, window.train_end);
+
+    auto sweep = ParameterSweep{self.strategy_json_,
+                                self.profile_,
+                                train_asset_ptr,
+                                self.market_ptr_,
+                                self.broker_ptr_,
+                                self.initial_capital_,
+                                self.parameters_};
+    sweep.warmup_bar_count(train_warmup_bar_count);
+
+    const auto sweep_results = sweep.run(thread_count);
+    if(sweep_results.empty() || sweep_results.front().is_failed()) {
+      window.error = sweep_results.empty() ? "No variant to optimize"
+                                           : sweep_results.front().error;
+      return;
+    }
+
+    const auto& best = sweep_results.front();
+    window.values = best.values;
+    window.train_profit = best.total_profit;
+
+    try {
+      const auto [test_asset_ptr, test_warmup_bar_count] =
+       self.window_asset_(window.test_begin, window.test_end);
+
+      auto [strategy_json, profile] = sweep.variant_rules(best.variant_index);
+
+      auto config_parser = make_default_registered_config_parser();
+      const auto name = std::format("Test {}", window.test_begin);
+      auto strategy_ptr = std::make_shared<Strategy>(
+       parse_backtest_strategy_json(name, strategy_json, config_parser));
+      auto profile_ptr = std::make_shared<Profile>(std::move(profile));
+
+      auto backtest = Backtest{name,
+                               self.initial_capital_,
+                               test_asset_ptr,
+                               strategy_ptr,
+                               self.market_ptr_,
+                               self.broker_ptr_,
+                               profile_ptr};
+      backtest.warmup_bar_count(test_warmup_bar_count);
+      while(backtest.should_run()) {
+        backtest.run();
+      }
+
+      if(backtest.is_failed() || backtest.results().empty()) {
+        window.error = "Backtest failed";
+        return;
+      }
+
+      const auto& equities = backtest.results().equities();
+      window.test_equities.assign(
+       equities.begin() +
+        std::min(test_warmup_bar_count, equities.size()),
+       equities.end());
+
+      const auto& summary = backtest.results().last_summary();
+      window.test_profit = summary.equity() - self.initial_capital_;
+      window.test_trade_count = summary.trade_count();
+    } catch(const std::exception& error) {
+      window.error = error.what();
+    }
+  }
+};
+
+} // namespace pludux::backtest
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+
+namespace {
+
+auto make_temp_path(const std::string& name) -> std::filesystem::path
+{
+  const auto path = std::filesystem::temp_directory_path() /
+                    std::format("pludux-test-asset-cache-{}", name);
+  std::filesystem::remove(path);
+  return path;
+}
+
+} // namespace
+
+TEST(AssetCacheTest, WriteAndRead)
+{
+  const auto cache_path = make_temp_path("roundtrip");
+
+  auto field_resolver = AssetQuoteFieldResolver{};
+  field_resolver.datetime_field("Time");
+  const auto asset = Asset{"Test",
+                           AssetHistory{{"Time", {3, 2, 1}},
+                                        {"Close", {30, 20, 10}},
+                                        {"Signal", {1}}},
+                           field_resolver};
+
+  write_asset_cache(asset, cache_path);
+  const auto cached_asset = read_asset_cache(cache_path);
+
+  EXPECT_TRUE(cached_asset.equivalent_with_nans_as_equal(asset));
+  EXPECT_EQ(cached_asset.field_resolver().datetime_field(), "Time");
+
+  const auto& history = cached_asset.history();
+  ASSERT_EQ(history.size(), 3);
+  EXPECT_EQ(history["Close"][0], 30);
+  EXPECT_EQ(history["Close"][2], 10);
+  EXPECT_EQ(history["Signal"].size(), 1);
+  EXPECT_EQ(history["Signal"][0], 1);
+  EXPECT_TRUE(std::isnan(history["Signal"][1]));
+
+  std::filesystem::remove(cache_path);
+}
+
+TEST(AssetCacheTest, RejectInvalidCache)
+{
+  const auto cache_path = make_temp_path("invalid");
+
+  write_asset_cache(Asset{"Test", AssetHistory{{"Close", {3, 2, 1}}}},
+                    cache_path);
+
+  {
+    auto file = std::fstream{
+     cache_path, std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(-1, std::ios::end);
+    file.put('\x7f');
+  }
+
+  EXPECT_THROW(read_asset_cache(cache_path), std::runtime_error);
+  EXPECT_NO_THROW(read_asset_cache(cache_path, false));
+
+  {
+    auto file = std::ofstream{cache_path, std::ios::binary};
+    file << "Datetime,Close\n";
+  }
+
+  EXPECT_THROW(read_asset_cache(cache_path), std::runtime_error);
+
+  std::filesystem::remove(cache_path);
+}
+
+TEST(AssetCacheTest, UpdateAssetFromCsvFile)
+{
+  const auto csv_path = make_temp_path("asset.csv");
+  const auto cache_path = asset_cache_path(csv_path);
+  std::filesystem::remove(cache_path);
+
+  {
+    auto file = std::ofstream{csv_path};
+    file << "Date,Close\n2024-01-01,1.5\n2024-01-02,2.5\n";
+  }
+
+  auto asset = Asset{"Test"};
+  update_asset_from_csv_file(asset, csv_path);
+
+  ASSERT_TRUE(std::filesystem::exists(cache_path));
+  EXPECT_EQ(asset.history()["Close"][0], 2.5);
+
+  auto cached_asset = Asset{"Cached"};
+  update_asset_from_csv_file(cached_asset, csv_path);
+
+  EXPECT_EQ(cached_asset.name(), "Cached");
+  EXPECT_TRUE(cached_asset.equivalent_rules(asset));
+
+  std::filesystem::remove(csv_path);
+  std::filesystem::remove(cache_path);
+}
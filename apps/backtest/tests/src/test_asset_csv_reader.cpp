@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <format>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+
+TEST(AssetCsvReaderTest, ParseIso8601Datetime)
+{
+  EXPECT_EQ(parse_iso8601_datetime("1970-01-01"), 0.0);
+  EXPECT_EQ(parse_iso8601_datetime("2024-02-29"), 1709164800.0);
+  EXPECT_EQ(parse_iso8601_datetime("2024-02-29 09:30"), 1709199000.0);
+  EXPECT_EQ(parse_iso8601_datetime("2024-02-29T09:30:15Z"), 1709199015.0);
+  EXPECT_EQ(parse_iso8601_datetime("2024-02-29T09:30:15.5Z"), 1709199015.5);
+  EXPECT_EQ(parse_iso8601_datetime("2024-02-29T16:30:00+07:00"),
+            1709199000.0);
+  EXPECT_EQ(parse_iso8601_datetime("2024-02-29T04:30:00-0500"),
+            1709199000.0);
+
+  EXPECT_FALSE(parse_iso8601_datetime("2023-02-29"));
+  EXPECT_FALSE(parse_iso8601_datetime("2024-13-01"));
+  EXPECT_FALSE(parse_iso8601_datetime("2024-01-01T9:30"));
+  EXPECT_FALSE(parse_iso8601_datetime("2024-01-01 09:30 UTC"));
+  EXPECT_FALSE(parse_iso8601_datetime("1709199000"));
+}
+
+TEST(AssetCsvReaderTest, ParseCsvNumber)
+{
+  EXPECT_EQ(parse_csv_number("42"), 42.0);
+  EXPECT_EQ(parse_csv_number(" -1.25 "), -1.25);
+  EXPECT_EQ(parse_csv_number("+3e2"), 300.0);
+  EXPECT_EQ(parse_csv_number("\"7.5\""), 7.5);
+  EXPECT_TRUE(std::isnan(parse_csv_number("")));
+  EXPECT_THROW(parse_csv_number("12abc"), std::invalid_argument);
+}
+
+TEST(AssetCsvReaderTest, ReadColumnsAcrossChunks)
+{
+  auto csv_stream = std::istringstream{
+   "Date,Open,\"Close\"\r\n"
+   "2024-01-01,10,11\r\n"
+   "2024-01-02,11.5,12\n"
+   "\n"
+   "1704240000,12,\n"
+   "2024-01-04,13"};
+
+  const auto [headers, columns] = read_asset_csv_columns(csv_stream, 7);
+
+  ASSERT_EQ(headers, (std::vector<std::string>{"Date", "Open", "Close"}));
+  ASSERT_EQ(columns.size(), 3);
+  ASSERT_EQ(columns[0].size(), 4);
+
+  EXPECT_EQ(columns[0][0], 1704067200.0);
+  EXPECT_EQ(columns[0][2], 1704240000.0);
+  EXPECT_EQ(columns[1][1], 11.5);
+  EXPECT_EQ(columns[2][1], 12.0);
+  EXPECT_TRUE(std::isnan(columns[2][2]));
+  EXPECT_EQ(columns[1][3], 13.0);
+  EXPECT_TRUE(std::isnan(columns[2][3]));
+}
+
+TEST(AssetCsvReaderTest, ParallelParsingKeepsRowOrder)
+{
+  auto csv = std::string{"Date,Close,Volume\n"};
+  for(auto i = 0; i < 20000; ++i) {
+    csv += std::format("{},{}.25,{}\n", 1704067200 + i * 60, i, i % 7);
+  }
+
+  auto sequential_stream = std::istringstream{csv};
+  const auto sequential =
+   read_asset_csv_columns(sequential_stream, 1uz << 24, 1);
+
+  auto parallel_stream = std::istringstream{csv};
+  const auto parallel = read_asset_csv_columns(parallel_stream, 1uz << 24, 4);
+
+  ASSERT_EQ(parallel.headers, sequential.headers);
+  ASSERT_EQ(parallel.columns, sequential.columns);
+  ASSERT_EQ(parallel.columns[0].size(), 20000);
+  EXPECT_EQ(parallel.columns[0][12345], 1704067200.0 + 12345 * 60);
+  EXPECT_EQ(parallel.columns[1][19999], 19999.25);
+}
+
+TEST(AssetCsvReaderTest, ParallelParsingAcrossChunksKeepsRowOrder)
+{
+  auto csv = std::string{"Date,Close\n"};
+  for(auto i = 0; i < 20000; ++i) {
+    csv += std::format("{},{}.5\n", 1704067200 + i * 60, i);
+  }
+
+  // Every chunk is split into parts for the same workers.
+  auto csv_stream = std::istringstream{csv};
+  const auto [headers, columns] =
+   read_asset_csv_columns(csv_stream, 1uz << 17, 4);
+
+  ASSERT_EQ(columns.size(), 2);
+  ASSERT_EQ(columns[0].size(), 20000);
+  for(auto i = 0uz; i < columns[0].size(); ++i) {
+    ASSERT_EQ(columns[0][i], 1704067200.0 + static_cast<double>(i) * 60);
+    ASSERT_EQ(columns[1][i], static_cast<double>(i) + 0.5);
+  }
+}
+
+TEST(AssetCsvReaderTest, ParallelParsingReportsErrors)
+{
+  auto csv = std::string{"Date,Close\n"};
+  for(auto i = 0; i < 20000; ++i) {
+    const auto close = i == 15000 ? "x" : "1";
+    csv += std::format("{},{}\n", 1704067200 + i * 60, close);
+  }
+
+  auto csv_stream = std::istringstream{csv};
+  EXPECT_THROW(read_asset_csv_columns(csv_stream, 1uz << 24, 4),
+               std::invalid_argument);
+}
+
+TEST(AssetCsvReaderTest, UpdateAssetFromCsv)
+{
+  auto csv_stream = std::istringstream{"Time,Open,High,Low,Close,Volume\n"
+                                       "2024-01-03,3,4,2,3.5,300\n"
+                                       "2024-01-02,2,3,1,2.5,200\n"
+                                       "2024-01-01,1,2,0,1.5,100\n"};
+
+  auto asset = Asset{"Test"};
+  update_asset_from_csv(asset, csv_stream);
+
+  ASSERT_EQ(asset.size(), 3);
+  EXPECT_EQ(asset.field_resolver().datetime_field(), "Time");
+
+  const auto asset_snapshot = asset.get_snapshot(0);
+  EXPECT_EQ(asset_snapshot.datetime(), 1704240000.0);
+  EXPECT_EQ(asset_snapshot.close(), 3.5);
+  EXPECT_EQ(asset_snapshot[2].volume(), 100.0);
+}
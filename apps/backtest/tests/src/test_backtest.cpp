@@ -0,0 +1,259 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "test_fixtures.hpp"
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+using namespace pludux::backtest::test_fixtures;
+
+namespace {
+
+/**
+ * A condition that never holds and takes a while to say so.
+ */
+struct SlowNeverMethod {
+  std::shared_ptr<std::size_t> evaluation_count{
+   std::make_shared<std::size_t>(0)};
+
+  auto operator==(const SlowNeverMethod&) const noexcept -> bool = default;
+
+  auto operator()(AssetSnapshot, MethodContextable auto) const noexcept
+   -> bool
+  {
+    ++*evaluation_count;
+    std::this_thread::sleep_for(std::chrono::microseconds{100});
+    return false;
+  }
+};
+
+/**
+ * The results collected for a series over a full run of the strategy.
+ */
+auto run_series_results(std::shared_ptr<Strategy> strategy_ptr,
+                        const std::vector<double>& closes,
+                        const std::string& series_name) -> std::vector<double>
+{
+  auto asset_ptr = make_wave_asset_ptr(closes.size());
+  auto market_ptr = std::make_shared<Market>("Test");
+  auto broker_ptr = std::make_shared<Broker>("Test");
+  auto profile_ptr =
+   std::make_shared<Profile>("Test", 0.01, Profile::RDistance::Percentage);
+
+  auto backtest = Backtest{"Test",
+                           100'000.0,
+                           asset_ptr,
+                           strategy_ptr,
+                           market_ptr,
+                           broker_ptr,
+                           profile_ptr};
+  while(backtest.should_run()) {
+    backtest.run();
+  }
+
+  const auto results =
+   backtest.series_results_collector().results(series_name);
+  if(!results) {
+    return {};
+  }
+  return std::vector<double>(results->begin(), results->end());
+}
+
+} // namespace
+
+TEST(BacktestTest, ComputeReferencedSeriesFirst)
+{
+  // "shifted" is registered before the series it reads.
+  auto config_parser = make_default_registered_config_parser();
+  auto strategy_ptr = std::make_shared<Strategy>(parse_backtest_strategy_json(
+   "Strategy",
+   jsoncons::ojson::parse(R"({
+     "version": 2,
+     "series": {
+       "shifted": {"method": "ADD", "params": {
+         "augend": {"method": "SERIES_VALUE", "params": {"name": "close"}},
+         "addend": 1
+       }},
+       "close": "CLOSE"
+     }
+   })"),
+   config_parser));
+
+  const auto closes = make_wave_closes(100);
+  const auto results = run_series_results(strategy_ptr, closes, "shifted");
+
+  ASSERT_EQ(results.size(), closes.size());
+  for(auto i = 0uz; i < closes.size(); ++i) {
+    EXPECT_DOUBLE_EQ(results[i], closes[i] + 1);
+  }
+}
+
+TEST(BacktestTest, SelfReferencingSeriesReadsItsPreviousBar)
+{
+  // The highest close so far, accumulated from the previous bar of itself.
+  auto series_registry = SeriesMethodRegistry{};
+  series_registry.set(
+   "peak",
+   AnySeriesMethod{MaxMethod<AnySeriesMethod, AnySeriesMethod>{
+    AnySeriesMethod{CloseMethod{}},
+    AnySeriesMethod{LookbackMethod<AnySeriesMethod>{
+     AnySeriesMethod{SeriesValueMethod{"peak"}}, 1}}}});
+
+  auto strategy_ptr = std::make_shared<Strategy>("Strategy",
+                                                 std::move(series_registry),
+                                                 NeverMethod{},
+                                                 NeverMethod{},
+                                                 NeverMethod{},
+                                                 NeverMethod{},
+                                                 false,
+                                                 false,
+                                                 false,
+                                                 1.0,
+                                                 std::vector<PlotGroup>{});
+
+  const auto closes = make_wave_closes(100);
+  const auto results = run_series_results(strategy_ptr, closes, "peak");
+
+  ASSERT_EQ(results.size(), closes.size());
+  auto peak = closes.front();
+  for(auto i = 0uz; i < closes.size(); ++i) {
+    peak = std::max(peak, closes[i]);
+    EXPECT_DOUBLE_EQ(results[i], peak);
+  }
+}
+
+TEST(BacktestTest, StrategyColumnOrder)
+{
+  auto config_parser = make_default_registered_config_parser();
+  const auto strategy = parse_backtest_strategy_json(
+   "Strategy",
+   jsoncons::ojson::parse(R"({
+     "version": 2,
+     "series": {
+       "count": {"method": "ADD", "params": {
+         "augend": {"method": "LOOKBACK", "params": {
+           "source": {"method": "SERIES_VALUE", "params": {"name": "count"}},
+           "period": 1
+         }},
+         "addend": 1
+       }},
+       "doubled": {"method": "MULTIPLY", "params": {
+         "multiplicand": {"method": "SERIES_VALUE", "params": {
+           "name": "count"
+         }},
+         "multiplier": 2
+       }},
+       "ma": {"method": "SMA", "params": {"period": 5}},
+       "shifted": {"method": "ADD", "params": {
+         "augend": {"method": "SERIES_VALUE", "params": {"name": "close"}},
+         "addend": 1
+       }},
+       "close": "CLOSE"
+     },
+     "positions": {
+       "long": {
+         "entry": {"signal": {"method": "GREATER_THAN", "params": {
+           "target": {"method": "SERIES_VALUE", "params": {"name": "ma"}},
+           "threshold": "CLOSE"
+         }}},
+         "exit": {"signal": {"method": "GREATER_THAN", "params": {
+           "target": {"method": "SERIES_VALUE", "params": {
+             "name": "doubled"
+           }},
+           "threshold": 10
+         }}}
+       }
+     }
+   })"),
+   config_parser);
+
+  const auto order = strategy_column_order(strategy);
+  EXPECT_EQ(order.series,
+            (std::vector<std::string>{"ma", "close", "shifted"}));
+  EXPECT_EQ(order.bar_series, (std::set<std::string>{"count", "doubled"}));
+  EXPECT_FALSE(order.is_long_entry_by_bar);
+  EXPECT_TRUE(order.is_long_exit_by_bar);
+  EXPECT_FALSE(order.is_short_entry_by_bar);
+}
+
+TEST(BacktestTest, UnknownSeriesReferenceFailsToLoad)
+{
+  auto config_parser = make_default_registered_config_parser();
+  const auto strategy_json = jsoncons::ojson::parse(R"({
+    "version": 2,
+    "series": {
+      "close": "CLOSE"
+    },
+    "positions": {
+      "long": {
+        "entry": {"signal": {"method": "GREATER_THAN", "params": {
+          "target": {"method": "SERIES_VALUE", "params": {"name": "closes"}},
+          "threshold": 10
+        }}}
+      }
+    }
+  })");
+
+  EXPECT_THROW(
+   parse_backtest_strategy_json("Strategy", strategy_json, config_parser),
+   std::runtime_error);
+}
+
+TEST(BacktestTest, FilterEvaluatedByBarSkipsCostlyClause)
+{
+  // A condition the parser cannot serialize leaves its filter to be evaluated
+  // bar by bar, where ALL_OF reorders its clauses by their measured cost.
+  const auto costly_method = SlowNeverMethod{};
+
+  auto strategy_ptr = std::make_shared<Strategy>(
+   "Strategy",
+   SeriesMethodRegistry{},
+   AllOfMethod{costly_method, NeverMethod{}},
+   NeverMethod{},
+   NeverMethod{},
+   NeverMethod{},
+   false,
+   false,
+   false,
+   1.0,
+   std::vector<PlotGroup>{});
+
+  auto asset_ptr = make_wave_asset_ptr(100);
+  auto market_ptr = std::make_shared<Market>("Test");
+  auto broker_ptr = std::make_shared<Broker>("Test");
+  auto profile_ptr =
+   std::make_shared<Profile>("Test", 0.01, Profile::RDistance::Percentage);
+
+  auto backtest = Backtest{"Test",
+                           100'000.0,
+                           asset_ptr,
+                           strategy_ptr,
+                           market_ptr,
+                           broker_ptr,
+                           profile_ptr};
+  while(backtest.should_run()) {
+    backtest.run();
+  }
+
+  const auto& condition_statistics = backtest.condition_statistics();
+  ASSERT_EQ(condition_statistics.size(), 1);
+  const auto& clause_order = condition_statistics.clause_orders().front();
+  EXPECT_GT(clause_order.evaluation_count(), 1);
+  EXPECT_EQ(clause_order.order(), (std::vector<std::size_t>{1, 0}));
+  EXPECT_EQ(*costly_method.evaluation_count, 1);
+  EXPECT_EQ(clause_order.clauses()[1].evaluation_count,
+            clause_order.evaluation_count());
+}
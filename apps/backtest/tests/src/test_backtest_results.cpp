@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <utility>
+#include <variant>
+#include <vector>
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+
+namespace {
+
+struct Bar {
+  std::time_t timestamp;
+  double price;
+  std::vector<BacktestTradeEvent> trade_events;
+  double stop_loss_trailing_price;
+};
+
+auto run_bars(const std::vector<Bar>& bars)
+ -> std::pair<BacktestResults, std::vector<BacktestSummary>>
+{
+  auto results = BacktestResults{1000.0};
+  auto summaries = std::vector<BacktestSummary>{};
+
+  for(auto i = 0uz; i < bars.size(); ++i) {
+    const auto& bar = bars[i];
+
+    auto summary = results.take_last_summary();
+    auto trade_session = std::move(summary).trade_session();
+    trade_session.market_update(bar.timestamp, bar.price, bars.size() - i - 1);
+
+    for(const auto& trade_event : bar.trade_events) {
+      if(const auto* entry = std::get_if<TradeEntry>(&trade_event.trade)) {
+        trade_session.entry_position(*entry, trade_event.fee);
+      } else {
+        trade_session.exit_position(std::get<TradeExit>(trade_event.trade),
+                                    trade_event.fee);
+      }
+    }
+    trade_session.update_stop_loss_trailing_price(
+     bar.stop_loss_trailing_price);
+
+    summary.update_to_next_summary(std::move(trade_session));
+    summaries.push_back(summary);
+    results.append(std::move(summary), bar.trade_events);
+  }
+
+  return {std::move(results), std::move(summaries)};
+}
+
+void expect_same_summary(const BacktestSummary& actual,
+                         const BacktestSummary& expected)
+{
+  EXPECT_DOUBLE_EQ(actual.capital(), expected.capital());
+  EXPECT_DOUBLE_EQ(actual.equity(), expected.equity());
+  EXPECT_DOUBLE_EQ(actual.peak_equity(), expected.peak_equity());
+  EXPECT_DOUBLE_EQ(actual.max_drawdown(), expected.max_drawdown());
+  EXPECT_EQ(actual.trade_count(), expected.trade_count());
+  EXPECT_EQ(actual.open_trade_count(), expected.open_trade_count());
+
+  const auto& actual_session = actual.trade_session();
+  const auto& expected_session = expected.trade_session();
+  EXPECT_EQ(actual_session.market_timestamp(),
+            expected_session.market_timestamp());
+  EXPECT_EQ(actual_session.market_lookback(),
+            expected_session.market_lookback());
+  ASSERT_EQ(actual_session.open_position().has_value(),
+            expected_session.open_position().has_value());
+  ASSERT_EQ(actual_session.closed_position().has_value(),
+            expected_session.closed_position().has_value());
+
+  if(expected_session.open_position()) {
+    EXPECT_DOUBLE_EQ(
+     actual_session.open_position()->stop_loss_trailing_price(),
+     expected_session.open_position()->stop_loss_trailing_price());
+  }
+  if(expected_session.closed_position()) {
+    EXPECT_DOUBLE_EQ(actual_session.closed_position()->realized_pnl(),
+                     expected_session.closed_position()->realized_pnl());
+  }
+}
+
+} // namespace
+
+TEST(BacktestResultsTest, EmptyResults)
+{
+  const auto results = BacktestResults{1000.0};
+
+  EXPECT_TRUE(results.empty());
+  EXPECT_EQ(results.size(), 0);
+  EXPECT_DOUBLE_EQ(results.initial_capital(), 1000.0);
+  EXPECT_DOUBLE_EQ(results.last_summary().capital(), 1000.0);
+}
+
+TEST(BacktestResultsTest, ReplayReproducesSummaries)
+{
+  const auto entry = TradeEntry{10.0, 100.0, 90.0, true, NAN};
+  const auto exit = TradeExit{10.0, 110.0, TradeExit::Reason::signal};
+  const auto bars = std::vector<Bar>{
+   {100, 100.0, {}, NAN},
+   {200, 100.0, {{1, entry, 1.0, NAN}}, 90.0},
+   {300, 105.0, {}, 95.0},
+   {400, 110.0, {{3, exit, 1.0, 95.0}}, NAN},
+   {500, 120.0, {{4, entry, 1.0, NAN}}, 110.0},
+  };
+
+  const auto [results, summaries] = run_bars(bars);
+
+  ASSERT_EQ(results.size(), bars.size());
+  EXPECT_EQ(results.trade_events().size(), 3);
+  EXPECT_DOUBLE_EQ(results.equities()[2], summaries[2].equity());
+  EXPECT_DOUBLE_EQ(results.capitals()[3], summaries[3].capital());
+  EXPECT_DOUBLE_EQ(results.stop_loss_trailing_prices()[2], 95.0);
+  EXPECT_TRUE(std::isnan(results.stop_loss_trailing_prices()[3]));
+
+  auto replayed_count = 0uz;
+  results.for_each_summary(
+   [&](std::size_t i, const BacktestSummary& summary) {
+     EXPECT_EQ(i, replayed_count++);
+     expect_same_summary(summary, summaries[i]);
+   });
+  EXPECT_EQ(replayed_count, bars.size());
+
+  for(auto i = 0uz; i < bars.size(); ++i) {
+    expect_same_summary(results.summary(i), summaries[i]);
+  }
+  expect_same_summary(results.last_summary(), summaries.back());
+}
+
+TEST(BacktestResultsTest, TradeRecordsFollowTheRevision)
+{
+  const auto entry = TradeEntry{10.0, 100.0, 90.0, true, NAN};
+  const auto exit = TradeExit{10.0, 110.0, TradeExit::Reason::signal};
+  auto bars = std::vector<Bar>{
+   {100, 100.0, {}, NAN},
+   {200, 100.0, {{1, entry, 1.0, NAN}}, 90.0},
+   {300, 105.0, {}, 95.0},
+  };
+
+  const auto [results, summaries] = run_bars(bars);
+  bars.push_back({400, 110.0, {{3, exit, 1.0, 95.0}}, NAN});
+  const auto [next_results, next_summaries] = run_bars(bars);
+
+  const auto expect_trade_records =
+   [](const BacktestTradeRecords& trade_records,
+      const std::vector<BacktestSummary>& summaries) {
+     auto bar_it = trade_records.bars().begin();
+     for(auto i = 0uz; i < summaries.size(); ++i) {
+       auto trade_record_count = 0uz;
+       const auto& trade_session = summaries[i].trade_session();
+       for([[maybe_unused]] const auto& trade_record :
+           trade_session.trade_record_range()) {
+         ++trade_record_count;
+       }
+       if(trade_record_count == 0) {
+         continue;
+       }
+
+       ASSERT_NE(bar_it, trade_records.bars().end());
+       EXPECT_EQ(bar_it->bar_index, i);
+       EXPECT_EQ(bar_it->trade_count, summaries[i].trade_count());
+       EXPECT_EQ(bar_it->trade_records.size(), trade_record_count);
+       ++bar_it;
+     }
+     EXPECT_EQ(bar_it, trade_records.bars().end());
+   };
+
+  auto trade_records = BacktestTradeRecords{};
+  trade_records.update(results);
+  expect_trade_records(trade_records, summaries);
+  EXPECT_FALSE(trade_records.bars().empty());
+
+  // A copy keeps the revision, and appending a bar gives a new one.
+  const auto results_copy = results;
+  EXPECT_EQ(results_copy.revision(), results.revision());
+  EXPECT_NE(next_results.revision(), results.revision());
+
+  trade_records.update(next_results);
+  expect_trade_records(trade_records, next_summaries);
+  EXPECT_EQ(trade_records.bars().back().bar_index, 3);
+}
@@ -0,0 +1,118 @@
+#ifndef PLUDUX_BACKTEST_TESTS_TEST_FIXTURES_HPP
+#define PLUDUX_BACKTEST_TESTS_TEST_FIXTURES_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+import pludux.backtest;
+
+namespace pludux::backtest::test_fixtures {
+
+/**
+ * A long strategy entering when the close crosses over its moving average
+ * `ma` and exiting when it crosses under, with a take profit at 2R.
+ */
+inline const auto sma_crossover_strategy_json_str = std::string{R"({
+  "version": 2,
+  "series": {
+    "ma": {"method": "SMA", "params": {"period": 5}}
+  },
+  "stopLoss": {"trailing": false},
+  "takeProfit": {"rMultiple": 2},
+  "positions": {
+    "long": {
+      "entry": {"signal": {
+        "method": "CROSSOVER",
+        "params": {
+          "value": "CLOSE",
+          "baseline": {"method": "SERIES_VALUE", "params": {"name": "ma"}}
+        }
+      }},
+      "exit": {"signal": {
+        "method": "CROSSUNDER",
+        "params": {
+          "value": "CLOSE",
+          "baseline": {"method": "SERIES_VALUE", "params": {"name": "ma"}}
+        }
+      }}
+    }
+  }
+})"};
+
+/**
+ * The SMA crossover strategy, parsed.
+ */
+inline auto make_sma_crossover_strategy_ptr() -> std::shared_ptr<Strategy>
+{
+  auto config_parser = make_default_registered_config_parser();
+  return std::make_shared<Strategy>(parse_backtest_strategy_json(
+   "Strategy",
+   jsoncons::ojson::parse(sma_crossover_strategy_json_str),
+   config_parser));
+}
+
+inline constexpr auto first_datetime = 1'700'000'000.0;
+inline constexpr auto day = 86'400.0;
+
+/**
+ * The closes of `bar_count` bars following two overlapping waves, shifted
+ * by `phase` bars, so moving averages cross them often.
+ */
+inline auto make_wave_closes(std::size_t bar_count, double phase = 0.0)
+ -> std::vector<double>
+{
+  auto closes = std::vector<double>{};
+  closes.reserve(bar_count);
+  for(auto i = 0uz; i < bar_count; ++i) {
+    const auto x = static_cast<double>(i) + phase;
+    closes.push_back(100.0 + 10.0 * std::sin(x / 7.0) + 3.0 * std::sin(x));
+  }
+  return closes;
+}
+
+/**
+ * An asset of `bar_count` bars closing at the wave closes, with opens half
+ * a point lower and highs and lows a point away. The first bar is
+ * `first_day` days after `first_datetime` and the next ones follow every
+ * `day_step` days.
+ */
+inline auto make_wave_asset_ptr(std::size_t bar_count = 300,
+                                std::string name = "Test",
+                                std::size_t first_day = 0,
+                                std::size_t day_step = 1,
+                                double phase = 0.0) -> std::shared_ptr<Asset>
+{
+  auto datetimes = std::vector<double>{};
+  auto opens = std::vector<double>{};
+  auto highs = std::vector<double>{};
+  auto lows = std::vector<double>{};
+  auto closes = make_wave_closes(bar_count, phase);
+
+  for(auto i = 0uz; i < bar_count; ++i) {
+    const auto bar_day = static_cast<double>(first_day + i * day_step);
+    datetimes.push_back(first_datetime + bar_day * day);
+    opens.push_back(closes[i] - 0.5);
+    highs.push_back(closes[i] + 1.0);
+    lows.push_back(closes[i] - 1.0);
+  }
+
+  auto field_data = std::vector<std::pair<std::string, AssetData>>{};
+  field_data.emplace_back("Datetime", AssetData{std::move(datetimes)});
+  field_data.emplace_back("Open", AssetData{std::move(opens)});
+  field_data.emplace_back("High", AssetData{std::move(highs)});
+  field_data.emplace_back("Low", AssetData{std::move(lows)});
+  field_data.emplace_back("Close", AssetData{std::move(closes)});
+
+  return std::make_shared<Asset>(
+   std::move(name), AssetHistory{field_data.begin(), field_data.end()});
+}
+
+} // namespace pludux::backtest::test_fixtures
+
+#endif
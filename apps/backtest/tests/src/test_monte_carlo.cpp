@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "test_fixtures.hpp"
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+using namespace pludux::backtest::test_fixtures;
+
+TEST(MonteCarloTest, ShuffleKeepsTheTotalProfit)
+{
+  auto monte_carlo = MonteCarlo{{100, -50, 30, -20, 60}, 1000};
+  monte_carlo.iteration_count(5000);
+
+  const auto result = monte_carlo.run(2);
+  ASSERT_EQ(result.total_profits.size(), 5000);
+  EXPECT_EQ(result.total_profits.front(), 120);
+  EXPECT_EQ(result.total_profits.back(), 120);
+  EXPECT_EQ(result.loss_probability(), 0);
+
+  // Both losses right after the start draw down 7% of the initial capital,
+  // and no order draws down more.
+  EXPECT_GT(result.max_drawdowns.front(), 0);
+  EXPECT_DOUBLE_EQ(result.max_drawdowns.back(), 7);
+  EXPECT_LE(result.drawdown_percentile(5), result.drawdown_percentile(95));
+}
+
+TEST(MonteCarloTest, ThreadCountDoesNotChangeResults)
+{
+  auto monte_carlo = MonteCarlo{{100, -50, 30, -20, 60, -70, 40}, 1000};
+  monte_carlo.iteration_count(3000);
+  monte_carlo.skip_rate(0.2);
+  monte_carlo.seed(42);
+
+  const auto serial_result = monte_carlo.run(1);
+  const auto parallel_result = monte_carlo.run(4);
+  EXPECT_EQ(serial_result.total_profits, parallel_result.total_profits);
+  EXPECT_EQ(serial_result.max_drawdowns, parallel_result.max_drawdowns);
+
+  monte_carlo.seed(43);
+  EXPECT_NE(monte_carlo.run(4).max_drawdowns, serial_result.max_drawdowns);
+}
+
+TEST(MonteCarloTest, ResampleTrades)
+{
+  auto monte_carlo =
+   MonteCarlo{{10, -10, 10, -10, 10, -10, 10, -10, 10, -10}, 1000};
+  monte_carlo.sampling(MonteCarlo::Sampling::Resample);
+  monte_carlo.iteration_count(20'000);
+
+  // Fewer than five of the ten drawn trades win with a probability of 37.7%.
+  const auto result = monte_carlo.run();
+  EXPECT_NEAR(result.loss_probability(), 0.377, 0.02);
+  EXPECT_EQ(result.profit_percentile(50), 0);
+  EXPECT_EQ(result.total_profits.front(), -100);
+
+  monte_carlo.skip_rate(1);
+  const auto skipped_result = monte_carlo.run();
+  EXPECT_EQ(skipped_result.total_profits.front(), 0);
+  EXPECT_EQ(skipped_result.total_profits.back(), 0);
+  EXPECT_EQ(skipped_result.max_drawdowns.back(), 0);
+}
+
+TEST(MonteCarloTest, SortedPercentile)
+{
+  const auto values = std::vector<double>{1, 2, 3, 4, 5};
+
+  EXPECT_EQ(sorted_percentile(values, 0), 1);
+  EXPECT_EQ(sorted_percentile(values, 50), 3);
+  EXPECT_EQ(sorted_percentile(values, 100), 5);
+  EXPECT_EQ(sorted_percentile(values, 37.5), 2.5);
+  EXPECT_TRUE(std::isnan(sorted_percentile({}, 50)));
+}
+
+TEST(MonteCarloTest, ClosedTradePnls)
+{
+  auto asset_ptr = make_wave_asset_ptr(200);
+  auto strategy_ptr = make_sma_crossover_strategy_ptr();
+  auto market_ptr = std::make_shared<Market>("Test");
+  auto broker_ptr = std::make_shared<Broker>("Test");
+  auto profile_ptr =
+   std::make_shared<Profile>("Test", 0.01, Profile::RDistance::Percentage);
+
+  auto backtest = Backtest{"Test",
+                           100'000.0,
+                           asset_ptr,
+                           strategy_ptr,
+                           market_ptr,
+                           broker_ptr,
+                           profile_ptr};
+  while(backtest.should_run()) {
+    backtest.run();
+  }
+
+  const auto& summary = backtest.results().last_summary();
+  const auto pnls = closed_trade_pnls(backtest.results());
+  ASSERT_EQ(pnls.size(), summary.trade_count());
+  ASSERT_FALSE(pnls.empty());
+
+  auto total_pnl = 0.0;
+  for(const auto pnl : pnls) {
+    total_pnl += pnl;
+  }
+  EXPECT_NEAR(total_pnl, summary.cumulative_pnls(), 1e-6);
+}
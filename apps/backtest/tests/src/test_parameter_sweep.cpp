@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "test_fixtures.hpp"
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+using namespace pludux::backtest::test_fixtures;
+
+namespace {
+
+auto make_profile() -> Profile
+{
+  return Profile{"Test", 0.01, Profile::RDistance::Percentage};
+}
+
+auto make_sweep(std::vector<SweepParameter> parameters) -> ParameterSweep
+{
+  return ParameterSweep{jsoncons::ojson::parse(sma_crossover_strategy_json_str),
+                        make_profile(),
+                        make_wave_asset_ptr(),
+                        std::make_shared<Market>("Test"),
+                        std::make_shared<Broker>("Test"),
+                        100'000.0,
+                        std::move(parameters)};
+}
+
+} // namespace
+
+TEST(ParameterSweepTest, VariantsCoverTheGrid)
+{
+  const auto sweep =
+   make_sweep({{"/strategy/series/ma/params/period", {3, 5, 8}},
+               {"/strategy/takeProfit/rMultiple", {1, 2}}});
+
+  EXPECT_EQ(sweep.variant_count(), 6);
+  EXPECT_EQ(sweep.variant_values(0), (std::vector<double>{3, 1}));
+  EXPECT_EQ(sweep.variant_values(1), (std::vector<double>{3, 2}));
+  EXPECT_EQ(sweep.variant_values(4), (std::vector<double>{8, 1}));
+  EXPECT_EQ(sweep.variant_values(5), (std::vector<double>{8, 2}));
+}
+
+TEST(ParameterSweepTest, ApplyParameters)
+{
+  auto strategy_json = jsoncons::ojson::parse(sma_crossover_strategy_json_str);
+  auto profile = make_profile();
+
+  apply_sweep_parameter(
+   strategy_json, profile, "/strategy/series/ma/params/period", 8);
+  apply_sweep_parameter(
+   strategy_json, profile, "/strategy/takeProfit/rMultiple", 1.5);
+  apply_sweep_parameter(strategy_json, profile, "/profile/capitalRisk", 0.02);
+  apply_sweep_parameter(strategy_json, profile, "/profile/atrPeriod", 21);
+  apply_sweep_parameter(strategy_json, profile, "/profile/atrMultiplier", 3);
+
+  const auto& period =
+   strategy_json.at("series").at("ma").at("params").at("period");
+  EXPECT_TRUE(period.is_int64());
+  EXPECT_EQ(period.as<int>(), 8);
+  EXPECT_EQ(strategy_json.at("takeProfit").at("rMultiple").as<double>(), 1.5);
+  EXPECT_EQ(profile.capital_risk(), 0.02);
+  EXPECT_EQ(profile.r_mode_atr().first, 21);
+  EXPECT_EQ(profile.r_mode_atr().second, 3.0);
+
+  EXPECT_THROW(apply_sweep_parameter(
+                strategy_json, profile, "/strategy/series/missing/period", 1),
+               std::runtime_error);
+  EXPECT_THROW(
+   apply_sweep_parameter(strategy_json, profile, "/profile/unknown", 1),
+   std::runtime_error);
+  EXPECT_THROW(
+   apply_sweep_parameter(strategy_json, profile, "/market/step", 1),
+   std::runtime_error);
+}
+
+TEST(ParameterSweepTest, ParseRanges)
+{
+  const auto sweep_json = jsoncons::ojson::parse(R"({"parameters": [
+    {"path": "/strategy/series/ma/params/period", "values": [3, 5]},
+    {"path": "/profile/capitalRisk", "from": 0.01, "to": 0.02, "step": 0.0025}
+  ]})");
+
+  const auto parameters = parse_parameter_sweep_json(sweep_json);
+  ASSERT_EQ(parameters.size(), 2);
+  EXPECT_EQ(parameters[0].values, (std::vector<double>{3, 5}));
+  ASSERT_EQ(parameters[1].values.size(), 5);
+  EXPECT_DOUBLE_EQ(parameters[1].values.back(), 0.02);
+}
+
+TEST(ParameterSweepTest, ResultsMatchSingleBacktests)
+{
+  const auto sweep =
+   make_sweep({{"/strategy/series/ma/params/period", {3, 5, 8, 13}},
+               {"/strategy/takeProfit/rMultiple", {1, 2, 3}},
+               {"/profile/capitalRisk", {0.01, 0.02}}});
+
+  auto streamed_count = 0uz;
+  const auto results =
+   sweep.run(4, [&](const SweepResult&) { ++streamed_count; });
+  ASSERT_EQ(results.size(), sweep.variant_count());
+  EXPECT_EQ(streamed_count, results.size());
+
+  auto asset_ptr = make_wave_asset_ptr();
+  auto market_ptr = std::make_shared<Market>("Test");
+  auto broker_ptr = std::make_shared<Broker>("Test");
+
+  for(auto i = 0uz; i < results.size(); ++i) {
+    const auto& result = results[i];
+    ASSERT_FALSE(result.is_failed()) << result.error;
+    if(i > 0) {
+      EXPECT_GE(results[i - 1].total_profit, result.total_profit);
+    }
+
+    auto [strategy_json, profile] = sweep.variant_rules(result.variant_index);
+    auto config_parser = make_default_registered_config_parser();
+    auto strategy_ptr = std::make_shared<Strategy>(
+     parse_backtest_strategy_json("Strategy", strategy_json, config_parser));
+    auto profile_ptr = std::make_shared<Profile>(profile);
+
+    auto backtest = Backtest{"Single",
+                             100'000.0,
+                             asset_ptr,
+                             strategy_ptr,
+                             market_ptr,
+                             broker_ptr,
+                             profile_ptr};
+    while(backtest.should_run()) {
+      backtest.run();
+    }
+
+    const auto& summary = backtest.results().last_summary();
+    EXPECT_EQ(result.total_profit, summary.cumulative_pnls());
+    EXPECT_EQ(result.trade_count, summary.trade_count());
+    EXPECT_EQ(result.values, sweep.variant_values(result.variant_index));
+  }
+}
+
+TEST(ParameterSweepTest, ThreadCountDoesNotChangeResults)
+{
+  const auto sweep =
+   make_sweep({{"/strategy/series/ma/params/period", {3, 5, 8, 13, 21}},
+               {"/strategy/takeProfit/rMultiple", {1, 2}}});
+
+  const auto serial_results = sweep.run(1);
+  const auto parallel_results = sweep.run(3);
+  ASSERT_EQ(serial_results.size(), parallel_results.size());
+
+  for(auto i = 0uz; i < serial_results.size(); ++i) {
+    EXPECT_EQ(serial_results[i].variant_index,
+              parallel_results[i].variant_index);
+    EXPECT_EQ(serial_results[i].total_profit,
+              parallel_results[i].total_profit);
+  }
+}
+
+TEST(ParameterSweepTest, RejectInvalidPathBeforeRunning)
+{
+  const auto sweep = make_sweep({{"/strategy/serie/ma/params/period", {1, 2}}});
+
+  EXPECT_THROW(sweep.run(2), std::runtime_error);
+}
+
+TEST(ParameterSweepTest, TradeManagementVariantsShareColumns)
+{
+  const auto sweep = make_sweep({{"/strategy/takeProfit/rMultiple", {1, 2, 3}},
+                                 {"/profile/capitalRisk", {0.01, 0.02}}});
+
+  const auto results = sweep.run(3);
+  ASSERT_EQ(results.size(), 6);
+
+  // One SMA, the crossover and crossunder filters, and the never filter
+  // shared by both short filters.
+  EXPECT_EQ(sweep.column_cache().series_column_count(), 1);
+  EXPECT_EQ(sweep.column_cache().condition_column_count(), 3);
+}
+
+TEST(ParameterSweepTest, IndicatorVariantsKeepTheirOwnColumns)
+{
+  const auto sweep =
+   make_sweep({{"/strategy/series/ma/params/period", {3, 5}},
+               {"/strategy/takeProfit/rMultiple", {1, 2}}});
+
+  sweep.run(2);
+
+  // The filters read the SMA, so every period has filters of its own, while
+  // the never filter does not depend on it.
+  EXPECT_EQ(sweep.column_cache().series_column_count(), 2);
+  EXPECT_EQ(sweep.column_cache().condition_column_count(), 5);
+}
+
+TEST(ColumnCacheTest, ComputeEachKeyOnce)
+{
+  auto column_cache = ColumnCache{};
+  auto compute_count = 0uz;
+  const auto compute = [&] {
+    ++compute_count;
+    return std::vector<double>{1, 2, 3};
+  };
+
+  EXPECT_EQ(column_cache.series_column("a", compute),
+            (std::vector<double>{1, 2, 3}));
+  EXPECT_EQ(column_cache.series_column("a", compute),
+            (std::vector<double>{1, 2, 3}));
+  EXPECT_EQ(compute_count, 1);
+
+  column_cache.series_column("b", compute);
+  EXPECT_EQ(compute_count, 2);
+  EXPECT_EQ(column_cache.series_column_count(), 2);
+
+  column_cache.clear();
+  EXPECT_EQ(column_cache.series_column_count(), 0);
+}
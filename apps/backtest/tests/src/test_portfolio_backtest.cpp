@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "test_fixtures.hpp"
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+using namespace pludux::backtest::test_fixtures;
+
+namespace {
+
+auto make_portfolio_backtest() -> PortfolioBacktest
+{
+  auto strategy_ptr = make_sma_crossover_strategy_ptr();
+
+  // The second asset starts later and trades every other day, and the third
+  // one stops early.
+  return PortfolioBacktest{
+   "Portfolio",
+   100'000.0,
+   {make_wave_asset_ptr(200, "A", 0, 1, 0.0),
+    make_wave_asset_ptr(100, "B", 51, 2, 3.0),
+    make_wave_asset_ptr(120, "C", 10, 1, 5.0)},
+   std::move(strategy_ptr),
+   std::make_shared<Market>("Test"),
+   std::make_shared<Broker>("Test"),
+   std::make_shared<Profile>("Test", 0.01, Profile::RDistance::Percentage)};
+}
+
+} // namespace
+
+TEST(PortfolioBacktestTest, MergeTheTimelines)
+{
+  auto portfolio_backtest = make_portfolio_backtest();
+  portfolio_backtest.run(2);
+
+  // A has days 0 to 199 and B has the odd days 51 to 249, so the steps are
+  // days 0 to 199 and the odd days 201 to 249.
+  const auto& timestamps = portfolio_backtest.timestamps();
+  ASSERT_EQ(timestamps.size(), 225);
+  EXPECT_EQ(timestamps.front(), static_cast<std::time_t>(first_datetime));
+  EXPECT_EQ(timestamps[200],
+            static_cast<std::time_t>(first_datetime + 201 * day));
+  for(auto i = 1uz; i < timestamps.size(); ++i) {
+    EXPECT_LT(timestamps[i - 1], timestamps[i]);
+  }
+
+  const auto& backtests = portfolio_backtest.backtests();
+  ASSERT_EQ(backtests.size(), 3);
+  EXPECT_EQ(backtests[0]->results().size(), 200);
+  EXPECT_EQ(backtests[1]->results().size(), 100);
+  EXPECT_EQ(backtests[2]->results().size(), 120);
+  EXPECT_EQ(portfolio_backtest.equities().size(), timestamps.size());
+}
+
+TEST(PortfolioBacktestTest, ShareTheCapital)
+{
+  auto portfolio_backtest = make_portfolio_backtest();
+  portfolio_backtest.run(3);
+
+  auto total_pnl = 0.0;
+  auto trade_count = 0uz;
+  for(const auto& backtest : portfolio_backtest.backtests()) {
+    const auto& summary = backtest->results().last_summary();
+    total_pnl += summary.cumulative_pnls();
+    trade_count += summary.trade_count();
+  }
+
+  ASSERT_GT(trade_count, 0);
+  EXPECT_NEAR(portfolio_backtest.capital(), 100'000.0 + total_pnl, 1e-6);
+  EXPECT_EQ(portfolio_backtest.capitals().back(), portfolio_backtest.capital());
+}
+
+TEST(PortfolioBacktestTest, RiskTheCapitalAtTheStep)
+{
+  auto portfolio_backtest = make_portfolio_backtest();
+  portfolio_backtest.run(2);
+
+  // A has a bar at every step, so its bars are the steps.
+  const auto& capitals = portfolio_backtest.capitals();
+  const auto& backtest = *portfolio_backtest.backtests()[0];
+
+  auto entry_count = 0uz;
+  for(const auto& trade_event : backtest.results().trade_events()) {
+    const auto* entry = std::get_if<TradeEntry>(&trade_event.trade);
+    if(!entry) {
+      continue;
+    }
+
+    // Every entry risks 1% of the capital at the start of its step on a stop
+    // 10% away from the entry price, in whole units.
+    const auto step = trade_event.bar_index;
+    const auto capital = step == 0 ? 100'000.0 : capitals[step - 1];
+    EXPECT_EQ(entry->position_size(),
+              std::round(capital * 0.01 / (entry->price() * 0.1)));
+    ++entry_count;
+  }
+  EXPECT_GT(entry_count, 1);
+}
+
+TEST(PortfolioBacktestTest, ThreadCountDoesNotChangeResults)
+{
+  auto serial_backtest = make_portfolio_backtest();
+  serial_backtest.run(1);
+  auto parallel_backtest = make_portfolio_backtest();
+  parallel_backtest.run(4);
+
+  EXPECT_EQ(serial_backtest.timestamps(), parallel_backtest.timestamps());
+  EXPECT_EQ(serial_backtest.capitals(), parallel_backtest.capitals());
+  EXPECT_EQ(serial_backtest.equities(), parallel_backtest.equities());
+}
+
+TEST(PortfolioBacktestTest, MissingAssetFailsTheRun)
+{
+  auto strategy_ptr = make_sma_crossover_strategy_ptr();
+
+  auto portfolio_backtest = PortfolioBacktest{
+   "Portfolio",
+   100'000.0,
+   {make_wave_asset_ptr(200, "A", 0, 1, 0.0), nullptr},
+   std::move(strategy_ptr),
+   std::make_shared<Market>("Test"),
+   std::make_shared<Broker>("Test"),
+   std::make_shared<Profile>("Test", 0.01, Profile::RDistance::Percentage)};
+
+  EXPECT_THROW(portfolio_backtest.run(2), std::runtime_error);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <jsoncons/json.hpp>
+
+#include "test_fixtures.hpp"
+
+import pludux.backtest;
+
+using namespace pludux;
+using namespace pludux::backtest;
+using namespace pludux::backtest::test_fixtures;
+
+namespace {
+
+auto make_walk_forward(std::size_t train_bar_count,
+                       std::size_t test_bar_count) -> WalkForward
+{
+  return WalkForward{
+   jsoncons::ojson::parse(sma_crossover_strategy_json_str),
+   Profile{"Test", 0.01, Profile::RDistance::Percentage},
+   make_wave_asset_ptr(),
+   std::make_shared<Market>("Test"),
+   std::make_shared<Broker>("Test"),
+   100'000.0,
+   {{"/strategy/series/ma/params/period", {3, 5, 8, 13}},
+    {"/strategy/takeProfit/rMultiple", {1, 2}}},
+   train_bar_count,
+   test_bar_count};
+}
+
+} // namespace
+
+TEST(WalkForwardTest, WindowsCoverTheHistory)
+{
+  auto walk_forward = make_walk_forward(100, 80);
+
+  const auto windows = walk_forward.windows();
+  ASSERT_EQ(windows.size(), 3);
+  EXPECT_EQ(windows[0].train_begin, 0);
+  EXPECT_EQ(windows[0].test_begin, 100);
+  EXPECT_EQ(windows[1].train_begin, 80);
+  EXPECT_EQ(windows[1].train_end, 180);
+  EXPECT_EQ(windows[1].test_end, 260);
+  EXPECT_EQ(windows[2].test_begin, 260);
+  EXPECT_EQ(windows[2].test_end, 300);
+
+  walk_forward.is_anchored(true);
+  for(const auto& window : walk_forward.windows()) {
+    EXPECT_EQ(window.train_begin, 0);
+    EXPECT_EQ(window.train_end, window.test_begin);
+  }
+}
+
+TEST(WalkForwardTest, StitchTestEquities)
+{
+  auto walk_forward = make_walk_forward(100, 50);
+  walk_forward.warmup_bar_count(20);
+
+  auto tested_count = 0uz;
+  const auto result =
+   walk_forward.run(2, [&](const WalkForwardWindow&) { ++tested_count; });
+  ASSERT_EQ(result.windows.size(), 4);
+  EXPECT_EQ(tested_count, 4);
+  ASSERT_EQ(result.equities.size(), 200);
+
+  auto total_profit = 0.0;
+  auto bar_index = 0uz;
+  for(const auto& window : result.windows) {
+    ASSERT_FALSE(window.is_failed()) << window.error;
+    ASSERT_EQ(window.values.size(), 2);
+    ASSERT_EQ(window.test_equities.size(), 50);
+    EXPECT_DOUBLE_EQ(window.test_equities.back() - 100'000.0,
+                     window.test_profit);
+
+    for(const auto equity : window.test_equities) {
+      EXPECT_DOUBLE_EQ(result.equities[bar_index++], total_profit + equity);
+    }
+    total_profit += window.test_profit;
+  }
+  EXPECT_DOUBLE_EQ(result.total_profit, total_profit);
+}
+
+TEST(WalkForwardTest, WarmupBarsAreNotTraded)
+{
+  auto asset_ptr = make_wave_asset_ptr();
+  auto strategy_ptr = make_sma_crossover_strategy_ptr();
+
+  auto market_ptr = std::make_shared<Market>("Test");
+  auto broker_ptr = std::make_shared<Broker>("Test");
+  auto profile_ptr =
+   std::make_shared<Profile>("Test", 0.01, Profile::RDistance::Percentage);
+
+  auto backtest = Backtest{"Warmup",
+                           100'000.0,
+                           asset_ptr,
+                           strategy_ptr,
+                           market_ptr,
+                           broker_ptr,
+                           profile_ptr};
+  backtest.warmup_bar_count(150);
+  while(backtest.should_run()) {
+    backtest.run();
+  }
+
+  const auto& results = backtest.results();
+  ASSERT_EQ(results.size(), 300);
+  ASSERT_FALSE(results.trade_events().empty());
+  EXPECT_GE(results.trade_events().front().bar_index, 150);
+  EXPECT_EQ(results.equities()[149], 100'000.0);
+}
@@ -0,0 +1,151 @@
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+import pludux;
+
+namespace {
+
+/**
+ * The context wrapper used before the non-owning method context, kept to
+ * compare against. Every call copies the wrapped context out of the any.
+ */
+class LegacyAnySeriesMethodContext {
+public:
+  template<typename UImpl>
+  LegacyAnySeriesMethodContext(UImpl impl)
+  : impl_{std::move(impl)}
+  , get_series_result_{[](const std::any& impl,
+                          const std::string& name,
+                          std::size_t result_index) -> double {
+    return std::any_cast<UImpl>(impl).get_series_result(name, result_index);
+  }}
+  , get_index_func_{[](const std::any& impl) -> std::size_t {
+    return std::any_cast<UImpl>(impl).index();
+  }}
+  {
+  }
+
+  auto get_series_result(this const LegacyAnySeriesMethodContext& self,
+                         const std::string& name,
+                         std::size_t result_index) -> double
+  {
+    return self.get_series_result_(self.impl_, name, result_index);
+  }
+
+  auto index(this const LegacyAnySeriesMethodContext& self) -> std::size_t
+  {
+    return self.get_index_func_(self.impl_);
+  }
+
+private:
+  std::any impl_;
+
+  std::function<auto(const std::any&, const std::string&, std::size_t)->double>
+   get_series_result_;
+
+  std::function<auto(const std::any&)->std::size_t> get_index_func_;
+};
+
+/**
+ * A nested method call: the context is wrapped again at every level.
+ */
+template<typename TAnyContext>
+auto dispatch(const pludux::DefaultMethodContext& context,
+              const std::string& name,
+              std::size_t index) -> double
+{
+  const auto any_context = TAnyContext{context};
+  return any_context.get_series_result(name, index) +
+         static_cast<double>(any_context.index());
+}
+
+template<typename TFunction>
+auto time_calls(std::size_t call_count, TFunction function)
+ -> std::pair<double, double>
+{
+  auto checksum = 0.0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for(auto i = 0uz; i < call_count; ++i) {
+    checksum += function(i);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  return {std::chrono::duration<double, std::nano>(elapsed).count() /
+           static_cast<double>(call_count),
+          checksum};
+}
+
+} // namespace
+
+auto main(int argc, const char** argv) -> int
+{
+  const auto bar_count =
+   argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : 100'000uz;
+
+  auto closes = std::vector<double>{};
+  closes.reserve(bar_count);
+  for(auto i = 0uz; i < bar_count; ++i) {
+    closes.push_back(1000.0 + static_cast<double>(i % 97) * 0.5);
+  }
+
+  auto field_data = std::vector<std::pair<std::string, pludux::AssetData>>{};
+  field_data.emplace_back("Close", pludux::AssetData{closes});
+  const auto asset_history =
+   pludux::AssetHistory{field_data.begin(), field_data.end()};
+  const auto asset_snapshot = pludux::AssetSnapshot{asset_history};
+
+  auto registry = pludux::SeriesMethodRegistry{};
+  registry.set("close", pludux::CloseMethod{});
+  registry.set("rsi",
+               pludux::RsiMethod<pludux::AnySeriesMethod>{
+                pludux::SeriesNodeMethod{"close"}, 14});
+
+  auto results_collector = pludux::SeriesResultsCollector{};
+  results_collector.collect("close", 0.0);
+  const auto context =
+   pludux::DefaultMethodContext{registry, results_collector};
+
+  const auto series_name = std::string{"close"};
+  const auto [legacy_ns, legacy_checksum] = time_calls(
+   bar_count * 10, [&](std::size_t i) {
+     return dispatch<LegacyAnySeriesMethodContext>(context, series_name, i & 1);
+   });
+  const auto [current_ns, current_checksum] = time_calls(
+   bar_count * 10, [&](std::size_t i) {
+     return dispatch<pludux::AnySeriesMethodContext>(
+      context, series_name, i & 1);
+   });
+
+  const auto rsi_name = std::string{"rsi"};
+  const auto [rsi_ns, rsi_checksum] =
+   time_calls(bar_count, [&](std::size_t i) {
+     return context.call_series_method(rsi_name, asset_snapshot[i]);
+   });
+
+  if(legacy_checksum != current_checksum) {
+    std::cerr << "Context dispatch results differ" << std::endl;
+    return 1;
+  }
+
+  const auto print_result = [](std::string_view name, double nanoseconds) {
+    std::cout << std::format("{:<20} {:.1f} ns/call\n", name, nanoseconds);
+  };
+
+  std::cout << std::format("bars: {}, rsi checksum: {:.3f}\n",
+                           bar_count,
+                           rsi_checksum);
+  print_result("legacy dispatch:", legacy_ns);
+  print_result("context dispatch:", current_ns);
+  print_result("rsi(14) per bar:", rsi_ns);
+
+  return 0;
+}
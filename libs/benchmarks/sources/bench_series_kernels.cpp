@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+import pludux;
+
+namespace {
+
+/**
+ * The loop the column methods ran before the kernels, kept to compare
+ * against. The operands may alias the results, so the compiler checks them
+ * at run time or keeps the loop scalar.
+ */
+template<typename TBinaryFn>
+[[gnu::noinline]] void scalar_transform(std::span<const double> lhs,
+                                        std::span<const double> rhs,
+                                        TBinaryFn binary_fn,
+                                        std::span<double> results)
+{
+  for(auto i = 0uz; i < results.size(); ++i) {
+    results[i] = binary_fn(lhs[i], rhs[i]);
+  }
+}
+
+template<typename TComparator>
+[[gnu::noinline]] void scalar_compare(std::span<const double> lhs,
+                                      std::span<const double> rhs,
+                                      TComparator comparator,
+                                      std::span<std::uint64_t> words)
+{
+  std::ranges::fill(words, 0);
+  for(auto i = 0uz; i < lhs.size(); ++i) {
+    words[i / 64] |= std::uint64_t{comparator(lhs[i], rhs[i])} << (i % 64);
+  }
+}
+
+/**
+ * The average time of one run of `function` over the whole column in
+ * nanoseconds per bar.
+ */
+template<typename TFunction>
+auto time_runs(std::size_t run_count, std::size_t bar_count, TFunction function)
+ -> double
+{
+  const auto start = std::chrono::steady_clock::now();
+  for(auto i = 0uz; i < run_count; ++i) {
+    function();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  return std::chrono::duration<double, std::nano>(elapsed).count() /
+         static_cast<double>(run_count * bar_count);
+}
+
+auto checksum(std::span<const double> values) -> double
+{
+  auto result = 0.0;
+  for(const auto value : values) {
+    result += std::isfinite(value) ? value : 0.0;
+  }
+  return result;
+}
+
+} // namespace
+
+auto main(int argc, const char** argv) -> int
+{
+  const auto bar_count =
+   argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : 100'000uz;
+  const auto run_count = argc > 2
+                          ? static_cast<std::size_t>(std::stoull(argv[2]))
+                          : 200uz;
+
+  auto lhs = std::vector<double>{};
+  auto rhs = std::vector<double>{};
+  lhs.reserve(bar_count);
+  rhs.reserve(bar_count);
+  for(auto i = 0uz; i < bar_count; ++i) {
+    lhs.push_back(1000.0 + static_cast<double>(i % 97) * 0.5);
+    rhs.push_back(1000.0 + static_cast<double>(i % 89) * 0.5);
+  }
+
+  auto scalar_results = std::vector<double>(bar_count);
+  auto kernel_results = std::vector<double>(bar_count);
+  auto scalar_words = std::vector<std::uint64_t>((bar_count + 63) / 64);
+  auto kernel_words = std::vector<std::uint64_t>((bar_count + 63) / 64);
+
+  auto is_same = true;
+  const auto print_result = [&](std::string_view name,
+                                double scalar_ns,
+                                double kernel_ns) {
+    std::cout << std::format("{:<16} {:>7.3f} {:>7.3f} ns/bar {:>6.2f}x "
+                             "{:>8.1f} Mbar/s\n",
+                             name,
+                             scalar_ns,
+                             kernel_ns,
+                             scalar_ns / kernel_ns,
+                             1000.0 / kernel_ns);
+  };
+
+  const auto bench_binary = [&](std::string_view name, auto binary_fn) {
+    const auto scalar_ns = time_runs(run_count, bar_count, [&] {
+      scalar_transform(lhs, rhs, binary_fn, scalar_results);
+    });
+    const auto kernel_ns = time_runs(run_count, bar_count, [&] {
+      pludux::transform_columns(lhs, rhs, binary_fn, kernel_results);
+    });
+
+    is_same = is_same && checksum(scalar_results) == checksum(kernel_results);
+    print_result(name, scalar_ns, kernel_ns);
+  };
+
+  const auto bench_compare = [&](std::string_view name, auto comparator) {
+    const auto scalar_ns = time_runs(run_count, bar_count, [&] {
+      scalar_compare(lhs, rhs, comparator, scalar_words);
+    });
+    const auto kernel_ns = time_runs(run_count, bar_count, [&] {
+      pludux::compare_columns(lhs, rhs, comparator, kernel_words);
+    });
+
+    is_same = is_same && scalar_words == kernel_words;
+    print_result(name, scalar_ns, kernel_ns);
+  };
+
+  std::cout << std::format("bars: {}, runs: {}\n", bar_count, run_count);
+  std::cout << std::format(
+   "{:<16} {:>7} {:>7}\n", "kernel", "scalar", "column");
+
+  bench_binary("add", std::plus<>{});
+  bench_binary("sub", std::minus<>{});
+  bench_binary("mul", std::multiplies<>{});
+  bench_binary("div", std::divides<>{});
+
+  {
+    const auto scalar_ns = time_runs(run_count, bar_count, [&] {
+      scalar_transform(
+       lhs, lhs, [](double value, double) { return -value; }, scalar_results);
+    });
+    const auto kernel_ns = time_runs(run_count, bar_count, [&] {
+      pludux::transform_column(lhs, std::negate<>{}, kernel_results);
+    });
+    is_same = is_same && checksum(scalar_results) == checksum(kernel_results);
+    print_result("neg", scalar_ns, kernel_ns);
+  }
+
+  {
+    const auto scalar_ns = time_runs(run_count, bar_count, [&] {
+      scalar_transform(
+       lhs,
+       lhs,
+       [](double value, double) { return std::abs(value); },
+       scalar_results);
+    });
+    const auto kernel_ns = time_runs(run_count, bar_count, [&] {
+      pludux::abs_column(lhs, kernel_results);
+    });
+    is_same = is_same && checksum(scalar_results) == checksum(kernel_results);
+    print_result("abs", scalar_ns, kernel_ns);
+  }
+
+  {
+    const auto scalar_ns = time_runs(run_count, bar_count, [&] {
+      scalar_transform(
+       lhs,
+       lhs,
+       [](double value, double) { return value * 0.25; },
+       scalar_results);
+    });
+    const auto kernel_ns = time_runs(run_count, bar_count, [&] {
+      pludux::scale_column(lhs, 0.25, kernel_results);
+    });
+    is_same = is_same && checksum(scalar_results) == checksum(kernel_results);
+    print_result("scale", scalar_ns, kernel_ns);
+  }
+
+  {
+    const auto scalar_ns = time_runs(run_count, bar_count, [&] {
+      scalar_transform(
+       lhs,
+       rhs,
+       [](double value, double base) { return 100 * (value - base) / base; },
+       scalar_results);
+    });
+    const auto kernel_ns = time_runs(run_count, bar_count, [&] {
+      pludux::percent_change_columns(lhs, rhs, kernel_results);
+    });
+    is_same = is_same && checksum(scalar_results) == checksum(kernel_results);
+    print_result("percent change", scalar_ns, kernel_ns);
+  }
+
+  bench_compare("greater", std::greater<>{});
+  bench_compare("less equal", std::less_equal<>{});
+  bench_compare("equal", std::equal_to<>{});
+
+  if(!is_same) {
+    std::cerr << "Kernel results differ from the scalar loop" << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -1,26 +1,27 @@
 module;
 
-#include <any>
-#include <functional>
+#include <concepts>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <string>
 #include <type_traits>
 
-#include <any>
-#include <functional>
-#include <memory>
-#include <type_traits>
-#include <variant>
-#include <vector>
-
 export module pludux:any_method_context;
 
 import :asset_snapshot;
 import :series_output;
+import :indicator_cache;
+import :condition_statistics;
 
 export namespace pludux {
 
+/**
+ * A non-owning reference to a method context. It keeps the address of the
+ * context and a static table of functions for its type, so it is cheap to
+ * copy and never allocates. The referenced context must outlive it, which is
+ * the case when it is passed down a call as a parameter.
+ */
 class AnySeriesMethodContext {
 public:
   using DispatchResultType = double;
@@ -28,31 +29,10 @@ public:
   AnySeriesMethodContext() = default;
 
   template<typename UImpl>
-  AnySeriesMethodContext(UImpl impl)
-  : impl_{std::move(impl)}
-  , get_series_result_{[](const std::any& impl,
-                          const std::string& name,
-                          std::size_t result_index) -> DispatchResultType {
-    return std::any_cast<UImpl>(impl).get_series_result(name, result_index);
-  }}
-  , call_series_method_no_output_{[](const std::any& impl,
-                                     const std::string& name,
-                                     AssetSnapshot asset_snapshot)
-                                   -> DispatchResultType {
-    return std::any_cast<UImpl>(impl).call_series_method(
-     name, std::move(asset_snapshot));
-  }}
-  , call_series_method_with_output_{[](const std::any& impl,
-                                       const std::string& name,
-                                       AssetSnapshot asset_snapshot,
-                                       SeriesOutput output)
-                                     -> DispatchResultType {
-    return std::any_cast<UImpl>(impl).call_series_method(
-     name, std::move(asset_snapshot), output);
-  }}
-  , get_index_func_{[](const std::any& impl) -> std::size_t {
-    return std::any_cast<UImpl>(impl).index();
-  }}
+    requires(!std::same_as<std::remove_cvref_t<UImpl>, AnySeriesMethodContext>)
+  AnySeriesMethodContext(const UImpl& impl) noexcept
+  : impl_{std::addressof(impl)}
+  , vtable_{&vtable_for_<UImpl>}
   {
   }
 
@@ -61,7 +41,11 @@ public:
                           AssetSnapshot asset_snapshot) noexcept
    -> DispatchResultType
   {
-    return self.call_series_method_no_output_(
+    if(!self.vtable_) {
+      return std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.vtable_->call_series_method_no_output(
      self.impl_, name, std::move(asset_snapshot));
   }
 
@@ -71,7 +55,11 @@ public:
                           SeriesOutput output_name) noexcept
    -> DispatchResultType
   {
-    return self.call_series_method_with_output_(
+    if(!self.vtable_) {
+      return std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.vtable_->call_series_method_with_output(
      self.impl_, name, std::move(asset_snapshot), output_name);
   }
 
@@ -80,46 +68,203 @@ public:
                          std::size_t result_index) noexcept
    -> DispatchResultType
   {
-    return self.get_series_result_(self.impl_, name, result_index);
+    if(!self.vtable_) {
+      return std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.vtable_->get_series_result(self.impl_, name, result_index);
+  }
+
+  auto call_series_slot(this const AnySeriesMethodContext& self,
+                        std::size_t slot,
+                        AssetSnapshot asset_snapshot) noexcept
+   -> DispatchResultType
+  {
+    if(!self.vtable_) {
+      return std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.vtable_->call_series_slot_no_output(
+     self.impl_, slot, std::move(asset_snapshot));
+  }
+
+  auto call_series_slot(this const AnySeriesMethodContext& self,
+                        std::size_t slot,
+                        AssetSnapshot asset_snapshot,
+                        SeriesOutput output_name) noexcept
+   -> DispatchResultType
+  {
+    if(!self.vtable_) {
+      return std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.vtable_->call_series_slot_with_output(
+     self.impl_, slot, std::move(asset_snapshot), output_name);
+  }
+
+  auto get_series_slot_result(this const AnySeriesMethodContext& self,
+                              std::size_t slot,
+                              std::size_t result_index) noexcept
+   -> DispatchResultType
+  {
+    if(!self.vtable_) {
+      return std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.vtable_->get_series_slot_result(self.impl_, slot, result_index);
   }
 
   auto index(this const AnySeriesMethodContext& self) noexcept -> std::size_t
   {
-    return self.get_index_func_(self.impl_);
+    return self.vtable_ ? self.vtable_->index(self.impl_) : 0;
   }
 
-  template<typename UImpl>
-  friend auto
-  series_method_context_cast(const AnySeriesMethodContext& method) noexcept
-   -> const UImpl*
+  auto indicator_cache(this const AnySeriesMethodContext& self) noexcept
+   -> IndicatorCache*
+  {
+    return self.vtable_ ? self.vtable_->indicator_cache(self.impl_) : nullptr;
+  }
+
+  auto condition_statistics(this const AnySeriesMethodContext& self) noexcept
+   -> ConditionStatistics*
   {
-    return std::any_cast<const UImpl>(&method.impl_);
+    return self.vtable_ ? self.vtable_->condition_statistics(self.impl_)
+                        : nullptr;
   }
 
   template<typename UImpl>
   friend auto
-  series_method_context_cast(AnySeriesMethodContext& method) noexcept -> UImpl*
+  series_method_context_cast(const AnySeriesMethodContext& method) noexcept
+   -> const UImpl*
   {
-    return std::any_cast<UImpl>(&method.impl_);
+    return method.vtable_ == &vtable_for_<UImpl>
+            ? static_cast<const UImpl*>(method.impl_)
+            : nullptr;
   }
 
 private:
-  std::any impl_;
+  struct VTable {
+    auto (*get_series_result)(const void*, const std::string&, std::size_t)
+     -> DispatchResultType;
+
+    auto (*call_series_method_no_output)(const void*,
+                                         const std::string&,
+                                         AssetSnapshot) -> DispatchResultType;
+
+    auto (*call_series_method_with_output)(const void*,
+                                           const std::string&,
+                                           AssetSnapshot,
+                                           SeriesOutput) -> DispatchResultType;
+
+    auto (*call_series_slot_no_output)(const void*, std::size_t, AssetSnapshot)
+     -> DispatchResultType;
 
-  std::function<
-   auto(const std::any&, const std::string&, std::size_t)->DispatchResultType>
-   get_series_result_;
+    auto (*call_series_slot_with_output)(const void*,
+                                         std::size_t,
+                                         AssetSnapshot,
+                                         SeriesOutput) -> DispatchResultType;
 
-  std::function<
-   auto(const std::any&, const std::string&, AssetSnapshot)->DispatchResultType>
-   call_series_method_no_output_;
+    auto (*get_series_slot_result)(const void*, std::size_t, std::size_t)
+     -> DispatchResultType;
 
-  std::function<
-   auto(const std::any&, const std::string&, AssetSnapshot, SeriesOutput)
-    ->DispatchResultType>
-   call_series_method_with_output_;
+    auto (*index)(const void*) -> std::size_t;
+
+    auto (*indicator_cache)(const void*) -> IndicatorCache*;
+
+    auto (*condition_statistics)(const void*) -> ConditionStatistics*;
+  };
+
+  template<typename UImpl>
+  static constexpr auto vtable_for_ = VTable{
+   .get_series_result = [](const void* impl,
+                           const std::string& name,
+                           std::size_t result_index) -> DispatchResultType {
+     return static_cast<const UImpl*>(impl)->get_series_result(name,
+                                                               result_index);
+   },
+   .call_series_method_no_output = [](const void* impl,
+                                      const std::string& name,
+                                      AssetSnapshot asset_snapshot)
+    -> DispatchResultType {
+     return static_cast<const UImpl*>(impl)->call_series_method(
+      name, std::move(asset_snapshot));
+   },
+   .call_series_method_with_output = [](const void* impl,
+                                        const std::string& name,
+                                        AssetSnapshot asset_snapshot,
+                                        SeriesOutput output)
+    -> DispatchResultType {
+     return static_cast<const UImpl*>(impl)->call_series_method(
+      name, std::move(asset_snapshot), output);
+   },
+   .call_series_slot_no_output = [](const void* impl,
+                                    std::size_t slot,
+                                    AssetSnapshot asset_snapshot)
+    -> DispatchResultType {
+     if constexpr(requires(const UImpl& context) {
+                    context.call_series_slot(slot, asset_snapshot);
+                  }) {
+       return static_cast<const UImpl*>(impl)->call_series_slot(
+        slot, std::move(asset_snapshot));
+     } else {
+       return std::numeric_limits<DispatchResultType>::quiet_NaN();
+     }
+   },
+   .call_series_slot_with_output = [](const void* impl,
+                                      std::size_t slot,
+                                      AssetSnapshot asset_snapshot,
+                                      SeriesOutput output)
+    -> DispatchResultType {
+     if constexpr(requires(const UImpl& context) {
+                    context.call_series_slot(slot, asset_snapshot, output);
+                  }) {
+       return static_cast<const UImpl*>(impl)->call_series_slot(
+        slot, std::move(asset_snapshot), output);
+     } else {
+       return std::numeric_limits<DispatchResultType>::quiet_NaN();
+     }
+   },
+   .get_series_slot_result = [](const void* impl,
+                                std::size_t slot,
+                                std::size_t result_index)
+    -> DispatchResultType {
+     if constexpr(requires(const UImpl& context) {
+                    context.get_series_slot_result(slot, result_index);
+                  }) {
+       return static_cast<const UImpl*>(impl)->get_series_slot_result(
+        slot, result_index);
+     } else {
+       return std::numeric_limits<DispatchResultType>::quiet_NaN();
+     }
+   },
+   .index = [](const void* impl) -> std::size_t {
+     return static_cast<const UImpl*>(impl)->index();
+   },
+   .indicator_cache = [](const void* impl) -> IndicatorCache* {
+     if constexpr(requires(const UImpl& context) {
+                    {
+                      context.indicator_cache()
+                    } -> std::same_as<IndicatorCache*>;
+                  }) {
+       return static_cast<const UImpl*>(impl)->indicator_cache();
+     } else {
+       return nullptr;
+     }
+   },
+   .condition_statistics = [](const void* impl) -> ConditionStatistics* {
+     if constexpr(requires(const UImpl& context) {
+                    {
+                      context.condition_statistics()
+                    } -> std::same_as<ConditionStatistics*>;
+                  }) {
+       return static_cast<const UImpl*>(impl)->condition_statistics();
+     } else {
+       return nullptr;
+     }
+   }};
 
-  std::function<auto(const std::any&)->std::size_t> get_index_func_;
+  const void* impl_{nullptr};
+  const VTable* vtable_{nullptr};
 };
 
 } // namespace pludux
@@ -16,17 +16,32 @@ class AssetData {
 public:
   AssetData() = default;
 
+  /**
+   * Values ordered from the latest, as in `{latest, previous, ...}`.
+   */
   AssetData(std::initializer_list<double> data)
   : AssetData(data.begin(), data.end())
   {
   }
 
+  /**
+   * Values ordered from the latest.
+   */
   template<typename TBidirectIt>
   AssetData(TBidirectIt first, TBidirectIt last)
   : data_{std::make_reverse_iterator(last), std::make_reverse_iterator(first)}
   {
   }
 
+  /**
+   * Values in chronological order, as they come from most sources. They are
+   * stored as they are, without being copied or reversed.
+   */
+  explicit AssetData(std::vector<double> data) noexcept
+  : data_{std::move(data)}
+  {
+  }
+
   /**
    * The 0 lookback is the latest value.
    * If the lookback is out of bounds, return NaN.
@@ -47,6 +62,9 @@ public:
     return self.data_.size();
   }
 
+  /**
+   * The values in chronological order, indexed by bar position.
+   */
   auto data(this const AssetData& self) noexcept -> const std::vector<double>&
   {
     return self.data_;
@@ -1,14 +1,20 @@
 module;
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <concepts>
 #include <cstddef>
 #include <ctime>
 #include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -20,10 +26,28 @@ import :asset_series;
 
 export namespace pludux {
 
+/**
+ * The fields of an asset stored as columns of one contiguous buffer. Every
+ * column spans the size of the history and keeps its values aligned to the
+ * latest bar, so a field shorter than the history reads NaN at its oldest
+ * bars.
+ *
+ * Fields are looked up by name once to get their handle; reading a value
+ * through a handle is a bounds-checked index into the buffer.
+ *
+ * The buffer is either owned by the history or a view of storage kept alive
+ * by the history, e.g. a memory-mapped file, or of the buffer of another
+ * history for a window of its bars. Copies and windows of a history share its
+ * buffer, so a viewed or shared buffer is copied the first time a field is
+ * inserted.
+ */
 class AssetHistory {
 public:
   using FieldDataType = std::unordered_map<std::string, AssetData>;
 
+  static constexpr auto invalid_field_handle =
+   std::numeric_limits<std::size_t>::max();
+
   AssetHistory(
    std::initializer_list<std::pair<std::string, std::initializer_list<double>>>
     data)
@@ -33,20 +57,68 @@ public:
 
   template<typename TInputIt>
   AssetHistory(TInputIt begin_it, TInputIt end_it)
-  : field_data_(begin_it, end_it)
+  : fields_{}
+  , field_handles_{}
+  , field_sizes_{}
+  , values_{}
+  , mapped_values_{}
+  , mapped_storage_{}
   , size_{0}
+  , column_stride_{0}
+  , column_offset_{0}
+  , is_view_{false}
+  , revision_{next_revision_()}
+  {
+    for(auto it = begin_it; it != end_it; ++it) {
+      const auto& [field, series] = *it;
+      if(contains(field)) {
+        continue;
+      }
+
+      using SeriesType = std::remove_cvref_t<decltype(series)>;
+      if constexpr(std::same_as<SeriesType, AssetData>) {
+        add_field_(field, series.data());
+      } else {
+        add_field_(field, AssetData{series}.data());
+      }
+    }
+  }
+
+  /**
+   * View columns laid out as by this class: `fields.size()` columns of `size`
+   * values each, one after another, every column right-aligned to its field
+   * size. The values are read in place and `storage` keeps them alive.
+   */
+  AssetHistory(std::vector<std::string> fields,
+               std::vector<std::size_t> field_sizes,
+               std::size_t size,
+               std::span<const double> values,
+               std::shared_ptr<const void> storage)
+  : fields_{std::move(fields)}
+  , field_handles_{}
+  , field_sizes_{std::move(field_sizes)}
+  , values_{}
+  , mapped_values_{values}
+  , mapped_storage_{std::move(storage)}
+  , size_{size}
+  , column_stride_{size}
+  , column_offset_{0}
+  , is_view_{true}
+  , revision_{next_revision_()}
   {
-    recalculate_size_();
+    assert(field_sizes_.size() == fields_.size());
+    assert(mapped_values_.size() == fields_.size() * size_);
+
+    for(auto handle = 0uz; handle < fields_.size(); ++handle) {
+      assert(field_sizes_[handle] <= size_);
+      field_handles_.emplace(fields_[handle], handle);
+    }
   }
 
   auto operator[](this const AssetHistory& self,
                   const std::string& field) noexcept -> AssetSeries
   {
-    const auto it = self.field_data_.find(field);
-    if(it != self.field_data_.end()) {
-      return AssetSeries{it->second.data()};
-    }
-    return AssetSeries{};
+    return self.series(self.field_handle(field));
   }
 
   auto size(this const AssetHistory& self) noexcept -> std::size_t
@@ -54,41 +126,219 @@ public:
     return self.size_;
   }
 
-  auto field_data(this const AssetHistory& self) noexcept
-   -> const FieldDataType&
+  /**
+   * The handle of the field, or `invalid_field_handle` if the history does
+   * not contain it. Handles stay valid until the history is reassigned.
+   */
+  auto field_handle(this const AssetHistory& self,
+                    const std::string& field) noexcept -> std::size_t
+  {
+    const auto it = self.field_handles_.find(field);
+    if(it == self.field_handles_.end()) {
+      return invalid_field_handle;
+    }
+    return it->second;
+  }
+
+  /**
+   * The value of the field at the lookback, where the 0 lookback is the
+   * latest value. Invalid handles and lookbacks out of bounds give NaN.
+   */
+  auto value(this const AssetHistory& self,
+             std::size_t field_handle,
+             std::size_t lookback) noexcept -> double
+  {
+    if(field_handle >= self.field_sizes_.size() ||
+       lookback >= self.field_sizes_[field_handle]) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    return self.buffer_()[self.column_end_(field_handle) - 1 - lookback];
+  }
+
+  auto series(this const AssetHistory& self, std::size_t field_handle) noexcept
+   -> AssetSeries
+  {
+    if(field_handle >= self.field_sizes_.size()) {
+      return AssetSeries{};
+    }
+
+    return AssetSeries{self.column_(field_handle)};
+  }
+
+  /**
+   * The field names, ordered by their handles.
+   */
+  auto fields(this const AssetHistory& self) noexcept
+   -> const std::vector<std::string>&
+  {
+    return self.fields_;
+  }
+
+  /**
+   * Copy the columns out of the buffer, e.g. for serialization.
+   */
+  auto field_data(this const AssetHistory& self) -> FieldDataType
+  {
+    auto field_data = FieldDataType{};
+    for(auto handle = 0uz; handle < self.fields_.size(); ++handle) {
+      const auto column = self.column_(handle);
+      auto series = AssetData{};
+      series.data(std::vector<double>{column.begin(), column.end()});
+      field_data.emplace(self.fields_[handle], std::move(series));
+    }
+    return field_data;
+  }
+
+  /**
+   * Identify the content of the history. Every history gets a unique revision
+   * when it is created and a new one whenever it is modified, so results
+   * computed from a history can be reused while the revision is unchanged.
+   */
+  auto revision(this const AssetHistory& self) noexcept -> std::size_t
   {
-    return self.field_data_;
+    return self.revision_;
   }
 
   auto contains(this const AssetHistory& self,
                 const std::string& field) noexcept -> bool
   {
-    return self.field_data_.contains(field);
+    return self.field_handles_.contains(field);
   }
 
-  void
-  insert(this AssetHistory& self, std::string field, AssetData series) noexcept
+  /**
+   * View the bars from position `begin` up to `end` as a history of their
+   * own, without copying them. Fields keep the values they have in the
+   * window, and the window gets a revision of its own.
+   *
+   * The window reads the buffer of this history in place and shares it, so
+   * the window stays valid after this history is destroyed or modified.
+   */
+  auto window(this const AssetHistory& self,
+              std::size_t begin,
+              std::size_t end) -> AssetHistory
   {
-    self.field_data_.emplace(std::move(field), std::move(series));
-    self.recalculate_size_();
+    end = std::min(end, self.size_);
+    begin = std::min(begin, end);
+
+    auto window = AssetHistory{};
+    window.fields_ = self.fields_;
+    window.field_handles_ = self.field_handles_;
+    window.mapped_values_ = self.buffer_();
+    if(self.is_view_) {
+      window.mapped_storage_ = self.mapped_storage_;
+    } else {
+      window.mapped_storage_ = self.values_;
+    }
+    window.size_ = end - begin;
+    window.column_stride_ = self.column_stride_;
+    window.column_offset_ = self.column_offset_ + begin;
+    window.is_view_ = true;
+
+    window.field_sizes_.reserve(self.field_sizes_.size());
+    for(const auto field_size : self.field_sizes_) {
+      const auto field_begin = std::max(begin, self.size_ - field_size);
+      window.field_sizes_.push_back(end > field_begin ? end - field_begin : 0);
+    }
+
+    return window;
+  }
+
+  void insert(this AssetHistory& self, std::string field, AssetData series)
+  {
+    if(!self.contains(field)) {
+      self.add_field_(std::move(field), series.data());
+    }
+    self.revision_ = next_revision_();
   }
 
 private:
-  FieldDataType field_data_;
+  std::vector<std::string> fields_;
+  std::unordered_map<std::string, std::size_t> field_handles_;
+  std::vector<std::size_t> field_sizes_;
+  std::shared_ptr<std::vector<double>> values_;
+  std::span<const double> mapped_values_;
+  std::shared_ptr<const void> mapped_storage_;
   std::size_t size_;
 
-  void recalculate_size_(this AssetHistory& self) noexcept
+  // Column `h` of the buffer holds the values of the bars from
+  // `h * column_stride_ + column_offset_` on, which is `h * size_` unless the
+  // history is a window of another one.
+  std::size_t column_stride_;
+  std::size_t column_offset_;
+
+  bool is_view_;
+  std::size_t revision_;
+
+  static auto next_revision_() noexcept -> std::size_t
+  {
+    static auto last_revision = std::atomic<std::size_t>{0};
+    return ++last_revision;
+  }
+
+  auto buffer_(this const AssetHistory& self) noexcept
+   -> std::span<const double>
   {
-    if(self.field_data_.empty()) {
-      self.size_ = 0;
-      return;
+    if(self.is_view_) {
+      return self.mapped_values_;
+    }
+    if(!self.values_) {
+      return {};
+    }
+    return *self.values_;
+  }
+
+  auto column_end_(this const AssetHistory& self,
+                   std::size_t field_handle) noexcept -> std::size_t
+  {
+    return field_handle * self.column_stride_ + self.column_offset_ +
+           self.size_;
+  }
+
+  auto column_(this const AssetHistory& self, std::size_t field_handle) noexcept
+   -> std::span<const double>
+  {
+    const auto field_size = self.field_sizes_[field_handle];
+    const auto column_end = self.column_end_(field_handle);
+    return self.buffer_().subspan(column_end - field_size, field_size);
+  }
+
+  void add_field_(this AssetHistory& self,
+                  std::string field,
+                  std::span<const double> data)
+  {
+    const auto field_count = self.fields_.size();
+    const auto new_size = std::max(self.size_, data.size());
+
+    // A buffer shared with copies or windows is never modified in place.
+    if(new_size != self.size_ || self.is_view_ || !self.values_ ||
+       self.values_.use_count() > 1) {
+      auto values = std::make_shared<std::vector<double>>(
+       field_count * new_size, std::numeric_limits<double>::quiet_NaN());
+
+      for(auto handle = 0uz; handle < field_count; ++handle) {
+        const auto column = self.column_(handle);
+        const auto column_end = (handle + 1) * new_size;
+        std::ranges::copy(column,
+                          values->begin() + column_end - column.size());
+      }
+
+      self.values_ = std::move(values);
+      self.mapped_values_ = {};
+      self.mapped_storage_.reset();
+      self.is_view_ = false;
+      self.size_ = new_size;
+      self.column_stride_ = new_size;
+      self.column_offset_ = 0;
     }
 
-    auto values_view = std::views::values(self.field_data_);
-    auto sizes = std::views::transform(
-     values_view, [](const auto& series) { return series.size(); });
+    self.values_->resize((field_count + 1) * self.size_,
+                         std::numeric_limits<double>::quiet_NaN());
+    std::ranges::copy(data, self.values_->end() - data.size());
 
-    self.size_ = *std::ranges::max_element(sizes);
+    self.field_handles_.emplace(field, field_count);
+    self.fields_.emplace_back(std::move(field));
+    self.field_sizes_.push_back(data.size());
   }
 };
 
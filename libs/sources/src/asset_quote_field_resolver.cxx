@@ -13,6 +13,18 @@ import :asset_history;
 
 export namespace pludux {
 
+/**
+ * Handles of the quote fields in one asset history.
+ */
+struct AssetQuoteFieldHandles {
+  std::size_t datetime{AssetHistory::invalid_field_handle};
+  std::size_t open{AssetHistory::invalid_field_handle};
+  std::size_t high{AssetHistory::invalid_field_handle};
+  std::size_t low{AssetHistory::invalid_field_handle};
+  std::size_t close{AssetHistory::invalid_field_handle};
+  std::size_t volume{AssetHistory::invalid_field_handle};
+};
+
 class AssetQuoteFieldResolver {
 public:
   AssetQuoteFieldResolver()
@@ -145,6 +157,23 @@ public:
     return history[self.volume_field_];
   }
 
+  /**
+   * Look the quote fields up once, so the quotes can be read without
+   * resolving the field names again.
+   */
+  auto get_handles(this const AssetQuoteFieldResolver& self,
+                   const AssetHistory& history) noexcept
+   -> AssetQuoteFieldHandles
+  {
+    return AssetQuoteFieldHandles{
+     .datetime = history.field_handle(self.datetime_field_),
+     .open = history.field_handle(self.open_field_),
+     .high = history.field_handle(self.high_field_),
+     .low = history.field_handle(self.low_field_),
+     .close = history.field_handle(self.close_field_),
+     .volume = history.field_handle(self.volume_field_)};
+  }
+
 private:
   std::string datetime_field_;
   std::string open_field_;
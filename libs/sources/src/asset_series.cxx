@@ -37,6 +37,14 @@ public:
     return self.data_view_.size();
   }
 
+  /**
+   * The values in chronological order, indexed by bar position.
+   */
+  auto data(this const AssetSeries& self) noexcept -> std::span<const double>
+  {
+    return self.data_view_;
+  }
+
 private:
   std::span<const double> data_view_;
 };
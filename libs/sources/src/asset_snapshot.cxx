@@ -37,9 +37,10 @@ public:
   AssetSnapshot(std::size_t lookback,
                 const AssetHistory& asset_history,
                 const AssetQuoteFieldResolver& field_resolver) noexcept
-  : lookback_{lookback}
-  , asset_history_{asset_history}
-  , field_resolver_{field_resolver}
+  : AssetSnapshot{lookback,
+                  asset_history,
+                  field_resolver,
+                  field_resolver.get_handles(asset_history)}
   {
   }
 
@@ -52,8 +53,21 @@ public:
   auto operator[](this AssetSnapshot self, std::size_t index) noexcept
    -> AssetSnapshot
   {
-    return AssetSnapshot{
-     self.lookback_ + index, self.asset_history_, self.field_resolver_};
+    return AssetSnapshot{self.lookback_ + index,
+                         self.asset_history_,
+                         self.field_resolver_,
+                         self.field_handles_};
+  }
+
+  auto asset_history(this AssetSnapshot self) noexcept -> const AssetHistory&
+  {
+    return self.asset_history_;
+  }
+
+  auto field_resolver(this AssetSnapshot self) noexcept
+   -> const AssetQuoteFieldResolver&
+  {
+    return self.field_resolver_;
   }
 
   auto lookback(this AssetSnapshot self) noexcept -> std::size_t
@@ -83,46 +97,95 @@ public:
 
   auto datetime(this AssetSnapshot self) noexcept -> double
   {
-    return self.field_resolver_.get_datetimes(
-     self.asset_history_)[self.lookback_];
+    return self.asset_history_.value(self.field_handles_.datetime,
+                                     self.lookback_);
   }
 
   auto open(this AssetSnapshot self) noexcept -> double
   {
-    return self.field_resolver_.get_opens(self.asset_history_)[self.lookback_];
+    return self.asset_history_.value(self.field_handles_.open, self.lookback_);
   }
 
   auto high(this AssetSnapshot self) noexcept -> double
   {
-    return self.field_resolver_.get_highs(self.asset_history_)[self.lookback_];
+    return self.asset_history_.value(self.field_handles_.high, self.lookback_);
   }
 
   auto low(this AssetSnapshot self) noexcept -> double
   {
-    return self.field_resolver_.get_lows(self.asset_history_)[self.lookback_];
+    return self.asset_history_.value(self.field_handles_.low, self.lookback_);
   }
 
   auto close(this AssetSnapshot self) noexcept -> double
   {
-    return self.field_resolver_.get_closes(self.asset_history_)[self.lookback_];
+    return self.asset_history_.value(self.field_handles_.close, self.lookback_);
   }
 
   auto volume(this AssetSnapshot self) noexcept -> double
   {
-    return self.field_resolver_.get_volumes(
-     self.asset_history_)[self.lookback_];
+    return self.asset_history_.value(self.field_handles_.volume,
+                                     self.lookback_);
   }
 
   auto data(this AssetSnapshot self, const std::string& field) noexcept
    -> double
   {
-    return self.asset_history_[field][self.lookback_];
+    const auto field_handle = self.asset_history_.field_handle(field);
+    return self.asset_history_.value(field_handle, self.lookback_);
+  }
+
+  auto datetimes(this AssetSnapshot self) noexcept -> AssetSeries
+  {
+    return self.asset_history_.series(self.field_handles_.datetime);
+  }
+
+  auto opens(this AssetSnapshot self) noexcept -> AssetSeries
+  {
+    return self.asset_history_.series(self.field_handles_.open);
+  }
+
+  auto highs(this AssetSnapshot self) noexcept -> AssetSeries
+  {
+    return self.asset_history_.series(self.field_handles_.high);
+  }
+
+  auto lows(this AssetSnapshot self) noexcept -> AssetSeries
+  {
+    return self.asset_history_.series(self.field_handles_.low);
+  }
+
+  auto closes(this AssetSnapshot self) noexcept -> AssetSeries
+  {
+    return self.asset_history_.series(self.field_handles_.close);
+  }
+
+  auto volumes(this AssetSnapshot self) noexcept -> AssetSeries
+  {
+    return self.asset_history_.series(self.field_handles_.volume);
+  }
+
+  auto series(this AssetSnapshot self, const std::string& field) noexcept
+   -> AssetSeries
+  {
+    return self.asset_history_[field];
   }
 
 private:
   std::size_t lookback_;
   const AssetHistory& asset_history_;
   const AssetQuoteFieldResolver& field_resolver_;
+  AssetQuoteFieldHandles field_handles_;
+
+  AssetSnapshot(std::size_t lookback,
+                const AssetHistory& asset_history,
+                const AssetQuoteFieldResolver& field_resolver,
+                AssetQuoteFieldHandles field_handles) noexcept
+  : lookback_{lookback}
+  , asset_history_{asset_history}
+  , field_resolver_{field_resolver}
+  , field_handles_{field_handles}
+  {
+  }
 };
 
 } // namespace pludux
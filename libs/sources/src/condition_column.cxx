@@ -0,0 +1,243 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+export module pludux:condition_column;
+
+import :asset_snapshot;
+import :method_contextable;
+import :series_kernels;
+
+export namespace pludux {
+
+/**
+ * The result of a condition for every bar, packed one bit per bar and ordered
+ * from the oldest bar like a series column. Conditions are combined a word of
+ * bars at a time.
+ */
+class ConditionColumn {
+public:
+  using WordType = std::uint64_t;
+
+  static constexpr auto word_size =
+   static_cast<std::size_t>(std::numeric_limits<WordType>::digits);
+
+  ConditionColumn() = default;
+
+  explicit ConditionColumn(std::size_t size, bool value = false)
+  : size_{size}
+  , words_((size + word_size - 1) / word_size, value ? ~WordType{0} : 0)
+  {
+    trim_();
+  }
+
+  auto size(this const ConditionColumn& self) noexcept -> std::size_t
+  {
+    return self.size_;
+  }
+
+  auto empty(this const ConditionColumn& self) noexcept -> bool
+  {
+    return self.size_ == 0;
+  }
+
+  auto operator[](this const ConditionColumn& self, std::size_t index) noexcept
+   -> bool
+  {
+    return (self.words_[index / word_size] >> (index % word_size)) & 1;
+  }
+
+  void set(this ConditionColumn& self, std::size_t index, bool value) noexcept
+  {
+    const auto mask = WordType{1} << (index % word_size);
+    auto& word = self.words_[index / word_size];
+    word = value ? word | mask : word & ~mask;
+  }
+
+  auto count(this const ConditionColumn& self) noexcept -> std::size_t
+  {
+    auto result = 0uz;
+    for(const auto word : self.words_) {
+      result += static_cast<std::size_t>(std::popcount(word));
+    }
+    return result;
+  }
+
+  auto words(this const ConditionColumn& self) noexcept
+   -> std::span<const WordType>
+  {
+    return self.words_;
+  }
+
+  auto words(this ConditionColumn& self) noexcept -> std::span<WordType>
+  {
+    return self.words_;
+  }
+
+  /**
+   * The column moved `count` bars later: each bar holds the result of the bar
+   * `count` bars before it, and the first `count` bars are false.
+   */
+  auto lagged(this const ConditionColumn& self, std::size_t count)
+   -> ConditionColumn
+  {
+    auto result = ConditionColumn{self.size_};
+    const auto word_shift = count / word_size;
+    const auto bit_shift = count % word_size;
+
+    for(auto i = word_shift; i < self.words_.size(); ++i) {
+      auto word = self.words_[i - word_shift] << bit_shift;
+      if(bit_shift != 0 && i > word_shift) {
+        word |= self.words_[i - word_shift - 1] >> (word_size - bit_shift);
+      }
+      result.words_[i] = word;
+    }
+
+    result.trim_();
+    return result;
+  }
+
+  /**
+   * Combine the columns word by word with a boolean operator applied to every
+   * bar. The operator is expanded over its truth table, so any operator on
+   * two bools, such as `std::logical_and<>`, is evaluated a word at a time.
+   */
+  template<typename TLogicalOperator>
+    requires std::is_invocable_r_v<bool, TLogicalOperator, bool, bool>
+  auto combine(this const ConditionColumn& self,
+               const ConditionColumn& other,
+               TLogicalOperator logical_operator) -> ConditionColumn
+  {
+    const auto table = std::array{logical_operator(false, false),
+                                  logical_operator(false, true),
+                                  logical_operator(true, false),
+                                  logical_operator(true, true)};
+
+    auto result = ConditionColumn{self.size_};
+    const auto word_count = std::min(self.words_.size(), other.words_.size());
+    for(auto i = 0uz; i < word_count; ++i) {
+      const auto a = self.words_[i];
+      const auto b = other.words_[i];
+      result.words_[i] = (table[0] ? ~a & ~b : 0) | (table[1] ? ~a & b : 0) |
+                         (table[2] ? a & ~b : 0) | (table[3] ? a & b : 0);
+    }
+
+    result.trim_();
+    return result;
+  }
+
+  /**
+   * Apply a boolean operator on one bool to every bar, a word at a time.
+   */
+  template<typename TLogicalOperator>
+    requires std::is_invocable_r_v<bool, TLogicalOperator, bool>
+  auto transform(this const ConditionColumn& self,
+                 TLogicalOperator logical_operator) -> ConditionColumn
+  {
+    const auto if_false = logical_operator(false);
+    const auto if_true = logical_operator(true);
+
+    auto result = ConditionColumn{self.size_};
+    for(auto i = 0uz; i < self.words_.size(); ++i) {
+      const auto a = self.words_[i];
+      result.words_[i] = (if_false ? ~a : 0) | (if_true ? a : 0);
+    }
+
+    result.trim_();
+    return result;
+  }
+
+  auto operator&=(this ConditionColumn& self, const ConditionColumn& other)
+   -> ConditionColumn&
+  {
+    for(auto i = 0uz; i < self.words_.size(); ++i) {
+      self.words_[i] &= i < other.words_.size() ? other.words_[i] : 0;
+    }
+    return self;
+  }
+
+  auto operator|=(this ConditionColumn& self, const ConditionColumn& other)
+   -> ConditionColumn&
+  {
+    const auto word_count = std::min(self.words_.size(), other.words_.size());
+    for(auto i = 0uz; i < word_count; ++i) {
+      self.words_[i] |= other.words_[i];
+    }
+    self.trim_();
+    return self;
+  }
+
+  auto operator==(const ConditionColumn& other) const noexcept
+   -> bool = default;
+
+private:
+  std::size_t size_{0};
+  std::vector<WordType> words_;
+
+  /**
+   * Clear the bits past the last bar, so they never change a count or a
+   * comparison of columns.
+   */
+  void trim_(this ConditionColumn& self) noexcept
+  {
+    if(const auto tail_size = self.size_ % word_size; tail_size != 0) {
+      self.words_.back() &= (WordType{1} << tail_size) - 1;
+    }
+  }
+};
+
+/**
+ * Compare two series columns bar by bar with the comparison kernel of the
+ * comparator, which packs a word of bars at a time into the column.
+ */
+template<typename TComparator>
+  requires std::is_invocable_r_v<bool, TComparator, double, double>
+auto compare_series_columns(std::span<const double> lhs,
+                            std::span<const double> rhs,
+                            TComparator comparator) -> ConditionColumn
+{
+  auto result = ConditionColumn{std::min(lhs.size(), rhs.size())};
+  compare_columns(lhs, rhs, comparator, result.words());
+  return result;
+}
+
+/**
+ * Evaluate a condition method for every bar up to the bar of the snapshot.
+ *
+ * The column is ordered from the oldest bar, so the result of the snapshot
+ * itself is `column[asset_snapshot.index()]`. Conditions that provide a
+ * `compute_column` member are computed over whole columns; every other
+ * condition is evaluated bar by bar.
+ */
+template<typename TCondition>
+auto compute_condition_column(const TCondition& condition,
+                              AssetSnapshot asset_snapshot,
+                              MethodContextable auto context)
+ -> ConditionColumn
+{
+  if constexpr(requires {
+                 {
+                   condition.compute_column(asset_snapshot, context)
+                 } -> std::same_as<ConditionColumn>;
+               }) {
+    return condition.compute_column(asset_snapshot, context);
+  } else {
+    const auto size = asset_snapshot.size();
+    auto column = ConditionColumn{size};
+    for(auto i = 0uz; i < size; ++i) {
+      column.set(i, condition(asset_snapshot[size - 1 - i], context));
+    }
+    return column;
+  }
+}
+
+} // namespace pludux
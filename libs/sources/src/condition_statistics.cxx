@@ -0,0 +1,289 @@
+module;
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+export module pludux:condition_statistics;
+
+import :asset_snapshot;
+import :method_contextable;
+
+export namespace pludux {
+
+/**
+ * How often a clause of an ALL_OF or ANY_OF condition was evaluated, how often
+ * it held, and how long the timed evaluations took.
+ */
+struct ClauseStatistics {
+  std::size_t evaluation_count{0};
+  std::size_t hit_count{0};
+  std::size_t timed_count{0};
+  double timed_nanoseconds{0.0};
+
+  /**
+   * The fraction of evaluations the clause held, or one half before it is
+   * evaluated.
+   */
+  auto hit_rate(this const ClauseStatistics& self) noexcept -> double
+  {
+    return self.evaluation_count != 0
+            ? static_cast<double>(self.hit_count) /
+               static_cast<double>(self.evaluation_count)
+            : 0.5;
+  }
+
+  /**
+   * The average time of one evaluation in nanoseconds, or zero before it is
+   * timed.
+   */
+  auto cost(this const ClauseStatistics& self) noexcept -> double
+  {
+    return self.timed_count != 0
+            ? self.timed_nanoseconds / static_cast<double>(self.timed_count)
+            : 0.0;
+  }
+};
+
+/**
+ * The order the clauses of one ALL_OF or ANY_OF condition are evaluated in.
+ *
+ * The evaluation stops at the first clause whose result decides the whole
+ * condition: false for ALL_OF and true for ANY_OF. Clauses are ordered by
+ * their cost divided by the rate at which they decide the condition, so cheap
+ * and decisive clauses go first; the result never depends on the order.
+ * Clauses that have not been timed yet cost nothing, so they are tried early.
+ *
+ * The order adapts to the statistics of the bars evaluated one by one. The
+ * column of a condition is computed clause by clause over every bar at once,
+ * in the declared order, and is not recorded here.
+ */
+class ClauseOrder {
+public:
+  static constexpr auto timing_interval = 16uz;
+  static constexpr auto reorder_interval = 64uz;
+
+  ClauseOrder(std::size_t clause_count, bool deciding_result)
+  : deciding_result_{deciding_result}
+  , order_(clause_count)
+  , clauses_(clause_count)
+  {
+    std::iota(order_.begin(), order_.end(), 0uz);
+  }
+
+  /**
+   * The clause result that decides the condition: false for ALL_OF and true
+   * for ANY_OF.
+   */
+  auto deciding_result(this const ClauseOrder& self) noexcept -> bool
+  {
+    return self.deciding_result_;
+  }
+
+  /**
+   * The indices of the clauses in the order they are evaluated.
+   */
+  auto order(this const ClauseOrder& self) noexcept
+   -> const std::vector<std::size_t>&
+  {
+    return self.order_;
+  }
+
+  /**
+   * The statistics of every clause, in the order the clauses are declared.
+   */
+  auto clauses(this const ClauseOrder& self) noexcept
+   -> const std::vector<ClauseStatistics>&
+  {
+    return self.clauses_;
+  }
+
+  auto evaluation_count(this const ClauseOrder& self) noexcept -> std::size_t
+  {
+    return self.evaluation_count_;
+  }
+
+  /**
+   * Only one evaluation in `timing_interval` of every clause is timed, so
+   * reading the clock does not outweigh cheap clauses.
+   */
+  auto should_time(this const ClauseOrder& self, std::size_t clause) noexcept
+   -> bool
+  {
+    return self.clauses_[clause].evaluation_count % timing_interval == 0;
+  }
+
+  void record(this ClauseOrder& self,
+              std::size_t clause,
+              std::size_t evaluation_count,
+              std::size_t hit_count) noexcept
+  {
+    auto& statistics = self.clauses_[clause];
+    statistics.evaluation_count += evaluation_count;
+    statistics.hit_count += hit_count;
+  }
+
+  void record(this ClauseOrder& self,
+              std::size_t clause,
+              std::size_t evaluation_count,
+              std::size_t hit_count,
+              std::chrono::nanoseconds duration) noexcept
+  {
+    self.record(clause, evaluation_count, hit_count);
+
+    auto& statistics = self.clauses_[clause];
+    statistics.timed_count += evaluation_count;
+    statistics.timed_nanoseconds += static_cast<double>(duration.count());
+  }
+
+  /**
+   * Count an evaluation of the whole condition, and order the clauses again
+   * every `reorder_interval` evaluations.
+   */
+  void finish_evaluation(this ClauseOrder& self)
+  {
+    ++self.evaluation_count_;
+    if(self.evaluation_count_ == 1 ||
+       self.evaluation_count_ % reorder_interval == 0) {
+      self.reorder();
+    }
+  }
+
+  void reorder(this ClauseOrder& self)
+  {
+    const auto rank = [&self](std::size_t clause) {
+      const auto& statistics = self.clauses_[clause];
+      const auto hit_rate = statistics.hit_rate();
+      const auto deciding_rate =
+       self.deciding_result_ ? hit_rate : 1.0 - hit_rate;
+
+      return deciding_rate > 0.0 ? statistics.cost() / deciding_rate
+                                 : std::numeric_limits<double>::infinity();
+    };
+
+    std::ranges::stable_sort(self.order_, [&](auto lhs, auto rhs) {
+      return rank(lhs) < rank(rhs);
+    });
+  }
+
+private:
+  bool deciding_result_;
+  std::size_t evaluation_count_{0};
+  std::vector<std::size_t> order_;
+  std::vector<ClauseStatistics> clauses_;
+};
+
+/**
+ * The clause orders of the ALL_OF and ANY_OF conditions of one backtest run,
+ * kept by the address of the condition in the strategy of the run.
+ *
+ * The statistics belong to the run that measured them: a copy starts empty.
+ */
+class ConditionStatistics {
+public:
+  ConditionStatistics() = default;
+
+  ConditionStatistics(const ConditionStatistics&) noexcept
+  : ConditionStatistics{}
+  {
+  }
+
+  ConditionStatistics(ConditionStatistics&&) noexcept = default;
+
+  auto operator=(const ConditionStatistics& other) noexcept
+   -> ConditionStatistics&
+  {
+    if(this != &other) {
+      clear();
+    }
+    return *this;
+  }
+
+  auto operator=(ConditionStatistics&&) noexcept
+   -> ConditionStatistics& = default;
+
+  auto clause_order(this ConditionStatistics& self,
+                    const void* condition,
+                    std::size_t clause_count,
+                    bool deciding_result) -> ClauseOrder&
+  {
+    const auto [it, is_inserted] =
+     self.indices_.try_emplace(condition, self.clause_orders_.size());
+    if(is_inserted) {
+      self.clause_orders_.emplace_back(clause_count, deciding_result);
+    }
+
+    return self.clause_orders_[it->second];
+  }
+
+  /**
+   * The clause orders in the order the conditions were first evaluated.
+   */
+  auto clause_orders(this const ConditionStatistics& self) noexcept
+   -> const std::deque<ClauseOrder>&
+  {
+    return self.clause_orders_;
+  }
+
+  auto size(this const ConditionStatistics& self) noexcept -> std::size_t
+  {
+    return self.clause_orders_.size();
+  }
+
+  void clear(this ConditionStatistics& self) noexcept
+  {
+    self.indices_.clear();
+    self.clause_orders_.clear();
+  }
+
+private:
+  std::unordered_map<const void*, std::size_t> indices_;
+
+  // A deque keeps the clause orders in place while nested conditions add
+  // theirs.
+  std::deque<ClauseOrder> clause_orders_;
+};
+
+/**
+ * Evaluate the clauses of an ALL_OF or ANY_OF condition in their clause
+ * order, stopping at the first deciding result.
+ */
+template<typename TConditions>
+auto evaluate_in_clause_order(ClauseOrder& clause_order,
+                              const TConditions& conditions,
+                              AssetSnapshot asset_snapshot,
+                              MethodContextable auto context) -> bool
+{
+  const auto deciding_result = clause_order.deciding_result();
+  auto result = !deciding_result;
+
+  for(const auto clause : clause_order.order()) {
+    const auto& condition = conditions[clause];
+
+    auto clause_result = false;
+    if(clause_order.should_time(clause)) {
+      const auto start = std::chrono::steady_clock::now();
+      clause_result = condition(asset_snapshot, context);
+      const auto duration = std::chrono::steady_clock::now() - start;
+      clause_order.record(clause, 1, clause_result, duration);
+    } else {
+      clause_result = condition(asset_snapshot, context);
+      clause_order.record(clause, 1, clause_result);
+    }
+
+    if(clause_result == deciding_result) {
+      result = deciding_result;
+      break;
+    }
+  }
+
+  clause_order.finish_evaluation();
+  return result;
+}
+
+} // namespace pludux
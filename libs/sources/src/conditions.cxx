@@ -1,5 +1,7 @@
 export module pludux:conditions;
 
+export import :condition_column;
+export import :condition_statistics;
 export import :conditions.any_condition_method;
 
 export import :conditions.all_of_method;
@@ -1,6 +1,7 @@
 module;
 
 #include <algorithm>
+#include <concepts>
 #include <initializer_list>
 #include <iterator>
 #include <stdexcept>
@@ -11,6 +12,8 @@ export module pludux:conditions.all_of_method;
 
 import :asset_snapshot;
 import :method_contextable;
+import :condition_column;
+import :condition_statistics;
 import :conditions.any_condition_method;
 
 export namespace pludux {
@@ -35,12 +38,32 @@ public:
                   AssetSnapshot asset_snapshot,
                   MethodContextable auto context) -> bool
   {
+    if(auto* clause_order = self.clause_order_(context)) {
+      return evaluate_in_clause_order(
+       *clause_order, self.conditions_, asset_snapshot, context);
+    }
+
     return std::ranges::all_of(
      self.conditions_, [&asset_snapshot, &context](const auto& condition) {
        return condition(asset_snapshot, context);
      });
   }
 
+  auto compute_column(this const AllOfMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> ConditionColumn
+  {
+    auto result = ConditionColumn{asset_snapshot.size(), true};
+    for(const auto& condition : self.conditions_) {
+      // The clauses left cannot change a column whose bars are all decided.
+      if(result.count() == 0) {
+        break;
+      }
+      result &= condition.compute_column(asset_snapshot, context);
+    }
+    return result;
+  }
+
   auto conditions(this const AllOfMethod& self) noexcept
    -> const std::vector<AnyConditionMethod>&
   {
@@ -49,6 +72,27 @@ public:
 
 private:
   std::vector<AnyConditionMethod> conditions_;
+
+  /**
+   * The clause order of this condition in the statistics of the run, if the
+   * context keeps them.
+   */
+  auto clause_order_(this const AllOfMethod& self,
+                     MethodContextable auto context) -> ClauseOrder*
+  {
+    if constexpr(requires {
+                   {
+                     context.condition_statistics()
+                   } -> std::same_as<ConditionStatistics*>;
+                 }) {
+      if(auto* statistics = context.condition_statistics()) {
+        return &statistics->clause_order(
+         &self, self.conditions_.size(), false);
+      }
+    }
+
+    return nullptr;
+  }
 };
 
 } // namespace pludux
\ No newline at end of file
@@ -9,6 +9,7 @@ export module pludux:conditions.any_condition_method;
 
 import :asset_snapshot;
 import :any_method_context;
+import :condition_column;
 
 export namespace pludux {
 
@@ -29,6 +30,13 @@ public:
     return self.impl_->operator()(std::move(asset_snapshot), context);
   }
 
+  auto compute_column(this const AnyConditionMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      AnySeriesMethodContext context) -> ConditionColumn
+  {
+    return self.impl_->compute_column(std::move(asset_snapshot), context);
+  }
+
   auto operator==(this const AnyConditionMethod& self,
                   const AnyConditionMethod& other) noexcept -> bool
   {
@@ -58,6 +66,10 @@ private:
                             AnySeriesMethodContext context) const noexcept
      -> bool = 0;
 
+    virtual auto compute_column(AssetSnapshot asset_snapshot,
+                                AnySeriesMethodContext context) const
+     -> ConditionColumn = 0;
+
     virtual auto operator==(const AnyConditionMethod& other) const noexcept
      -> bool = 0;
 
@@ -81,6 +93,13 @@ private:
       return impl(std::move(asset_snapshot), context);
     }
 
+    auto compute_column(AssetSnapshot asset_snapshot,
+                        AnySeriesMethodContext context) const
+     -> ConditionColumn override
+    {
+      return compute_condition_column(impl, std::move(asset_snapshot), context);
+    }
+
     auto operator==(const AnyConditionMethod& other) const noexcept
      -> bool override
     {
@@ -9,6 +9,8 @@ export module pludux:conditions.comparison_method;
 import :asset_snapshot;
 import :method_contextable;
 
+import :condition_column;
+import :series_column;
 import :conditions.any_condition_method;
 import :series.any_series_method;
 
@@ -37,6 +39,19 @@ public:
     return TComparator{}(target_result, threshold_result);
   }
 
+  auto compute_column(this const ComparisonMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> ConditionColumn
+  {
+    const auto target_results =
+     compute_series_column(self.target_, asset_snapshot, context);
+    const auto threshold_results =
+     compute_series_column(self.threshold_, asset_snapshot, context);
+
+    return compare_series_columns(
+     target_results, threshold_results, TComparator{});
+  }
+
   auto target(this const ComparisonMethod& self) noexcept
    -> const AnySeriesMethod&
   {
@@ -1,5 +1,6 @@
 module;
 
+#include <functional>
 #include <vector>
 
 export module pludux:conditions.crossover_method;
@@ -7,6 +8,8 @@ export module pludux:conditions.crossover_method;
 import :asset_snapshot;
 import :method_contextable;
 
+import :condition_column;
+import :series_column;
 import :conditions.any_condition_method;
 import :series.any_series_method;
 
@@ -35,6 +38,21 @@ public:
     return signal_current > reference_current && signal_prev <= reference_prev;
   }
 
+  auto compute_column(this const CrossoverMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> ConditionColumn
+  {
+    const auto signals =
+     compute_series_column(self.signal_, asset_snapshot, context);
+    const auto references =
+     compute_series_column(self.reference_, asset_snapshot, context);
+
+    auto result = compare_series_columns(signals, references, std::greater<>{});
+    result &= compare_series_columns(signals, references, std::less_equal<>{})
+               .lagged(1);
+    return result;
+  }
+
   auto signal(this const CrossoverMethod& self) noexcept
    -> const AnySeriesMethod&
   {
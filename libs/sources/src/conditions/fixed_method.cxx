@@ -2,6 +2,7 @@ export module pludux:conditions.fixed_method;
 
 import :asset_snapshot;
 import :method_contextable;
+import :condition_column;
 
 namespace pludux {
 
@@ -15,6 +16,13 @@ struct FixedMethod {
   {
     return boolean_value;
   }
+
+  auto compute_column(this const FixedMethod,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> ConditionColumn
+  {
+    return ConditionColumn{asset_snapshot.size(), boolean_value};
+  }
 };
 
 export struct AlwaysMethod : FixedMethod<AlwaysMethod, true> {};
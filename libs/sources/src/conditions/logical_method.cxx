@@ -8,6 +8,7 @@ export module pludux:conditions.logical_method;
 
 import :asset_snapshot;
 import :method_contextable;
+import :condition_column;
 
 import :conditions.any_condition_method;
 
@@ -38,6 +39,18 @@ public:
     return TBinaryLogicalOperator{}(first_condition, second_condition);
   }
 
+  auto compute_column(this const BinaryLogicalMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> ConditionColumn
+  {
+    const auto first_column =
+     self.first_condition_.compute_column(asset_snapshot, context);
+    const auto second_column =
+     self.second_condition_.compute_column(asset_snapshot, context);
+
+    return first_column.combine(second_column, TBinaryLogicalOperator{});
+  }
+
   auto first_condition(this const BinaryLogicalMethod& self)
    -> const AnyConditionMethod&
   {
@@ -87,6 +100,14 @@ public:
     return TUnaryLogicalOperator{}(condition);
   }
 
+  auto compute_column(this const UnaryLogicalMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> ConditionColumn
+  {
+    return self.other_condition_.compute_column(asset_snapshot, context)
+     .transform(TUnaryLogicalOperator{});
+  }
+
   auto other_condition(this const UnaryLogicalMethod& self)
    -> const AnyConditionMethod&
   {
@@ -1,5 +1,7 @@
 module;
 
+#include <cstddef>
+#include <format>
 #include <functional>
 #include <optional>
 #include <stdexcept>
@@ -38,6 +40,12 @@ public:
       return self.config_parser_.parse_filter(config);
     }
 
+    auto series_slot(this const Parser& self, const std::string& name)
+     -> std::size_t
+    {
+      return self.config_parser_.series_slot(name);
+    }
+
   private:
     ConfigParser& config_parser_;
   };
@@ -60,6 +68,8 @@ public:
   : filter_parsers_{}
   , method_parsers_{}
   , use_series_params_{true}
+  , common_methods_{}
+  , series_slots_{}
   {
   }
 
@@ -187,7 +197,7 @@ public:
       }
       const auto method_result = method_deserialize(self, json_params);
 
-      return method_result;
+      return self.share_common_method_(method_result);
     } catch(const std::exception& e) {
       const auto error_message =
        std::format("Error parsing method {}:\n{}", method, e.what());
@@ -202,6 +212,11 @@ public:
   auto serialize_method(this const ConfigParser& self,
                         const AnySeriesMethod& method) -> jsoncons::ojson
   {
+    if(const auto* shared_method =
+        series_method_cast<SharedSeriesMethod<AnySeriesMethod>>(method)) {
+      return self.serialize_method(shared_method->method());
+    }
+
     for(const auto& [method_name, method_parser] : self.method_parsers_) {
       const auto& [method_params_serialize, _] = method_parser;
       auto serialized_params_method = method_params_serialize(self, method);
@@ -251,6 +266,74 @@ public:
     return registry;
   }
 
+  /**
+   * Find the methods that appear more than once in `config`, which may hold
+   * any number of method and filter configs. Until the next call, every parse
+   * of such a method returns one shared node, so the method graph evaluates it
+   * once per bar however many times the configs repeat it.
+   */
+  void share_common_methods(this ConfigParser& self,
+                            const jsoncons::ojson& config)
+  {
+    self.common_methods_.clear();
+
+    auto method_counts = std::unordered_map<std::string, std::size_t>{};
+    self.count_methods_(config, method_counts);
+
+    for(const auto& [method_key, count] : method_counts) {
+      if(count > 1) {
+        self.common_methods_.emplace(method_key, std::nullopt);
+      }
+    }
+  }
+
+  void clear_common_methods(this ConfigParser& self) noexcept
+  {
+    self.common_methods_.clear();
+  }
+
+  /**
+   * Link the series references of every following parse to the slots of
+   * `series_names`, the names of a registry in order, so the references do
+   * not look up their series by name when run. Until the next call, a
+   * reference to a series that is not in `series_names` fails to parse.
+   */
+  void link_series(this ConfigParser& self,
+                   const std::vector<std::string>& series_names)
+  {
+    auto series_slots = std::unordered_map<std::string, std::size_t>{};
+    for(auto slot = 0uz; slot < series_names.size(); ++slot) {
+      series_slots.emplace(series_names[slot], slot);
+    }
+
+    self.series_slots_ = std::move(series_slots);
+  }
+
+  void clear_linked_series(this ConfigParser& self) noexcept
+  {
+    self.series_slots_.reset();
+  }
+
+  /**
+   * The slot of the series a reference is linked to, or
+   * `SeriesNodeMethod::unlinked_slot` when the series are not linked.
+   */
+  auto series_slot(this const ConfigParser& self, const std::string& name)
+   -> std::size_t
+  {
+    if(!self.series_slots_) {
+      return SeriesNodeMethod::unlinked_slot;
+    }
+
+    const auto it = self.series_slots_->find(name);
+    if(it == self.series_slots_->end()) {
+      const auto error_message = std::format("Unknown series: {}", name);
+      throw std::invalid_argument{error_message};
+    }
+
+    return it->second;
+  }
+
 private:
   std::unordered_map<std::string,
                      std::pair<ConditionSerialize, ConditionDeserialize>>
@@ -259,6 +342,125 @@ private:
    method_parsers_;
 
   bool use_series_params_;
+
+  std::unordered_map<std::string, std::optional<AnySeriesMethod>>
+   common_methods_;
+
+  std::optional<std::unordered_map<std::string, std::size_t>> series_slots_;
+
+  /**
+   * Whether a serialized method is a leaf of the method graph: a value, a
+   * data field or a series reference, which is cheaper to evaluate than to
+   * share.
+   */
+  static auto is_leaf_method_(const std::string& method_name) noexcept -> bool
+  {
+    return method_name == "VALUE" || method_name == "DATA" ||
+           method_name == "OPEN" || method_name == "HIGH" ||
+           method_name == "LOW" || method_name == "CLOSE" ||
+           method_name == "VOLUME" || method_name == "SERIES_NODE" ||
+           method_name == "SERIES_VALUE";
+  }
+
+  /**
+   * Count every method config in `config`. Each method config is parsed and
+   * serialized once as a whole, and the keys of its sub-methods are counted
+   * while its key is built from theirs.
+   */
+  void count_methods_(this ConfigParser& self,
+                      const jsoncons::ojson& config,
+                      std::unordered_map<std::string, std::size_t>& counts)
+  {
+    if(config.is_array()) {
+      for(const auto& item : config.array_range()) {
+        self.count_methods_(item, counts);
+      }
+      return;
+    }
+
+    if(!config.is_object()) {
+      return;
+    }
+
+    if(config.contains("method") && config.at("method").is_string() &&
+       self.method_parsers_.contains(config.at("method").as_string())) {
+      const auto serialized_method =
+       self.serialize_method(self.parse_method(config));
+      self.method_key_(serialized_method, &counts);
+      return;
+    }
+
+    for(const auto& [_, member_config] : config.object_range()) {
+      self.count_methods_(member_config, counts);
+    }
+  }
+
+  /**
+   * The key of a serialized method, built bottom-up from the keys of its
+   * members. When `counts` is given, the key of every method that is not a
+   * leaf is counted along the way.
+   */
+  auto method_key_(this const ConfigParser& self,
+                   const jsoncons::ojson& serialized_config,
+                   std::unordered_map<std::string, std::size_t>* counts =
+                    nullptr) -> std::string
+  {
+    if(serialized_config.is_array()) {
+      auto key = std::string{"["};
+      for(const auto& item : serialized_config.array_range()) {
+        if(key.size() > 1) {
+          key += ',';
+        }
+        key += self.method_key_(item, counts);
+      }
+      key += ']';
+      return key;
+    }
+
+    if(!serialized_config.is_object()) {
+      return serialized_config.to_string();
+    }
+
+    auto key = std::string{"{"};
+    for(const auto& [name, member_config] : serialized_config.object_range()) {
+      if(key.size() > 1) {
+        key += ',';
+      }
+      key += jsoncons::ojson(name).to_string();
+      key += ':';
+      key += self.method_key_(member_config, counts);
+    }
+    key += '}';
+
+    if(counts && serialized_config.contains("method") &&
+       serialized_config.at("method").is_string() &&
+       !is_leaf_method_(serialized_config.at("method").as_string())) {
+      ++(*counts)[key];
+    }
+
+    return key;
+  }
+
+  auto share_common_method_(this ConfigParser& self,
+                            const AnySeriesMethod& method) -> AnySeriesMethod
+  {
+    if(self.common_methods_.empty()) {
+      return method;
+    }
+
+    const auto method_key = self.method_key_(self.serialize_method(method));
+    const auto it = self.common_methods_.find(method_key);
+    if(it == self.common_methods_.end()) {
+      return method;
+    }
+
+    auto& shared_method = it->second;
+    if(!shared_method) {
+      shared_method = SharedSeriesMethod{method};
+    }
+
+    return *shared_method;
+  }
 };
 
 auto make_default_registered_config_parser() -> ConfigParser;
@@ -1050,7 +1252,7 @@ auto make_default_registered_config_parser() -> ConfigParser
    },
    [](ConfigParser::Parser config_parser, const jsoncons::ojson& parameters) {
      const auto name = get_param_or<std::string>(parameters, "name", "");
-     return SeriesNodeMethod{name};
+     return SeriesNodeMethod{name, config_parser.series_slot(name)};
    });
 
   config_parser.register_method_parser(
@@ -1070,7 +1272,7 @@ auto make_default_registered_config_parser() -> ConfigParser
    },
    [](ConfigParser::Parser config_parser, const jsoncons::ojson& parameters) {
      const auto name = get_param_or<std::string>(parameters, "name", "");
-     return SeriesValueMethod{name};
+     return SeriesValueMethod{name, config_parser.series_slot(name)};
    });
 
   config_parser.register_method_parser(
@@ -3,25 +3,63 @@ module;
 #include <cstddef>
 #include <limits>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 
 export module pludux:default_method_context;
 
+import :indicator_cache;
+import :condition_statistics;
+import :linked_series;
 import :series_results_collector;
 import :series.series_method_registry;
 
 export namespace pludux {
 
+/**
+ * What a `DefaultMethodContext` serves besides the registered methods and
+ * their collected results. Each part left null is not used.
+ */
+struct DefaultMethodContextOptions {
+  /**
+   * Series with a precomputed column here are served from that column
+   * instead of being evaluated again for each bar.
+   */
+  const SeriesResultsCollector* series_columns{nullptr};
+
+  /**
+   * Where stateful methods keep their results.
+   */
+  IndicatorCache* indicator_cache{nullptr};
+
+  /**
+   * Serves the series nodes linked to a slot. It has to be linked to the
+   * methods, the results collector and the series columns of the context.
+   */
+  const LinkedSeries* linked_series{nullptr};
+
+  /**
+   * Where ALL_OF and ANY_OF conditions measure their clauses, to evaluate
+   * them in the order it chooses.
+   */
+  ConditionStatistics* condition_statistics{nullptr};
+};
+
 class DefaultMethodContext {
 public:
   using DispatchResultType = double;
 
   explicit DefaultMethodContext(const SeriesMethodRegistry& methods,
                                 const SeriesResultsCollector& results_collector,
+                                DefaultMethodContextOptions options = {},
                                 std::size_t current_index = 0) noexcept
   : methods_{methods}
   , results_collector_{results_collector}
+  , series_columns_{options.series_columns}
+  , indicator_cache_{options.indicator_cache}
+  , linked_series_{options.linked_series}
+  , condition_statistics_{options.condition_statistics}
   , current_index_{current_index}
   {
   }
@@ -31,6 +69,12 @@ public:
                           AssetSnapshot asset_snapshot) noexcept
    -> DispatchResultType
   {
+    if(const auto column_value = self.get_column_value_(
+        name, asset_snapshot.index());
+       column_value.has_value()) {
+      return *column_value;
+    }
+
     if(const auto method_opt = self.methods_.get(name);
        method_opt.has_value()) {
       const auto& method = method_opt.value();
@@ -57,9 +101,14 @@ public:
                          std::size_t result_index) noexcept
    -> DispatchResultType
   {
+    if(const auto column_value = self.get_column_value_(name, result_index);
+       column_value.has_value()) {
+      return *column_value;
+    }
+
     if(const auto results_opt = self.results_collector_.results(name);
        results_opt.has_value()) {
-      const auto& results = results_opt.value().get();
+      const auto results = *results_opt;
       if(result_index < results.size()) {
         return results[result_index];
       }
@@ -67,15 +116,119 @@ public:
     return std::numeric_limits<DispatchResultType>::quiet_NaN();
   }
 
+  auto call_series_slot(this const DefaultMethodContext& self,
+                        std::size_t slot,
+                        AssetSnapshot asset_snapshot) noexcept
+   -> DispatchResultType
+  {
+    if(!self.is_linked_(slot)) {
+      return slot < self.methods_.size()
+              ? self.call_series_method(self.methods_.name(slot),
+                                        asset_snapshot)
+              : std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    const auto& linked_series = *self.linked_series_;
+    if(const auto column = linked_series.column(slot);
+       asset_snapshot.index() < column.size()) {
+      return column[asset_snapshot.index()];
+    }
+
+    return linked_series.method(slot)(asset_snapshot, self);
+  }
+
+  auto call_series_slot(this const DefaultMethodContext& self,
+                        std::size_t slot,
+                        AssetSnapshot asset_snapshot,
+                        SeriesOutput output) noexcept -> DispatchResultType
+  {
+    if(!self.is_linked_(slot)) {
+      return slot < self.methods_.size()
+              ? self.call_series_method(
+                 self.methods_.name(slot), asset_snapshot, output)
+              : std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    return self.linked_series_->method(slot)(asset_snapshot, output, self);
+  }
+
+  auto get_series_slot_result(this const DefaultMethodContext& self,
+                              std::size_t slot,
+                              std::size_t result_index) noexcept
+   -> DispatchResultType
+  {
+    if(!self.is_linked_(slot)) {
+      return slot < self.methods_.size()
+              ? self.get_series_result(self.methods_.name(slot), result_index)
+              : std::numeric_limits<DispatchResultType>::quiet_NaN();
+    }
+
+    const auto& linked_series = *self.linked_series_;
+    if(const auto column = linked_series.column(slot);
+       result_index < column.size()) {
+      return column[result_index];
+    }
+
+    if(const auto results = linked_series.results(slot);
+       result_index < results.size()) {
+      return results[result_index];
+    }
+
+    return std::numeric_limits<DispatchResultType>::quiet_NaN();
+  }
+
   auto index(this const DefaultMethodContext& self) noexcept -> std::size_t
   {
     return self.current_index_;
   }
 
+  auto indicator_cache(this const DefaultMethodContext& self) noexcept
+   -> IndicatorCache*
+  {
+    return self.indicator_cache_;
+  }
+
+  auto condition_statistics(this const DefaultMethodContext& self) noexcept
+   -> ConditionStatistics*
+  {
+    return self.condition_statistics_;
+  }
+
 private:
   const SeriesMethodRegistry& methods_{};
   const SeriesResultsCollector& results_collector_{};
+  const SeriesResultsCollector* series_columns_{};
+  IndicatorCache* indicator_cache_{};
+  const LinkedSeries* linked_series_{};
+  ConditionStatistics* condition_statistics_{};
   std::size_t current_index_ = 0;
+
+  auto is_linked_(this const DefaultMethodContext& self,
+                  std::size_t slot) noexcept -> bool
+  {
+    return self.linked_series_ != nullptr &&
+           slot < self.linked_series_->size();
+  }
+
+  auto get_column_value_(this const DefaultMethodContext& self,
+                         const std::string& name,
+                         std::size_t index) noexcept
+   -> std::optional<DispatchResultType>
+  {
+    if(self.series_columns_ == nullptr) {
+      return std::nullopt;
+    }
+
+    if(const auto column_opt = self.series_columns_->results(name);
+       column_opt.has_value()) {
+      const auto column = *column_opt;
+      if(index < column.size()) {
+        return column[index];
+      }
+    }
+
+    return std::nullopt;
+  }
 };
 
 } // namespace pludux
\ No newline at end of file
@@ -0,0 +1,148 @@
+module;
+
+#include <any>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+export module pludux:incremental_results;
+
+import :asset_history;
+import :asset_quote_field_resolver;
+import :asset_snapshot;
+
+export namespace pludux {
+
+/**
+ * Results of a recursive series method over one asset history, ordered from
+ * the oldest bar. Each bar is computed once from the results of the bars
+ * before it, so moving forward one bar costs a single recursion step instead
+ * of a pass over the whole history.
+ */
+class IncrementalResults {
+public:
+  IncrementalResults() = default;
+
+  /**
+   * Get the result at the bar of the snapshot. Bars that are not computed
+   * yet are computed in order with `compute_next(results, bar_snapshot)`,
+   * where `results` holds the results of every bar before `bar_snapshot`.
+   */
+  template<typename TComputeNext>
+  auto get(this IncrementalResults& self,
+           AssetSnapshot asset_snapshot,
+           TComputeNext compute_next) -> double
+  {
+    const auto size = asset_snapshot.size();
+    if(size == 0) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const auto& asset_history = asset_snapshot.asset_history();
+    const auto* field_resolver = &asset_snapshot.field_resolver();
+    if(self.history_revision_ != asset_history.revision() ||
+       self.field_resolver_ != field_resolver) {
+      self.results_.clear();
+      self.state_.reset();
+      self.history_revision_ = asset_history.revision();
+      self.field_resolver_ = field_resolver;
+    }
+
+    const auto index = size - 1;
+    while(self.results_.size() <= index) {
+      const auto bar_lookback = index - self.results_.size();
+      const auto result =
+       compute_next(std::as_const(self.results_), asset_snapshot[bar_lookback]);
+      self.results_.push_back(result);
+    }
+
+    return self.results_[index];
+  }
+
+  /**
+   * State a method carries from bar to bar besides its results, such as the
+   * window of a rolling extremum. It is made from `args` on first use and is
+   * reset together with the results, so it always follows the last bar
+   * computed.
+   */
+  template<typename TState, typename... TArgs>
+  auto state(this IncrementalResults& self, TArgs&&... args) -> TState&
+  {
+    auto* state = std::any_cast<TState>(&self.state_);
+    if(state == nullptr) {
+      state = &self.state_.emplace<TState>(std::forward<TArgs>(args)...);
+    }
+    return *state;
+  }
+
+  void clear(this IncrementalResults& self) noexcept
+  {
+    self.results_.clear();
+    self.state_.reset();
+    self.history_revision_ = 0;
+    self.field_resolver_ = nullptr;
+  }
+
+private:
+  std::size_t history_revision_{0};
+  const AssetQuoteFieldResolver* field_resolver_{nullptr};
+  std::vector<double> results_;
+  std::any state_;
+};
+
+/**
+ * Incremental results a method keeps for itself, for contexts without an
+ * indicator cache. A copy of the method starts from a copy of the results
+ * instead of sharing them, and calls on one method from several threads take
+ * turns.
+ */
+class LocalIncrementalResults {
+public:
+  LocalIncrementalResults() = default;
+
+  LocalIncrementalResults(const LocalIncrementalResults& other)
+  : results_{other.copy_results_()}
+  {
+  }
+
+  auto operator=(const LocalIncrementalResults& other)
+   -> LocalIncrementalResults&
+  {
+    if(this != &other) {
+      auto results = other.copy_results_();
+      const auto lock = std::lock_guard{mutex_};
+      results_ = std::move(results);
+    }
+    return *this;
+  }
+
+  template<typename TComputeNext>
+  auto get(this const LocalIncrementalResults& self,
+           AssetSnapshot asset_snapshot,
+           TComputeNext compute_next) -> double
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    return self.results_.get(asset_snapshot, std::move(compute_next));
+  }
+
+  void clear(this LocalIncrementalResults& self) noexcept
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    self.results_.clear();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  mutable IncrementalResults results_;
+
+  auto copy_results_(this const LocalIncrementalResults& self)
+   -> IncrementalResults
+  {
+    const auto lock = std::lock_guard{self.mutex_};
+    return self.results_;
+  }
+};
+
+} // namespace pludux
@@ -0,0 +1,203 @@
+module;
+
+#include <algorithm>
+#include <any>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module pludux:indicator_cache;
+
+import :asset_quote_field_resolver;
+import :asset_snapshot;
+import :incremental_results;
+import :series_output;
+
+namespace pludux {
+
+auto hash_combine(std::size_t seed, std::size_t value) noexcept -> std::size_t
+{
+  return seed ^ (value + 0x9e3779b9uz + (seed << 6) + (seed >> 2));
+}
+
+} // namespace pludux
+
+export namespace pludux {
+
+/**
+ * Hash the structure of a series method. Methods may provide a `hash` member
+ * combining their parameters and sources; the others are hashed by type, and
+ * equal hashes are told apart with `operator==`.
+ */
+template<typename TMethod>
+auto series_method_hash(const TMethod& method) noexcept -> std::size_t
+{
+  if constexpr(requires {
+                 { method.hash() } -> std::convertible_to<std::size_t>;
+               }) {
+    return method.hash();
+  } else {
+    return typeid(TMethod).hash_code();
+  }
+}
+
+template<typename TMethod, typename... TParams>
+auto series_method_hash(const TMethod& method, const TParams&... params) noexcept
+ -> std::size_t
+{
+  auto seed = typeid(TMethod).hash_code();
+  ((seed = hash_combine(seed, [&] {
+      if constexpr(requires { typename TParams::ResultType; }) {
+        return series_method_hash(params);
+      } else {
+        return std::hash<TParams>{}(params);
+      }
+    }())),
+   ...);
+  return seed;
+}
+
+/**
+ * Results of the stateful series methods of one backtest run. Methods are
+ * keyed by their structure, so identical indicators share their results no
+ * matter how many times they are declared in the strategy.
+ *
+ * The results belong to the run that computed them: a copy of the cache
+ * starts empty.
+ */
+class IndicatorCache {
+public:
+  IndicatorCache() = default;
+
+  IndicatorCache(const IndicatorCache&) noexcept
+  : IndicatorCache{}
+  {
+  }
+
+  IndicatorCache(IndicatorCache&&) noexcept = default;
+
+  auto operator=(const IndicatorCache& other) noexcept -> IndicatorCache&
+  {
+    if(this != &other) {
+      clear();
+    }
+    return *this;
+  }
+
+  auto operator=(IndicatorCache&&) noexcept -> IndicatorCache& = default;
+
+  template<typename TMethod>
+  auto results(this IndicatorCache& self, const TMethod& method)
+   -> IncrementalResults&
+  {
+    return *self.entry_(method).results;
+  }
+
+  /**
+   * The column of a method, or of one of its outputs, over the bars of
+   * `asset_snapshot`. The column is computed by `compute` the first time for
+   * a history revision and a prefix of it is returned afterwards, so the
+   * column of a method read from many places is computed once per run. The
+   * span is valid until the column is computed again or the cache is cleared.
+   */
+  template<typename TMethod>
+  auto column(this IndicatorCache& self,
+              const TMethod& method,
+              std::optional<SeriesOutput> output,
+              AssetSnapshot asset_snapshot,
+              std::invocable auto compute) -> std::span<const double>
+  {
+    const auto size = asset_snapshot.size();
+    const auto history_revision = asset_snapshot.asset_history().revision();
+    const auto* field_resolver = &asset_snapshot.field_resolver();
+    {
+      const auto& columns = self.entry_(method).columns;
+      const auto it = std::ranges::find(columns, output, &Column::output);
+      if(it != columns.end() && it->history_revision == history_revision &&
+         it->field_resolver == field_resolver && it->values.size() >= size) {
+        return std::span{it->values}.first(size);
+      }
+    }
+
+    // Computing the column may add entries for the methods it reads, so the
+    // entry is looked up again to keep it.
+    auto values = compute();
+
+    auto& columns = self.entry_(method).columns;
+    auto it = std::ranges::find(columns, output, &Column::output);
+    if(it == columns.end()) {
+      it = columns.insert(columns.end(), Column{.output = output});
+    }
+    self.column_bytes_ -= it->values.capacity() * sizeof(double);
+    self.column_bytes_ += values.capacity() * sizeof(double);
+    it->history_revision = history_revision;
+    it->field_resolver = field_resolver;
+    it->values = std::move(values);
+    return std::span{it->values}.first(std::min(size, it->values.size()));
+  }
+
+  /**
+   * The bytes held by the cached columns, which grow with the history and
+   * the number of shared methods.
+   */
+  auto column_bytes(this const IndicatorCache& self) noexcept -> std::size_t
+  {
+    return self.column_bytes_;
+  }
+
+  auto size(this const IndicatorCache& self) noexcept -> std::size_t
+  {
+    auto count = 0uz;
+    for(const auto& [hash, bucket] : self.entries_) {
+      count += bucket.size();
+    }
+    return count;
+  }
+
+  void clear(this IndicatorCache& self) noexcept
+  {
+    self.entries_.clear();
+    self.column_bytes_ = 0;
+  }
+
+private:
+  struct Column {
+    std::optional<SeriesOutput> output;
+    std::size_t history_revision{0};
+    const AssetQuoteFieldResolver* field_resolver{nullptr};
+    std::vector<double> values;
+  };
+
+  struct Entry {
+    std::any method;
+    std::unique_ptr<IncrementalResults> results;
+    std::vector<Column> columns;
+  };
+
+  std::unordered_map<std::size_t, std::vector<Entry>> entries_;
+  std::size_t column_bytes_{0};
+
+  template<typename TMethod>
+  auto entry_(this IndicatorCache& self, const TMethod& method) -> Entry&
+  {
+    auto& bucket = self.entries_[series_method_hash(method)];
+    for(auto& entry : bucket) {
+      const auto* cached_method = std::any_cast<TMethod>(&entry.method);
+      if(cached_method != nullptr && *cached_method == method) {
+        return entry;
+      }
+    }
+
+    return bucket.emplace_back(
+     std::any{method}, std::make_unique<IncrementalResults>());
+  }
+};
+
+} // namespace pludux
@@ -0,0 +1,147 @@
+module;
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+export module pludux:linked_series;
+
+import :series_results_collector;
+import :series.any_series_method;
+import :series.series_method_registry;
+
+export namespace pludux {
+
+/**
+ * The registered series of a run, addressed by their slot in the registry.
+ * Every slot points at the method, the precomputed column and the column of
+ * collected results of its series, so series nodes linked to a slot reach
+ * them without looking up names.
+ *
+ * The slots point into the registry and the collectors they are linked to,
+ * which usually belong to the owner of the linked series. A copy or a move
+ * starts empty, so an owner moved elsewhere links its series again instead of
+ * reading the collectors it left behind.
+ */
+class LinkedSeries {
+public:
+  LinkedSeries() = default;
+
+  LinkedSeries(const SeriesMethodRegistry& methods,
+               const SeriesResultsCollector& results_collector,
+               const SeriesResultsCollector& series_columns)
+  {
+    link(methods, results_collector, series_columns);
+  }
+
+  LinkedSeries(const LinkedSeries&) noexcept
+  : LinkedSeries{}
+  {
+  }
+
+  LinkedSeries(LinkedSeries&&) noexcept
+  : LinkedSeries{}
+  {
+  }
+
+  auto operator=(const LinkedSeries& other) noexcept -> LinkedSeries&
+  {
+    if(this != &other) {
+      clear();
+    }
+    return *this;
+  }
+
+  auto operator=(LinkedSeries&& other) noexcept -> LinkedSeries&
+  {
+    if(this != &other) {
+      clear();
+    }
+    return *this;
+  }
+
+  /**
+   * Link every registered series to its method, precomputed column and
+   * column of collected results, replacing the previous links.
+   */
+  void link(this LinkedSeries& self,
+            const SeriesMethodRegistry& methods,
+            const SeriesResultsCollector& results_collector,
+            const SeriesResultsCollector& series_columns)
+  {
+    self.results_collector_ = &results_collector;
+    self.slots_.clear();
+    self.slots_.reserve(methods.size());
+    for(const auto& [name, method] : methods) {
+      const auto column = series_columns.results(name);
+      self.slots_.push_back(Slot{&method,
+                                 column.value_or(std::span<const double>{}),
+                                 results_collector.slot(name)});
+    }
+  }
+
+  auto size(this const LinkedSeries& self) noexcept -> std::size_t
+  {
+    return self.slots_.size();
+  }
+
+  auto empty(this const LinkedSeries& self) noexcept -> bool
+  {
+    return self.slots_.empty();
+  }
+
+  void clear(this LinkedSeries& self) noexcept
+  {
+    self.results_collector_ = nullptr;
+    self.slots_.clear();
+  }
+
+  auto method(this const LinkedSeries& self, std::size_t slot) noexcept
+   -> const AnySeriesMethod&
+  {
+    return *self.slots_[slot].method;
+  }
+
+  /**
+   * The precomputed column of the series, or an empty span if it has none.
+   */
+  auto column(this const LinkedSeries& self, std::size_t slot) noexcept
+   -> std::span<const double>
+  {
+    return self.slots_[slot].column;
+  }
+
+  /**
+   * The slot of the series in the results collector it is linked to.
+   */
+  auto results_slot(this const LinkedSeries& self, std::size_t slot) noexcept
+   -> std::optional<std::size_t>
+  {
+    return self.slots_[slot].results_slot;
+  }
+
+  /**
+   * The results collected so far for the series, or an empty span if it has
+   * none.
+   */
+  auto results(this const LinkedSeries& self, std::size_t slot) noexcept
+   -> std::span<const double>
+  {
+    const auto results_slot = self.slots_[slot].results_slot;
+    return results_slot ? self.results_collector_->results(*results_slot)
+                        : std::span<const double>{};
+  }
+
+private:
+  struct Slot {
+    const AnySeriesMethod* method;
+    std::span<const double> column;
+    std::optional<std::size_t> results_slot;
+  };
+
+  const SeriesResultsCollector* results_collector_{nullptr};
+  std::vector<Slot> slots_;
+};
+
+} // namespace pludux
@@ -2,10 +2,15 @@ export module pludux:series;
 
 export import :series_output;
 export import :method_contextable;
+export import :series_kernels;
+export import :series_column;
+export import :incremental_results;
+export import :indicator_cache;
 export import :any_method_context;
 
 export import :series.any_series_method;
 export import :series.series_method_registry;
+export import :linked_series;
 export import :default_method_context;
 
 export import :series.value_method;
@@ -16,6 +21,7 @@ export import :series.lookback_method;
 export import :series.select_output_method;
 export import :series.series_node_method;
 export import :series.series_value_method;
+export import :series.shared_series_method;
 
 export import :series.operators_method;
 export import :series.highest_method;
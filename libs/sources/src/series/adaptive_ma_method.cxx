@@ -3,12 +3,14 @@ module;
 #include <cstddef>
 #include <limits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.adaptive_ma_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 import :series.ohlcv_method;
 import :series.sma_method;
@@ -91,6 +93,30 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const AdaptiveMaMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    switch(self.ma_type_) {
+    case MaMethodType::Sma:
+      return compute_series_column(
+       SmaMethod{self.source_, self.period_}, asset_snapshot, context);
+    case MaMethodType::Ema:
+      return compute_series_column(self.ema_method_, asset_snapshot, context);
+    case MaMethodType::Wma:
+      return compute_series_column(
+       WmaMethod{self.source_, self.period_}, asset_snapshot, context);
+    case MaMethodType::Rma:
+      return compute_series_column(self.rma_method_, asset_snapshot, context);
+    case MaMethodType::Hma:
+      return compute_series_column(
+       HmaMethod{self.source_, self.period_}, asset_snapshot, context);
+    default:
+      return std::vector<ResultType>(
+       asset_snapshot.size(), std::numeric_limits<ResultType>::quiet_NaN());
+    }
+  }
+
   auto ma_type(this const AdaptiveMaMethod& self) noexcept -> MaMethodType
   {
     return self.ma_type_;
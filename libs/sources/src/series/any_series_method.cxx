@@ -1,10 +1,12 @@
 module;
 
-#include <any>
-#include <functional>
+#include <concepts>
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <new>
 #include <type_traits>
-#include <variant>
+#include <utility>
 #include <vector>
 
 export module pludux:series.any_series_method;
@@ -12,65 +14,90 @@ export module pludux:series.any_series_method;
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
+import :indicator_cache;
 
 import :any_method_context;
 
 export namespace pludux {
 
+/**
+ * A type-erased series method. Small methods, such as the values and the
+ * data references at the leaves of a method tree, are stored inline; larger
+ * methods are kept in an immutable heap node that copies share. Every
+ * operation is a single call through a static table of function pointers.
+ */
 class AnySeriesMethod {
 public:
   using ResultType = double;
 
   template<typename UMethod>
-    requires requires {
+    requires(!std::same_as<UMethod, AnySeriesMethod>) && requires {
       typename UMethod::ResultType;
       requires std::convertible_to<typename UMethod::ResultType, ResultType>;
     }
   AnySeriesMethod(UMethod impl)
-  : impl_{std::make_any<UMethod>(std::move(impl))}
-  , invoke_{[](const std::any& impl,
-               AssetSnapshot asset_snapshot,
-               AnySeriesMethodContext context) static
-             -> typename UMethod::ResultType {
-    auto* method = std::any_cast<UMethod>(&impl);
-    return method
-            ? (*method)(asset_snapshot, context)
-            : std::numeric_limits<typename UMethod::ResultType>::quiet_NaN();
-  }}
-  , invoke_with_output_{[](const std::any& impl,
-                           AssetSnapshot asset_snapshot,
-                           SeriesOutput output,
-                           AnySeriesMethodContext context) static
-                         -> typename UMethod::ResultType {
-    auto* method = std::any_cast<UMethod>(&impl);
-    return method
-            ? (*method)(asset_snapshot, output, context)
-            : std::numeric_limits<typename UMethod::ResultType>::quiet_NaN();
-  }}
-  , equals_{[](const std::any& impl,
-               const AnySeriesMethod& other) static -> bool {
-    if(auto other_method = std::any_cast<UMethod>(&other.impl_)) {
-      const auto& method = std::any_cast<UMethod>(impl);
-      return method == *other_method;
+  : vtable_{&vtable_for_<UMethod>}
+  {
+    if constexpr(is_stored_inline_<UMethod>) {
+      ::new(static_cast<void*>(buffer_)) UMethod(std::move(impl));
+    } else {
+      ::new(static_cast<void*>(buffer_))
+       std::shared_ptr<UMethod>(std::make_shared<UMethod>(std::move(impl)));
+    }
+  }
+
+  AnySeriesMethod(const AnySeriesMethod& other)
+  {
+    if(other.vtable_) {
+      other.vtable_->copy(other.buffer_, buffer_);
+      vtable_ = other.vtable_;
+    }
+  }
+
+  AnySeriesMethod(AnySeriesMethod&& other) noexcept
+  {
+    if(other.vtable_) {
+      other.vtable_->move(other.buffer_, buffer_);
+      vtable_ = other.vtable_;
+      other.reset_();
+    }
+  }
+
+  ~AnySeriesMethod()
+  {
+    reset_();
+  }
+
+  auto operator=(const AnySeriesMethod& other) -> AnySeriesMethod&
+  {
+    if(this != &other) {
+      auto copy = other;
+      *this = std::move(copy);
     }
-    return false;
-  }}
-  , not_equals_{
-     [](const std::any& impl, const AnySeriesMethod& other) static -> bool {
-       if(auto other_method = std::any_cast<UMethod>(&other.impl_)) {
-         const auto& method = std::any_cast<UMethod>(impl);
-         return method != *other_method;
-       }
-       return true;
-     }}
+    return *this;
+  }
+
+  auto operator=(AnySeriesMethod&& other) noexcept -> AnySeriesMethod&
   {
+    if(this != &other) {
+      reset_();
+      if(other.vtable_) {
+        other.vtable_->move(other.buffer_, buffer_);
+        vtable_ = other.vtable_;
+        other.reset_();
+      }
+    }
+    return *this;
   }
 
   auto operator()(this const AnySeriesMethod& self,
                   AssetSnapshot asset_snapshot,
                   AnySeriesMethodContext context) -> ResultType
   {
-    return self.invoke_(self.impl_, asset_snapshot, context);
+    return self.vtable_
+            ? self.vtable_->invoke(self.buffer_, asset_snapshot, context)
+            : std::numeric_limits<ResultType>::quiet_NaN();
   }
 
   auto operator()(this const AnySeriesMethod& self,
@@ -78,51 +105,210 @@ public:
                   SeriesOutput output,
                   AnySeriesMethodContext context) -> ResultType
   {
-    return self.invoke_with_output_(
-     self.impl_, asset_snapshot, output, context);
+    return self.vtable_ ? self.vtable_->invoke_with_output(
+                           self.buffer_, asset_snapshot, output, context)
+                        : std::numeric_limits<ResultType>::quiet_NaN();
+  }
+
+  auto compute_column(this const AnySeriesMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      AnySeriesMethodContext context) -> std::vector<ResultType>
+  {
+    if(!self.vtable_) {
+      return std::vector<ResultType>(
+       asset_snapshot.size(), std::numeric_limits<ResultType>::quiet_NaN());
+    }
+
+    return self.vtable_->compute_column(self.buffer_, asset_snapshot, context);
+  }
+
+  auto compute_column(this const AnySeriesMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      SeriesOutput output,
+                      AnySeriesMethodContext context) -> std::vector<ResultType>
+  {
+    if(!self.vtable_) {
+      return std::vector<ResultType>(
+       asset_snapshot.size(), std::numeric_limits<ResultType>::quiet_NaN());
+    }
+
+    return self.vtable_->compute_column_with_output(
+     self.buffer_, asset_snapshot, output, context);
+  }
+
+  auto hash(this const AnySeriesMethod& self) noexcept -> std::size_t
+  {
+    return self.vtable_ ? self.vtable_->hash(self.buffer_) : 0;
   }
 
   auto operator==(this const AnySeriesMethod& self,
                   const AnySeriesMethod& other) noexcept -> bool
   {
-    return self.equals_(self.impl_, other);
+    if(self.vtable_ != other.vtable_) {
+      return false;
+    }
+
+    return !self.vtable_ || self.vtable_->equals(self.buffer_, other.buffer_);
   }
 
   auto operator!=(this const AnySeriesMethod& self,
                   const AnySeriesMethod& other) noexcept -> bool
   {
-    return self.not_equals_(self.impl_, other);
+    return !(self == other);
   }
 
   template<typename UMethod>
   friend auto series_method_cast(const AnySeriesMethod& method) noexcept
    -> const UMethod*
   {
-    return std::any_cast<const UMethod>(&method.impl_);
+    if(method.vtable_ != &vtable_for_<UMethod>) {
+      return nullptr;
+    }
+
+    return get_<UMethod>(method.buffer_);
   }
 
+  /**
+   * A method kept in a shared heap node is copied first, so changing it does
+   * not change the copies of this method.
+   */
   template<typename UMethod>
   friend auto series_method_cast(AnySeriesMethod& method) noexcept -> UMethod*
   {
-    return std::any_cast<UMethod>(&method.impl_);
+    if(method.vtable_ != &vtable_for_<UMethod>) {
+      return nullptr;
+    }
+
+    if constexpr(is_stored_inline_<UMethod>) {
+      return std::launder(reinterpret_cast<UMethod*>(method.buffer_));
+    } else {
+      auto& node = *std::launder(
+       reinterpret_cast<std::shared_ptr<UMethod>*>(method.buffer_));
+      if(node.use_count() > 1) {
+        node = std::make_shared<UMethod>(*node);
+      }
+      return node.get();
+    }
   }
 
 private:
-  std::any impl_;
+  static constexpr auto inline_capacity_ = 5 * sizeof(void*);
+
+  template<typename UMethod>
+  static constexpr auto is_stored_inline_ =
+   sizeof(UMethod) <= inline_capacity_ &&
+   alignof(UMethod) <= alignof(std::max_align_t) &&
+   std::is_nothrow_move_constructible_v<UMethod>;
+
+  struct VTable {
+    auto (*invoke)(const std::byte*, AssetSnapshot, AnySeriesMethodContext)
+     -> ResultType;
+
+    auto (*invoke_with_output)(const std::byte*,
+                               AssetSnapshot,
+                               SeriesOutput,
+                               AnySeriesMethodContext) -> ResultType;
+
+    auto (*compute_column)(const std::byte*,
+                           AssetSnapshot,
+                           AnySeriesMethodContext) -> std::vector<ResultType>;
+
+    auto (*compute_column_with_output)(const std::byte*,
+                                       AssetSnapshot,
+                                       SeriesOutput,
+                                       AnySeriesMethodContext)
+     -> std::vector<ResultType>;
 
-  std::function<
-   auto(const std::any&, AssetSnapshot, AnySeriesMethodContext)->ResultType>
-   invoke_;
+    auto (*hash)(const std::byte*) noexcept -> std::size_t;
 
-  std::function<
-   auto(const std::any&, AssetSnapshot, SeriesOutput, AnySeriesMethodContext)
-    ->ResultType>
-   invoke_with_output_;
+    auto (*equals)(const std::byte*, const std::byte*) noexcept -> bool;
 
-  std::function<auto(const std::any&, const AnySeriesMethod&)->bool> equals_;
+    void (*copy)(const std::byte*, std::byte*);
 
-  std::function<auto(const std::any&, const AnySeriesMethod&)->bool>
-   not_equals_;
+    void (*move)(std::byte*, std::byte*) noexcept;
+
+    void (*destroy)(std::byte*) noexcept;
+  };
+
+  template<typename UMethod>
+  static auto get_(const std::byte* buffer) noexcept -> const UMethod*
+  {
+    if constexpr(is_stored_inline_<UMethod>) {
+      return std::launder(reinterpret_cast<const UMethod*>(buffer));
+    } else {
+      return std::launder(
+              reinterpret_cast<const std::shared_ptr<UMethod>*>(buffer))
+       ->get();
+    }
+  }
+
+  template<typename UMethod>
+  using StoredType_ = std::conditional_t<is_stored_inline_<UMethod>,
+                                         UMethod,
+                                         std::shared_ptr<UMethod>>;
+
+  template<typename UMethod>
+  static constexpr auto vtable_for_ = VTable{
+   .invoke = [](const std::byte* buffer,
+                AssetSnapshot asset_snapshot,
+                AnySeriesMethodContext context) -> ResultType {
+     return (*get_<UMethod>(buffer))(asset_snapshot, context);
+   },
+   .invoke_with_output = [](const std::byte* buffer,
+                            AssetSnapshot asset_snapshot,
+                            SeriesOutput output,
+                            AnySeriesMethodContext context) -> ResultType {
+     return (*get_<UMethod>(buffer))(asset_snapshot, output, context);
+   },
+   .compute_column = [](const std::byte* buffer,
+                        AssetSnapshot asset_snapshot,
+                        AnySeriesMethodContext context)
+    -> std::vector<ResultType> {
+     return compute_series_column(
+      *get_<UMethod>(buffer), asset_snapshot, context);
+   },
+   .compute_column_with_output = [](const std::byte* buffer,
+                                    AssetSnapshot asset_snapshot,
+                                    SeriesOutput output,
+                                    AnySeriesMethodContext context)
+    -> std::vector<ResultType> {
+     return compute_series_column(
+      *get_<UMethod>(buffer), asset_snapshot, output, context);
+   },
+   .hash = [](const std::byte* buffer) noexcept -> std::size_t {
+     return series_method_hash(*get_<UMethod>(buffer));
+   },
+   .equals = [](const std::byte* buffer,
+                const std::byte* other_buffer) noexcept -> bool {
+     const auto* method = get_<UMethod>(buffer);
+     const auto* other_method = get_<UMethod>(other_buffer);
+     return method == other_method || *method == *other_method;
+   },
+   .copy = [](const std::byte* buffer, std::byte* other_buffer) {
+     using StoredType = StoredType_<UMethod>;
+     ::new(static_cast<void*>(other_buffer))
+      StoredType(*std::launder(reinterpret_cast<const StoredType*>(buffer)));
+   },
+   .move = [](std::byte* buffer, std::byte* other_buffer) noexcept {
+     using StoredType = StoredType_<UMethod>;
+     ::new(static_cast<void*>(other_buffer)) StoredType(
+      std::move(*std::launder(reinterpret_cast<StoredType*>(buffer))));
+   },
+   .destroy = [](std::byte* buffer) noexcept {
+     using StoredType = StoredType_<UMethod>;
+     std::launder(reinterpret_cast<StoredType*>(buffer))->~StoredType();
+   }};
+
+  alignas(std::max_align_t) std::byte buffer_[inline_capacity_];
+  const VTable* vtable_{nullptr};
+
+  void reset_(this AnySeriesMethod& self) noexcept
+  {
+    if(self.vtable_) {
+      self.vtable_->destroy(self.buffer_);
+      self.vtable_ = nullptr;
+    }
+  }
 };
 
-} // namespace pludux
\ No newline at end of file
+} // namespace pludux
@@ -6,12 +6,14 @@ module;
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.bb_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 import :series.adaptive_ma_method;
 import :series.ohlcv_method;
@@ -78,6 +80,63 @@ public:
     }
   }
 
+  auto compute_column(this const BbMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return self.compute_column(
+     asset_snapshot, SeriesOutput::MiddleBand, context);
+  }
+
+  /**
+   * The moving average and the standard deviation come out of one pass of
+   * the rolling moments over the source column; a middle band other than
+   * the SMA is computed by its own method.
+   */
+  auto compute_column(this const BbMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      SeriesOutput output,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto& ma_source = self.ma_method_.source();
+    const auto ma_period = self.ma_method_.period();
+
+    const auto sources =
+     compute_series_column(ma_source, asset_snapshot, context);
+    auto [middles, stddevs] = rolling_moments_columns(sources, ma_period);
+    if(self.ma_method_.ma_type() != MaMethodType::Sma) {
+      middles = compute_series_column(self.ma_method_, asset_snapshot, context);
+    }
+
+    // The window reaches before the history starts.
+    const auto size = stddevs.size();
+    const auto stddev_method = StddevMethod{ma_source, ma_period};
+    for(auto i = 0uz; i + 1 < ma_period && i < size; ++i) {
+      stddevs[i] = stddev_method(asset_snapshot[size - 1 - i], context);
+    }
+
+    auto results = std::vector<ResultType>(size);
+    for(auto i = 0uz; i < size; ++i) {
+      const auto std_dev_scaled = stddevs[i] * self.stddev_;
+
+      switch(output) {
+      case SeriesOutput::MiddleBand:
+        results[i] = middles[i];
+        break;
+      case SeriesOutput::UpperBand:
+        results[i] = middles[i] + std_dev_scaled;
+        break;
+      case SeriesOutput::LowerBand:
+        results[i] = middles[i] - std_dev_scaled;
+        break;
+      default:
+        results[i] = std::numeric_limits<ResultType>::quiet_NaN();
+      }
+    }
+
+    return results;
+  }
+
   auto ma_type(this const BbMethod& self) noexcept -> MaMethodType
   {
     return self.ma_method_.ma_type();
@@ -2,7 +2,9 @@ module;
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iterator>
+#include <span>
 #include <vector>
 
 export module pludux:series.change_method;
@@ -10,6 +12,8 @@ export module pludux:series.change_method;
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
+import :series_kernels;
 
 import :series.ohlcv_method;
 
@@ -51,6 +55,30 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const ChangeMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    const auto size = sources.size();
+
+    auto results = std::vector<ResultType>(size);
+    if(size == 0) {
+      return results;
+    }
+
+    // The oldest bar is compared with the bar before the history starts.
+    results[0] = sources[0] - self.source_(asset_snapshot[size], context);
+
+    const auto values = std::span<const double>{sources};
+    transform_columns(values.subspan(1),
+                      values.first(size - 1),
+                      std::minus<>{},
+                      std::span{results}.subspan(1));
+    return results;
+  }
+
   auto source(this const ChangeMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
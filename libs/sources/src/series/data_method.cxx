@@ -7,12 +7,14 @@ module;
 #include <limits>
 #include <string>
 #include <variant>
+#include <vector>
 
 export module pludux:series.data_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 export namespace pludux {
 
@@ -44,6 +46,13 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const DataMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return series_column(asset_snapshot.series(self.field_), asset_snapshot);
+  }
+
   auto field(this const DataMethod& self) -> const std::string&
   {
     return self.field_;
@@ -1,16 +1,19 @@
 module;
 
-#include <algorithm>
-#include <cassert>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.highest_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :incremental_results;
+import :indicator_cache;
+import :series_column;
 
 import :series.ohlcv_method;
 
@@ -39,18 +42,38 @@ public:
 
   auto operator==(const HighestMethod& other) const noexcept -> bool = default;
 
+  /**
+   * With an indicator cache in the context the window is carried from bar to
+   * bar, so the next bar costs O(1) amortized; otherwise the window of the
+   * snapshot is scanned from its oldest bar.
+   */
   auto operator()(this const HighestMethod& self,
                   AssetSnapshot asset_snapshot,
                   MethodContextable auto context) noexcept -> ResultType
   {
+    if constexpr(requires { context.indicator_cache(); }) {
+      if(auto* indicator_cache = context.indicator_cache();
+         indicator_cache != nullptr) {
+        auto& incremental_results = indicator_cache->results(self);
+        return incremental_results.get(
+         asset_snapshot,
+         [&](const std::vector<double>&,
+             AssetSnapshot bar_snapshot) -> ResultType {
+           auto& window =
+            incremental_results.state<WindowType_>(self.period_);
+           return window.push(self.source_(bar_snapshot, context));
+         });
+      }
+    }
+
     if(asset_snapshot.size() < self.period_) {
       return std::numeric_limits<ResultType>::quiet_NaN();
     }
 
-    auto highest = std::numeric_limits<ResultType>::min();
-    for(auto i = 0uz; i < self.period_; ++i) {
-      const auto value = self.source_(asset_snapshot[i], context);
-      highest = std::max(highest, value);
+    auto window = WindowType_{self.period_};
+    auto highest = std::numeric_limits<ResultType>::quiet_NaN();
+    for(auto i = self.period_; i > 0; --i) {
+      highest = window.push(self.source_(asset_snapshot[i - 1], context));
     }
     return highest;
   }
@@ -63,6 +86,20 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const HighestMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    return rolling_extremum_column(sources, self.period_, std::greater<>{});
+  }
+
+  auto hash(this const HighestMethod& self) noexcept -> std::size_t
+  {
+    return series_method_hash(self, self.period_, self.source_);
+  }
+
   auto source(this const HighestMethod& self) -> const TSourceMethod&
   {
     return self.source_;
@@ -84,6 +121,8 @@ public:
   }
 
 private:
+  using WindowType_ = RollingExtremum<std::greater<>>;
+
   TSourceMethod source_;
   std::size_t period_;
 };
@@ -4,12 +4,15 @@ module;
 #include <cstddef>
 #include <limits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.hma_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :indicator_cache;
+import :series_column;
 
 import :series.value_method;
 import :series.wma_method;
@@ -40,6 +43,10 @@ public:
 
   auto operator==(const HmaMethod& other) const noexcept -> bool = default;
 
+  /**
+   * With an indicator cache in the context every WMA of the graph carries its
+   * window sums from bar to bar, so the next bar costs O(1).
+   */
   auto operator()(this const HmaMethod& self,
                   AssetSnapshot asset_snapshot,
                   MethodContextable auto context) noexcept -> ResultType
@@ -65,6 +72,33 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  /**
+   * The two WMAs of the source are computed over its column once, and their
+   * difference is piped as a column into the final WMA.
+   */
+  auto compute_column(this const HmaMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    const auto half_wmas = weighted_mean_column(sources, self.period_ / 2);
+    const auto wmas = weighted_mean_column(sources, self.period_);
+
+    auto diffs = std::vector<ResultType>(sources.size());
+    for(auto i = 0uz; i < sources.size(); ++i) {
+      diffs[i] = 2.0 * half_wmas[i] - wmas[i];
+    }
+
+    return weighted_mean_column(
+     diffs, static_cast<std::size_t>(std::sqrt(self.period_)));
+  }
+
+  auto hash(this const HmaMethod& self) noexcept -> std::size_t
+  {
+    return series_method_hash(self, self.period_, self.source_);
+  }
+
   auto source(this const HmaMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
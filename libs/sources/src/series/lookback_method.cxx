@@ -3,12 +3,14 @@ module;
 #include <cstddef>
 #include <limits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.lookback_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 export namespace pludux {
 
@@ -54,6 +56,24 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const LookbackMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    auto results = compute_series_column(self.source_, asset_snapshot, context);
+
+    const auto size = results.size();
+    for(auto ii = size; ii > 0; --ii) {
+      const auto i = ii - 1;
+      results[i] = i >= self.period_
+                    ? results[i - self.period_]
+                    : self.source_(asset_snapshot[size - 1 - i + self.period_],
+                                   context);
+    }
+
+    return results;
+  }
+
   auto source(this const LookbackMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
@@ -1,12 +1,14 @@
 module;
 
 #include <functional>
+#include <vector>
 
 export module pludux:series.ohlcv_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 namespace pludux {
 
@@ -44,6 +46,13 @@ public:
   {
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
+
+  auto compute_column(this OpenMethod self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return series_column(asset_snapshot.opens(), asset_snapshot);
+  }
 };
 
 export struct HighMethod : OhlcvMethod<HighMethod> {
@@ -64,6 +73,13 @@ public:
   {
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
+
+  auto compute_column(this HighMethod self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return series_column(asset_snapshot.highs(), asset_snapshot);
+  }
 };
 
 export struct LowMethod : OhlcvMethod<LowMethod> {
@@ -84,6 +100,13 @@ public:
   {
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
+
+  auto compute_column(this LowMethod self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return series_column(asset_snapshot.lows(), asset_snapshot);
+  }
 };
 
 export struct CloseMethod : OhlcvMethod<CloseMethod> {
@@ -104,6 +127,13 @@ public:
   {
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
+
+  auto compute_column(this CloseMethod self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return series_column(asset_snapshot.closes(), asset_snapshot);
+  }
 };
 
 export struct VolumeMethod : OhlcvMethod<VolumeMethod> {
@@ -124,6 +154,13 @@ public:
   {
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
+
+  auto compute_column(this VolumeMethod self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return series_column(asset_snapshot.volumes(), asset_snapshot);
+  }
 };
 
 } // namespace pludux
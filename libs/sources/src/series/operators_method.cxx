@@ -5,14 +5,18 @@ module;
 #include <cstddef>
 #include <functional>
 #include <limits>
+#include <span>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.operators_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
+import :series_kernels;
 
 namespace pludux {
 
@@ -52,6 +56,20 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const BinaryOperatorMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto operand1_results =
+     compute_series_column(self.operand1_, asset_snapshot, context);
+    const auto operand2_results =
+     compute_series_column(self.operand2_, asset_snapshot, context);
+
+    auto results = std::vector<ResultType>(operand1_results.size());
+    transform_columns(operand1_results, operand2_results, TBinaryFn{}, results);
+    return results;
+  }
+
   auto operand1(this const BinaryOperatorMethod& self) noexcept
    -> const TMethodOp1&
   {
@@ -129,6 +147,15 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const UnaryOperatorMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    auto results = compute_series_column(self.operand_, asset_snapshot, context);
+    transform_column(results, TUnaryFn{}, results);
+    return results;
+  }
+
   auto operand(this const UnaryOperatorMethod& self) noexcept
    -> const TMethodOp&
   {
@@ -270,6 +297,17 @@ struct Absolute<void> {
   }
 };
 
+/**
+ * The column of `AbsMethod`, found by argument-dependent lookup from
+ * `UnaryOperatorMethod`.
+ */
+void transform_column(std::span<const double> values,
+                      Absolute<>,
+                      std::span<double> results) noexcept
+{
+  abs_column(values, results);
+}
+
 export template<typename TMethodOp>
 class AbsMethod : public UnaryOperatorMethod<AbsMethod, Absolute<>, TMethodOp> {
 public:
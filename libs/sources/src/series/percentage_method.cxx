@@ -1,13 +1,17 @@
 module;
 
 #include <limits>
+#include <span>
 #include <utility>
+#include <vector>
 
 export module pludux:series.percentage_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
+import :series_kernels;
 
 import :series.ohlcv_method;
 
@@ -54,6 +58,15 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const PercentageMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    auto results = compute_series_column(self.base_, asset_snapshot, context);
+    scale_column(results, self.percent() / 100.0, results);
+    return results;
+  }
+
   auto base(this const PercentageMethod& self) noexcept -> const TMethod&
   {
     return self.base_;
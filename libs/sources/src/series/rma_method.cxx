@@ -11,6 +11,9 @@ export module pludux:series.rma_method;
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :incremental_results;
+import :indicator_cache;
+import :series_column;
 
 import :series.sma_method;
 import :series.ohlcv_method;
@@ -38,33 +41,42 @@ public:
   {
   }
 
-  auto operator==(const RmaMethod& other) const noexcept -> bool = default;
+  auto operator==(const RmaMethod& other) const noexcept -> bool
+  {
+    return source_ == other.source_ && period_ == other.period_;
+  }
 
   auto operator()(this const RmaMethod& self,
                   AssetSnapshot asset_snapshot,
                   MethodContextable auto context) noexcept -> ResultType
   {
-    const auto asset_size = asset_snapshot.size();
     const auto alpha = 1.0 / self.period_;
-    const auto sma_index = asset_size - self.period_;
-    auto result = std::numeric_limits<ResultType>::quiet_NaN();
-    for(auto ii = asset_size; ii > 0; --ii) {
-      const auto i = ii - 1;
-      if(i > sma_index) {
-        continue;
+    const auto compute_next = [&](const std::vector<double>& results,
+                                  AssetSnapshot bar_snapshot) -> ResultType {
+      if(results.size() + 1 < self.period_) {
+        return std::numeric_limits<ResultType>::quiet_NaN();
       }
 
-      if(std::isnan(result)) {
-        result =
-         SmaMethod{self.source_, self.period_}(asset_snapshot[i], context);
-        continue;
+      const auto previous = results.empty()
+                             ? std::numeric_limits<ResultType>::quiet_NaN()
+                             : results.back();
+      if(std::isnan(previous)) {
+        return SmaMethod{self.source_, self.period_}(bar_snapshot, context);
       }
 
-      const auto source_value = self.source_(asset_snapshot[i], context);
-      result = source_value * alpha + result * (1 - alpha);
+      const auto source_value = self.source_(bar_snapshot, context);
+      return source_value * alpha + previous * (1 - alpha);
+    };
+
+    if constexpr(requires { context.indicator_cache(); }) {
+      if(auto* indicator_cache = context.indicator_cache();
+         indicator_cache != nullptr) {
+        return indicator_cache->results(self).get(asset_snapshot,
+                                                  compute_next);
+      }
     }
 
-    return result;
+    return self.results_.get(asset_snapshot, compute_next);
   }
 
   auto operator()(this const RmaMethod& self,
@@ -75,6 +87,21 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const RmaMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    return exponential_smoothing_column(
+     sources, self.period_, 1.0 / self.period_);
+  }
+
+  auto hash(this const RmaMethod& self) noexcept -> std::size_t
+  {
+    return series_method_hash(self, self.period_, self.source_);
+  }
+
   auto source(this const RmaMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
@@ -83,6 +110,7 @@ public:
   void source(this RmaMethod& self, TSourceMethod source) noexcept
   {
     self.source_ = std::move(source);
+    self.results_.clear();
   }
 
   auto period(this const RmaMethod& self) noexcept -> std::size_t
@@ -93,11 +121,15 @@ public:
   void period(this RmaMethod& self, std::size_t period) noexcept
   {
     self.period_ = period;
+    self.results_.clear();
   }
 
 private:
   TSourceMethod source_;
   std::size_t period_;
+
+  // The results for contexts without an indicator cache.
+  LocalIncrementalResults results_;
 };
 
 } // namespace pludux
@@ -1,14 +1,19 @@
 module;
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <span>
 #include <utility>
+#include <vector>
 
 export module pludux:series.roc_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
+import :series_kernels;
 
 import :series.ohlcv_method;
 
@@ -60,6 +65,29 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const RocMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    const auto size = sources.size();
+
+    auto results = std::vector<ResultType>(size);
+
+    // The end of the period is before the history starts.
+    const auto head_size = std::min(self.period_, size);
+    for(auto i = 0uz; i < head_size; ++i) {
+      results[i] = self(asset_snapshot[size - 1 - i], context);
+    }
+
+    const auto values = std::span<const double>{sources};
+    percent_change_columns(values.subspan(head_size),
+                           values.first(size - head_size),
+                           std::span{results}.subspan(head_size));
+    return results;
+  }
+
   auto source(this const RocMethod& self) noexcept -> TSourceMethod
   {
     return self.source_;
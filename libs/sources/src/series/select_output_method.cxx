@@ -1,12 +1,14 @@
 module;
 
 #include <utility>
+#include <vector>
 
 export module pludux:series.select_output_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 export namespace pludux {
 
@@ -48,6 +50,22 @@ public:
     return self.source_(asset_snapshot, output, context);
   }
 
+  auto compute_column(this const SelectOutputMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return compute_series_column(
+     self.source_, asset_snapshot, self.output_, context);
+  }
+
+  auto compute_column(this const SelectOutputMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      SeriesOutput output,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return compute_series_column(self.source_, asset_snapshot, output, context);
+  }
+
   auto source(this const SelectOutputMethod& self) noexcept
    -> const TSourceMethod&
   {
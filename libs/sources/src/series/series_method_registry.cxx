@@ -2,6 +2,7 @@ module;
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <expected>
 #include <format>
 #include <iterator>
@@ -176,6 +177,27 @@ public:
     return self.methods_.contains(name);
   }
 
+  /**
+   * The slot of a method is its position in the registry. Series nodes linked
+   * to a slot reach the method without looking up its name.
+   */
+  auto slot(this const SeriesMethodRegistry& self, const std::string& name)
+   -> std::optional<std::size_t>
+  {
+    const auto it = std::ranges::find(self.ordered_names_, name);
+    if(it == self.ordered_names_.end()) {
+      return std::nullopt;
+    }
+    return static_cast<std::size_t>(it - self.ordered_names_.begin());
+  }
+
+  auto name(this const SeriesMethodRegistry& self, std::size_t slot) noexcept
+   -> const std::string&
+  {
+    assert(slot < self.ordered_names_.size());
+    return self.ordered_names_[slot];
+  }
+
   auto remove(this SeriesMethodRegistry& self, const std::string& name) noexcept
    -> std::optional<AnySeriesMethod>
   {
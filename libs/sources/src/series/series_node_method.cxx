@@ -1,5 +1,6 @@
 module;
 
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <string>
@@ -18,13 +19,27 @@ class SeriesNodeMethod {
 public:
   using ResultType = double;
 
+  static constexpr auto unlinked_slot = std::numeric_limits<std::size_t>::max();
+
   SeriesNodeMethod(std::string name)
+  : SeriesNodeMethod{std::move(name), unlinked_slot}
+  {
+  }
+
+  /**
+   * A node linked to the slot of its series in the registry, which contexts
+   * that support slots use instead of looking up the name.
+   */
+  SeriesNodeMethod(std::string name, std::size_t slot)
   : name_{std::move(name)}
+  , slot_{slot}
   {
   }
 
-  auto operator==(const SeriesNodeMethod& other) const noexcept
-   -> bool = default;
+  auto operator==(const SeriesNodeMethod& other) const noexcept -> bool
+  {
+    return name_ == other.name_;
+  }
 
   auto operator()(this const SeriesNodeMethod& self,
                   AssetSnapshot asset_snapshot,
@@ -33,6 +48,14 @@ public:
     if constexpr(std::is_same_v<std::monostate, decltype(context)>) {
       return std::numeric_limits<ResultType>::quiet_NaN();
     } else {
+      if constexpr(requires {
+                     context.call_series_slot(self.slot_, asset_snapshot);
+                   }) {
+        if(self.slot_ != unlinked_slot) {
+          return context.call_series_slot(self.slot_, asset_snapshot);
+        }
+      }
+
       return context.call_series_method(self.name(), asset_snapshot);
     }
   }
@@ -45,6 +68,16 @@ public:
     if constexpr(std::is_same_v<std::monostate, decltype(context)>) {
       return std::numeric_limits<ResultType>::quiet_NaN();
     } else {
+      if constexpr(requires {
+                     context.call_series_slot(
+                      self.slot_, asset_snapshot, output_name);
+                   }) {
+        if(self.slot_ != unlinked_slot) {
+          return context.call_series_slot(
+           self.slot_, asset_snapshot, output_name);
+        }
+      }
+
       return context.call_series_method(
        self.name(), asset_snapshot, output_name);
     }
@@ -59,10 +92,17 @@ public:
   void name(this SeriesNodeMethod& self, std::string new_name) noexcept
   {
     self.name_ = std::move(new_name);
+    self.slot_ = unlinked_slot;
+  }
+
+  auto slot(this const SeriesNodeMethod& self) noexcept -> std::size_t
+  {
+    return self.slot_;
   }
 
 private:
   std::string name_{};
+  std::size_t slot_{unlinked_slot};
 };
 
 } // namespace pludux
\ No newline at end of file
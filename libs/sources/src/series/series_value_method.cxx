@@ -1,5 +1,6 @@
 module;
 
+#include <cstddef>
 #include <limits>
 #include <string>
 #include <utility>
@@ -17,13 +18,27 @@ class SeriesValueMethod {
 public:
   using ResultType = double;
 
+  static constexpr auto unlinked_slot = std::numeric_limits<std::size_t>::max();
+
   SeriesValueMethod(std::string name)
+  : SeriesValueMethod{std::move(name), unlinked_slot}
+  {
+  }
+
+  /**
+   * A value linked to the slot of its series in the registry, which contexts
+   * that support slots use instead of looking up the name.
+   */
+  SeriesValueMethod(std::string name, std::size_t slot)
   : name_{std::move(name)}
+  , slot_{slot}
   {
   }
 
-  auto operator==(const SeriesValueMethod& other) const noexcept
-   -> bool = default;
+  auto operator==(const SeriesValueMethod& other) const noexcept -> bool
+  {
+    return name_ == other.name_;
+  }
 
   auto operator()(this const SeriesValueMethod& self,
                   AssetSnapshot asset_snapshot,
@@ -34,6 +49,14 @@ public:
     }
 
     const auto result_index = asset_snapshot.index();
+    if constexpr(requires {
+                   context.get_series_slot_result(self.slot_, result_index);
+                 }) {
+      if(self.slot_ != unlinked_slot) {
+        return context.get_series_slot_result(self.slot_, result_index);
+      }
+    }
+
     return context.get_series_result(self.name(), result_index);
   }
 
@@ -53,10 +76,17 @@ public:
   void name(this SeriesValueMethod& self, std::string new_name) noexcept
   {
     self.name_ = std::move(new_name);
+    self.slot_ = unlinked_slot;
+  }
+
+  auto slot(this const SeriesValueMethod& self) noexcept -> std::size_t
+  {
+    return self.slot_;
   }
 
 private:
   std::string name_{};
+  std::size_t slot_{unlinked_slot};
 };
 
 } // namespace pludux
\ No newline at end of file
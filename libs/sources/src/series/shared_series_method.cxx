@@ -0,0 +1,125 @@
+module;
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+export module pludux:series.shared_series_method;
+
+import :asset_snapshot;
+import :method_contextable;
+import :series_output;
+import :incremental_results;
+import :indicator_cache;
+import :series_column;
+
+import :series.any_series_method;
+
+export namespace pludux {
+
+/**
+ * A node of the method graph that is used in several places. Its results and
+ * its columns are kept in the indicator cache of the context, so the wrapped
+ * method is evaluated once per bar, or once per run for a column, however
+ * many methods read from it.
+ */
+template<typename TMethod = AnySeriesMethod>
+class SharedSeriesMethod {
+public:
+  using ResultType = typename TMethod::ResultType;
+
+  explicit SharedSeriesMethod(TMethod method)
+  : method_{std::move(method)}
+  {
+  }
+
+  auto operator==(const SharedSeriesMethod& other) const noexcept
+   -> bool = default;
+
+  auto operator()(this const SharedSeriesMethod& self,
+                  AssetSnapshot asset_snapshot,
+                  MethodContextable auto context) noexcept -> ResultType
+  {
+    if constexpr(requires { context.indicator_cache(); }) {
+      if(auto* indicator_cache = context.indicator_cache();
+         indicator_cache != nullptr) {
+        return indicator_cache->results(self).get(
+         asset_snapshot,
+         [&](const std::vector<double>&,
+             AssetSnapshot bar_snapshot) -> ResultType {
+           return self.method_(bar_snapshot, context);
+         });
+      }
+    }
+
+    return self.method_(asset_snapshot, context);
+  }
+
+  auto operator()(this const SharedSeriesMethod& self,
+                  AssetSnapshot asset_snapshot,
+                  SeriesOutput output,
+                  MethodContextable auto context) noexcept -> ResultType
+  {
+    return self.method_(asset_snapshot, output, context);
+  }
+
+  auto compute_column(this const SharedSeriesMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return self.cached_column_(asset_snapshot, std::nullopt, context, [&] {
+      return compute_series_column(self.method_, asset_snapshot, context);
+    });
+  }
+
+  auto compute_column(this const SharedSeriesMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      SeriesOutput output,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return self.cached_column_(asset_snapshot, output, context, [&] {
+      return compute_series_column(
+       self.method_, asset_snapshot, output, context);
+    });
+  }
+
+  auto hash(this const SharedSeriesMethod& self) noexcept -> std::size_t
+  {
+    return series_method_hash(self, self.method_);
+  }
+
+  auto method(this const SharedSeriesMethod& self) noexcept -> const TMethod&
+  {
+    return self.method_;
+  }
+
+private:
+  TMethod method_;
+
+  /**
+   * The column of the node kept in the indicator cache of the context, so it
+   * is computed once per run however many methods read it. The bars asked
+   * for are copied out of the cache, since columns are returned by value.
+   */
+  auto cached_column_(this const SharedSeriesMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      std::optional<SeriesOutput> output,
+                      MethodContextable auto context,
+                      std::invocable auto compute) -> std::vector<ResultType>
+  {
+    if constexpr(requires { context.indicator_cache(); }) {
+      if(auto* indicator_cache = context.indicator_cache();
+         indicator_cache != nullptr) {
+        const auto column =
+         indicator_cache->column(self, output, asset_snapshot, compute);
+        return std::vector<ResultType>(column.begin(), column.end());
+      }
+    }
+
+    return compute();
+  }
+};
+
+} // namespace pludux
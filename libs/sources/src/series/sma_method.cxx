@@ -3,12 +3,14 @@ module;
 #include <cstddef>
 #include <limits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.sma_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 import :series.ohlcv_method;
 
@@ -62,6 +64,15 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const SmaMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    return rolling_mean_column(sources, self.period_);
+  }
+
   auto source(this const SmaMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
@@ -6,12 +6,16 @@ module;
 #include <limits>
 #include <ranges>
 #include <utility>
+#include <vector>
 
 export module pludux:series.stddev_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :incremental_results;
+import :indicator_cache;
+import :series_column;
 
 import :series.ohlcv_method;
 
@@ -40,26 +44,37 @@ public:
 
   auto operator==(const StddevMethod& other) const noexcept -> bool = default;
 
+  /**
+   * With an indicator cache in the context the window is carried from bar to
+   * bar, so the next bar costs O(1) amortized; otherwise the window of the
+   * snapshot is scanned.
+   */
   auto operator()(this const StddevMethod& self,
                   AssetSnapshot asset_snapshot,
                   MethodContextable auto context) noexcept -> ResultType
   {
-    const auto sum = std::ranges::fold_left(
-     std::views::iota(0uz, self.period_), ResultType{0}, [&](auto acc, auto i) {
-       return acc + self.source_(asset_snapshot[i], context);
-     });
-    const auto mean = sum / static_cast<ResultType>(self.period_);
-
-    auto sum_squared_diff = ResultType{0};
-    for(auto i = 0uz; i < self.period_; ++i) {
-      const auto diff = self.source_(asset_snapshot[i], context) - mean;
-      sum_squared_diff += diff * diff;
+    if constexpr(requires { context.indicator_cache(); }) {
+      if(auto* indicator_cache = context.indicator_cache();
+         indicator_cache != nullptr) {
+        auto& incremental_results = indicator_cache->results(self);
+        return incremental_results.get(
+         asset_snapshot,
+         [&](const std::vector<double>& results,
+             AssetSnapshot bar_snapshot) -> ResultType {
+           auto& window =
+            incremental_results.state<RollingMoments>(self.period_);
+           window.push(self.source_(bar_snapshot, context));
+
+           // The window reaches before the history starts.
+           if(results.size() + 1 < self.period_) {
+             return self.window_stddev_(bar_snapshot, context);
+           }
+           return window.stddev();
+         });
+      }
     }
 
-    const auto variance =
-     sum_squared_diff / static_cast<ResultType>(self.period_);
-    const auto stddev = std::sqrt(variance);
-    return stddev;
+    return self.window_stddev_(asset_snapshot, context);
   }
 
   auto operator()(this const StddevMethod& self,
@@ -70,6 +85,28 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const StddevMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    auto results = rolling_moments_columns(sources, self.period_).stddevs;
+
+    // The window reaches before the history starts.
+    const auto size = results.size();
+    for(auto i = 0uz; i + 1 < self.period_ && i < size; ++i) {
+      results[i] = self.window_stddev_(asset_snapshot[size - 1 - i], context);
+    }
+
+    return results;
+  }
+
+  auto hash(this const StddevMethod& self) noexcept -> std::size_t
+  {
+    return series_method_hash(self, self.period_, self.source_);
+  }
+
   auto source(this const StddevMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
@@ -93,6 +130,28 @@ public:
 private:
   TSourceMethod source_;
   std::size_t period_;
+
+  auto window_stddev_(this const StddevMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) noexcept -> ResultType
+  {
+    const auto sum = std::ranges::fold_left(
+     std::views::iota(0uz, self.period_), ResultType{0}, [&](auto acc, auto i) {
+       return acc + self.source_(asset_snapshot[i], context);
+     });
+    const auto mean = sum / static_cast<ResultType>(self.period_);
+
+    auto sum_squared_diff = ResultType{0};
+    for(auto i = 0uz; i < self.period_; ++i) {
+      const auto diff = self.source_(asset_snapshot[i], context) - mean;
+      sum_squared_diff += diff * diff;
+    }
+
+    const auto variance =
+     sum_squared_diff / static_cast<ResultType>(self.period_);
+    const auto stddev = std::sqrt(variance);
+    return stddev;
+  }
 };
 
 } // namespace pludux
@@ -3,14 +3,17 @@ module;
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <utility>
+#include <vector>
 
 export module pludux:series.stoch_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 import :series.ohlcv_method;
 import :series.operators_method;
@@ -18,6 +21,39 @@ import :series.value_method;
 import :series.sma_method;
 import :series.highest_method;
 import :series.lowest_method;
+import :series.shared_series_method;
+
+namespace pludux {
+
+/**
+ * The %K or %D line of a stochastic oscillator from the column of its values
+ * and the rolling highest and lowest they are measured against.
+ */
+auto stoch_column(const std::vector<double>& values,
+                  const std::vector<double>& highests,
+                  const std::vector<double>& lowests,
+                  std::size_t k_smooth,
+                  std::size_t d_period,
+                  SeriesOutput output) -> std::vector<double>
+{
+  auto stochs = std::vector<double>(values.size());
+  for(auto i = 0uz; i < values.size(); ++i) {
+    stochs[i] = 100.0 * (values[i] - lowests[i]) / (highests[i] - lowests[i]);
+  }
+
+  switch(output) {
+  case SeriesOutput::KPercent:
+    return rolling_mean_column(stochs, k_smooth);
+  case SeriesOutput::DPercent:
+    return rolling_mean_column(rolling_mean_column(stochs, k_smooth),
+                               d_period);
+  default:
+    return std::vector<double>(values.size(),
+                               std::numeric_limits<double>::quiet_NaN());
+  }
+}
+
+} // namespace pludux
 
 export namespace pludux {
 
@@ -51,15 +87,18 @@ public:
     const auto close = CloseMethod{};
     const auto highest_high = HighestMethod{HighMethod{}, self.k_period_};
     const auto lowest_low = LowestMethod{LowMethod{}, self.k_period_};
-    const auto stoch = DivideMethod{MultiplyMethod{ValueMethod{100},
-                                                   SubtractMethod{
-                                                    close,
-                                                    lowest_low,
-                                                   }},
-                                    SubtractMethod{
-                                     highest_high,
-                                     lowest_low,
-                                    }};
+    // Every smoothing reads a window of stoch values, so the stoch is shared
+    // to compute it once per bar.
+    const auto stoch =
+     SharedSeriesMethod{DivideMethod{MultiplyMethod{ValueMethod{100},
+                                                    SubtractMethod{
+                                                     close,
+                                                     lowest_low,
+                                                    }},
+                                     SubtractMethod{
+                                      highest_high,
+                                      lowest_low,
+                                     }}};
 
     const auto k_percent = SmaMethod{stoch, self.k_smooth_};
 
@@ -73,6 +112,41 @@ public:
     }
   }
 
+  auto compute_column(this const StochMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return self.compute_column(asset_snapshot, SeriesOutput::KPercent, context);
+  }
+
+  /**
+   * The highest high and the lowest low are rolled over whole columns, so the
+   * column costs O(1) amortized per bar whatever the K period.
+   */
+  auto compute_column(this const StochMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      SeriesOutput output,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto closes =
+     compute_series_column(CloseMethod{}, asset_snapshot, context);
+    const auto highest_highs = rolling_extremum_column(
+     compute_series_column(HighMethod{}, asset_snapshot, context),
+     self.k_period_,
+     std::greater<>{});
+    const auto lowest_lows = rolling_extremum_column(
+     compute_series_column(LowMethod{}, asset_snapshot, context),
+     self.k_period_,
+     std::less<>{});
+
+    return stoch_column(closes,
+                        highest_highs,
+                        lowest_lows,
+                        self.k_smooth_,
+                        self.d_period_,
+                        output);
+  }
+
   auto k_period(this const StochMethod& self) noexcept -> std::size_t
   {
     return self.k_period_;
@@ -2,15 +2,18 @@ module;
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <utility>
+#include <vector>
 
 export module pludux:series.stoch_rsi_method;
 
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :series_column;
 
 import :series.rsi_method;
 import :series.sma_method;
@@ -18,6 +21,8 @@ import :series.value_method;
 import :series.ohlcv_method;
 import :series.highest_method;
 import :series.lowest_method;
+import :series.shared_series_method;
+import :series.stoch_method;
 
 export namespace pludux {
 
@@ -64,17 +69,22 @@ public:
                   SeriesOutput output,
                   MethodContextable auto context) noexcept -> ResultType
   {
-    const auto highest_rsi = HighestMethod{self.rsi_, self.k_period_};
-    const auto lowest_rsi = LowestMethod{self.rsi_, self.k_period_};
-    const auto stoch = DivideMethod{MultiplyMethod{ValueMethod{100},
-                                                   SubtractMethod{
-                                                    self.rsi_,
-                                                    lowest_rsi,
-                                                   }},
-                                    SubtractMethod{
-                                     highest_rsi,
-                                     lowest_rsi,
-                                    }};
+    // The RSI is read by the window of every stoch value, and the stoch by the
+    // window of every smoothing, so both are shared to compute them once per
+    // bar.
+    const auto rsi = SharedSeriesMethod{self.rsi_};
+    const auto highest_rsi = HighestMethod{rsi, self.k_period_};
+    const auto lowest_rsi = LowestMethod{rsi, self.k_period_};
+    const auto stoch =
+     SharedSeriesMethod{DivideMethod{MultiplyMethod{ValueMethod{100},
+                                                    SubtractMethod{
+                                                     rsi,
+                                                     lowest_rsi,
+                                                    }},
+                                     SubtractMethod{
+                                      highest_rsi,
+                                      lowest_rsi,
+                                     }}};
 
     const auto k_percent = SmaMethod{stoch, self.k_smooth_};
 
@@ -88,6 +98,37 @@ public:
     }
   }
 
+  auto compute_column(this const StochRsiMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return self.compute_column(asset_snapshot, SeriesOutput::KPercent, context);
+  }
+
+  /**
+   * The RSI column is computed once and its highest and lowest are rolled
+   * over it, so the column costs O(1) amortized per bar whatever the K
+   * period.
+   */
+  auto compute_column(this const StochRsiMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      SeriesOutput output,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto rsis = compute_series_column(self.rsi_, asset_snapshot, context);
+    const auto highest_rsis =
+     rolling_extremum_column(rsis, self.k_period_, std::greater<>{});
+    const auto lowest_rsis =
+     rolling_extremum_column(rsis, self.k_period_, std::less<>{});
+
+    return stoch_column(rsis,
+                        highest_rsis,
+                        lowest_rsis,
+                        self.k_smooth_,
+                        self.d_period_,
+                        output);
+  }
+
   auto rsi_source(this const StochRsiMethod& self) noexcept
    -> const TRsiSourceMethod&
   {
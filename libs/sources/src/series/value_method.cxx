@@ -38,6 +38,13 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this ValueMethod self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    return std::vector<ResultType>(asset_snapshot.size(), self.value_);
+  }
+
   auto value(this ValueMethod self) noexcept -> ResultType
   {
     return self.value_;
@@ -10,6 +10,9 @@ export module pludux:series.wma_method;
 import :asset_snapshot;
 import :method_contextable;
 import :series_output;
+import :incremental_results;
+import :indicator_cache;
+import :series_column;
 
 import :series.ohlcv_method;
 
@@ -38,24 +41,32 @@ public:
 
   auto operator==(const WmaMethod& other) const noexcept -> bool = default;
 
+  /**
+   * With an indicator cache in the context the window sums are carried from
+   * bar to bar, so the next bar costs O(1); otherwise the window of the
+   * snapshot is weighted from scratch.
+   */
   auto operator()(this const WmaMethod& self,
                   AssetSnapshot asset_snapshot,
                   MethodContextable auto context) noexcept -> ResultType
   {
-    const auto asset_size = asset_snapshot.size();
-    if(asset_size < self.period_) {
-      return std::numeric_limits<ResultType>::quiet_NaN();
-    }
-
-    auto norm = ResultType{0};
-    auto sum = ResultType{0};
-    for(auto i = 0uz; i < self.period_; ++i) {
-      const auto weight = (self.period_ - i) * self.period_;
-      sum += self.source_(asset_snapshot[i], context) * weight;
-      norm += weight;
+    if constexpr(requires { context.indicator_cache(); }) {
+      if(auto* indicator_cache = context.indicator_cache();
+         indicator_cache != nullptr) {
+        auto& incremental_results = indicator_cache->results(self);
+        return incremental_results.get(
+         asset_snapshot,
+         [&](const std::vector<double>&,
+             AssetSnapshot bar_snapshot) -> ResultType {
+           auto& window =
+            incremental_results.state<RollingWeightedMean>(self.period_);
+           window.push(self.source_(bar_snapshot, context));
+           return window.mean();
+         });
+      }
     }
 
-    return sum / norm;
+    return self.window_mean_(asset_snapshot, context);
   }
 
   auto operator()(this const WmaMethod& self,
@@ -66,6 +77,20 @@ public:
     return std::numeric_limits<ResultType>::quiet_NaN();
   }
 
+  auto compute_column(this const WmaMethod& self,
+                      AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) -> std::vector<ResultType>
+  {
+    const auto sources =
+     compute_series_column(self.source_, asset_snapshot, context);
+    return weighted_mean_column(sources, self.period_);
+  }
+
+  auto hash(this const WmaMethod& self) noexcept -> std::size_t
+  {
+    return series_method_hash(self, self.period_, self.source_);
+  }
+
   auto source(this const WmaMethod& self) noexcept -> const TSourceMethod&
   {
     return self.source_;
@@ -89,6 +114,26 @@ public:
 private:
   TSourceMethod source_;
   std::size_t period_;
+
+  auto window_mean_(this const WmaMethod& self,
+                    AssetSnapshot asset_snapshot,
+                    MethodContextable auto context) noexcept -> ResultType
+  {
+    const auto asset_size = asset_snapshot.size();
+    if(asset_size < self.period_) {
+      return std::numeric_limits<ResultType>::quiet_NaN();
+    }
+
+    auto norm = ResultType{0};
+    auto sum = ResultType{0};
+    for(auto i = 0uz; i < self.period_; ++i) {
+      const auto weight = (self.period_ - i) * self.period_;
+      sum += self.source_(asset_snapshot[i], context) * weight;
+      norm += weight;
+    }
+
+    return sum / norm;
+  }
 };
 
 } // namespace pludux
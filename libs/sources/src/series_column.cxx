@@ -0,0 +1,497 @@
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+export module pludux:series_column;
+
+import :asset_series;
+import :asset_snapshot;
+import :method_contextable;
+import :series_output;
+
+export namespace pludux {
+
+/**
+ * Evaluate a series method for every bar up to the bar of the snapshot.
+ *
+ * The column is ordered from the oldest bar, so the value of the snapshot
+ * itself is `column[asset_snapshot.index()]`. Methods that provide a
+ * `compute_column` member are computed in a single pass over the columns of
+ * their sources; every other method is evaluated bar by bar.
+ */
+template<typename TMethod>
+auto compute_series_column(const TMethod& method,
+                           AssetSnapshot asset_snapshot,
+                           MethodContextable auto context)
+ -> std::vector<typename TMethod::ResultType>
+{
+  if constexpr(requires { method.compute_column(asset_snapshot, context); }) {
+    return method.compute_column(asset_snapshot, context);
+  } else {
+    const auto size = asset_snapshot.size();
+    auto column = std::vector<typename TMethod::ResultType>(size);
+    for(auto i = 0uz; i < size; ++i) {
+      column[i] = method(asset_snapshot[size - 1 - i], context);
+    }
+    return column;
+  }
+}
+
+template<typename TMethod>
+auto compute_series_column(const TMethod& method,
+                           AssetSnapshot asset_snapshot,
+                           SeriesOutput output,
+                           MethodContextable auto context)
+ -> std::vector<typename TMethod::ResultType>
+{
+  if constexpr(requires {
+                 method.compute_column(asset_snapshot, output, context);
+               }) {
+    return method.compute_column(asset_snapshot, output, context);
+  } else {
+    const auto size = asset_snapshot.size();
+    auto column = std::vector<typename TMethod::ResultType>(size);
+    for(auto i = 0uz; i < size; ++i) {
+      column[i] = method(asset_snapshot[size - 1 - i], output, context);
+    }
+    return column;
+  }
+}
+
+/**
+ * Copy the values of an asset series that are visible from the snapshot,
+ * ordered from the oldest bar.
+ */
+auto series_column(AssetSeries series, AssetSnapshot asset_snapshot)
+ -> std::vector<double>
+{
+  const auto size = asset_snapshot.size();
+  const auto history_size = asset_snapshot.asset_history().size();
+
+  // A series shorter than the history is aligned to its latest bar.
+  const auto values = series.data();
+  const auto missing_size = std::min(history_size - values.size(), size);
+
+  auto column = std::vector<double>(
+   missing_size, std::numeric_limits<double>::quiet_NaN());
+  column.reserve(size);
+  column.insert(column.end(),
+                values.begin(),
+                values.begin() + (size - missing_size));
+  return column;
+}
+
+} // namespace pludux
+
+namespace pludux {
+
+/**
+ * Rolling arithmetic mean of a column. A bar is NaN until the window is full
+ * and while any value inside the window is NaN.
+ */
+auto rolling_mean_column(const std::vector<double>& values, std::size_t period)
+ -> std::vector<double>
+{
+  auto means =
+   std::vector<double>(values.size(), std::numeric_limits<double>::quiet_NaN());
+  if(period == 0) {
+    return means;
+  }
+
+  auto sum = 0.0;
+  auto nan_count = 0uz;
+  for(auto i = 0uz; i < values.size(); ++i) {
+    if(std::isnan(values[i])) {
+      ++nan_count;
+    } else {
+      sum += values[i];
+    }
+
+    if(i >= period) {
+      const auto removed = values[i - period];
+      if(std::isnan(removed)) {
+        --nan_count;
+      } else {
+        sum -= removed;
+      }
+    }
+
+    if(i + 1 >= period && nan_count == 0) {
+      means[i] = sum / static_cast<double>(period);
+    }
+  }
+
+  return means;
+}
+
+/**
+ * Exponential smoothing of a column seeded with the simple moving average of
+ * the first full window. A NaN result is re-seeded with the moving average of
+ * the bar, which matches the per-bar EMA and RMA.
+ */
+auto exponential_smoothing_column(const std::vector<double>& values,
+                                  std::size_t period,
+                                  double alpha) -> std::vector<double>
+{
+  const auto means = rolling_mean_column(values, period);
+
+  auto results =
+   std::vector<double>(values.size(), std::numeric_limits<double>::quiet_NaN());
+  auto result = std::numeric_limits<double>::quiet_NaN();
+  for(auto i = 0uz; i < values.size(); ++i) {
+    if(i + 1 < period) {
+      continue;
+    }
+
+    result = std::isnan(result) ? means[i]
+                                : values[i] * alpha + result * (1 - alpha);
+    results[i] = result;
+  }
+
+  return results;
+}
+
+/**
+ * The highest or lowest value of a rolling window, fed one bar at a time.
+ *
+ * The window keeps a monotonic deque of the values that can still become its
+ * extremum: a new value drops every older value it matches or beats, and the
+ * front leaves once it falls out of the window. Each value is pushed and
+ * dropped once, so a bar costs O(1) amortized however long the period is.
+ */
+template<typename TCompare>
+class RollingExtremum {
+public:
+  explicit RollingExtremum(std::size_t period, TCompare compare = TCompare{})
+  : period_{period}
+  , compare_{std::move(compare)}
+  {
+  }
+
+  /**
+   * Add the value of the next bar and get the extremum of the window ending
+   * at it. NaN values are skipped; the result is NaN until the window is full
+   * and while every value inside it is NaN.
+   */
+  auto push(this RollingExtremum& self, double value) -> double
+  {
+    if(!std::isnan(value)) {
+      while(!self.window_.empty() &&
+            !self.compare_(self.window_.back().value, value)) {
+        self.window_.pop_back();
+      }
+      self.window_.push_back({self.count_, value});
+    }
+    ++self.count_;
+
+    while(!self.window_.empty() &&
+          self.window_.front().index + self.period_ < self.count_) {
+      self.window_.pop_front();
+    }
+
+    if(self.count_ < self.period_ || self.window_.empty()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    return self.window_.front().value;
+  }
+
+private:
+  struct Entry {
+    std::size_t index;
+    double value;
+  };
+
+  std::size_t period_;
+  TCompare compare_;
+  std::size_t count_{0};
+  std::deque<Entry> window_;
+};
+
+/**
+ * Rolling extremum of a column: the rolling maximum with `std::greater<>` and
+ * the rolling minimum with `std::less<>`.
+ */
+template<typename TCompare>
+auto rolling_extremum_column(const std::vector<double>& values,
+                             std::size_t period,
+                             TCompare compare) -> std::vector<double>
+{
+  auto window = RollingExtremum<TCompare>{period, std::move(compare)};
+
+  auto results = std::vector<double>{};
+  results.reserve(values.size());
+  for(const auto value : values) {
+    results.push_back(window.push(value));
+  }
+
+  return results;
+}
+
+/**
+ * The mean and the population standard deviation of a rolling window, fed
+ * one bar at a time, so both come out of a single pass.
+ *
+ * The window keeps the sums of the values and of their squares shifted by an
+ * anchor, and updates them as a value enters and another leaves. Shifting
+ * keeps the squares small, so prices far from zero do not cancel out. The
+ * anchor is reset to the mean of the window and the sums recomputed once per
+ * period, which bounds the rounding drift to one window of updates at O(1)
+ * amortized per bar.
+ */
+class RollingMoments {
+public:
+  explicit RollingMoments(std::size_t period)
+  : period_{period}
+  , window_(period)
+  {
+  }
+
+  /**
+   * Add the value of the next bar. The mean and the standard deviation are
+   * NaN until the window is full and while any value inside it is NaN.
+   */
+  void push(this RollingMoments& self, double value)
+  {
+    if(self.period_ == 0) {
+      return;
+    }
+
+    auto& slot = self.window_[self.count_ % self.period_];
+    const auto removed = slot;
+    const auto is_full = self.count_ >= self.period_;
+    slot = value;
+    ++self.count_;
+
+    if(is_full && std::isnan(removed)) {
+      --self.nan_count_;
+    }
+    if(std::isnan(value)) {
+      ++self.nan_count_;
+    }
+
+    if(!self.is_valid_()) {
+      self.is_anchored_ = false;
+      return;
+    }
+
+    if(!self.is_anchored_ || ++self.update_count_ >= self.period_) {
+      self.reanchor_();
+      return;
+    }
+
+    const auto added_shift = value - self.anchor_;
+    const auto removed_shift = removed - self.anchor_;
+    self.sum_ += added_shift - removed_shift;
+    self.sum_squares_ +=
+     (added_shift - removed_shift) * (added_shift + removed_shift);
+  }
+
+  auto mean(this const RollingMoments& self) noexcept -> double
+  {
+    if(!self.is_valid_()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    return self.anchor_ + self.sum_ / static_cast<double>(self.period_);
+  }
+
+  auto stddev(this const RollingMoments& self) noexcept -> double
+  {
+    if(!self.is_valid_()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const auto period = static_cast<double>(self.period_);
+    const auto shifted_mean = self.sum_ / period;
+    const auto variance =
+     self.sum_squares_ / period - shifted_mean * shifted_mean;
+    return std::sqrt(std::max(variance, 0.0));
+  }
+
+private:
+  std::size_t period_;
+  std::vector<double> window_;
+  std::size_t count_{0};
+  std::size_t nan_count_{0};
+  std::size_t update_count_{0};
+  bool is_anchored_{false};
+  double anchor_{0.0};
+  double sum_{0.0};
+  double sum_squares_{0.0};
+
+  auto is_valid_(this const RollingMoments& self) noexcept -> bool
+  {
+    return self.period_ != 0 && self.count_ >= self.period_ &&
+           self.nan_count_ == 0;
+  }
+
+  void reanchor_(this RollingMoments& self) noexcept
+  {
+    auto sum = 0.0;
+    for(const auto value : self.window_) {
+      sum += value;
+    }
+
+    self.anchor_ = sum / static_cast<double>(self.period_);
+    self.sum_ = 0.0;
+    self.sum_squares_ = 0.0;
+    for(const auto value : self.window_) {
+      const auto shift = value - self.anchor_;
+      self.sum_ += shift;
+      self.sum_squares_ += shift * shift;
+    }
+
+    self.update_count_ = 0;
+    self.is_anchored_ = true;
+  }
+};
+
+/**
+ * The columns of the rolling mean and standard deviation of a column.
+ */
+struct RollingMomentsColumns {
+  std::vector<double> means;
+  std::vector<double> stddevs;
+};
+
+auto rolling_moments_columns(const std::vector<double>& values,
+                             std::size_t period) -> RollingMomentsColumns
+{
+  auto window = RollingMoments{period};
+
+  auto results = RollingMomentsColumns{};
+  results.means.reserve(values.size());
+  results.stddevs.reserve(values.size());
+  for(const auto value : values) {
+    window.push(value);
+    results.means.push_back(window.mean());
+    results.stddevs.push_back(window.stddev());
+  }
+
+  return results;
+}
+
+/**
+ * The linearly weighted mean of a rolling window, fed one bar at a time. The
+ * newest value weighs the period and the oldest weighs one.
+ *
+ * The window keeps the plain and the weighted sums of its values. When a bar
+ * enters every value already inside loses one weight, which is the plain sum,
+ * so both sums update in O(1). They are recomputed from the window once per
+ * period to bound the rounding drift.
+ */
+class RollingWeightedMean {
+public:
+  explicit RollingWeightedMean(std::size_t period)
+  : period_{period}
+  , window_(period)
+  {
+  }
+
+  /**
+   * Add the value of the next bar. The mean is NaN until the window is full
+   * and while any value inside it is NaN.
+   */
+  void push(this RollingWeightedMean& self, double value)
+  {
+    if(self.period_ == 0) {
+      return;
+    }
+
+    auto& slot = self.window_[self.count_ % self.period_];
+    const auto removed = slot;
+    const auto is_full = self.count_ >= self.period_;
+    slot = value;
+    ++self.count_;
+
+    if(is_full && std::isnan(removed)) {
+      --self.nan_count_;
+    }
+    if(std::isnan(value)) {
+      ++self.nan_count_;
+    }
+
+    if(!self.is_valid_()) {
+      self.is_computed_ = false;
+      return;
+    }
+
+    if(!self.is_computed_ || ++self.update_count_ >= self.period_) {
+      self.recompute_();
+      return;
+    }
+
+    self.weighted_sum_ +=
+     static_cast<double>(self.period_) * value - self.sum_;
+    self.sum_ += value - removed;
+  }
+
+  auto mean(this const RollingWeightedMean& self) noexcept -> double
+  {
+    if(!self.is_valid_()) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const auto period = static_cast<double>(self.period_);
+    return self.weighted_sum_ / (period * (period + 1) / 2);
+  }
+
+private:
+  std::size_t period_;
+  std::vector<double> window_;
+  std::size_t count_{0};
+  std::size_t nan_count_{0};
+  std::size_t update_count_{0};
+  bool is_computed_{false};
+  double sum_{0.0};
+  double weighted_sum_{0.0};
+
+  auto is_valid_(this const RollingWeightedMean& self) noexcept -> bool
+  {
+    return self.period_ != 0 && self.count_ >= self.period_ &&
+           self.nan_count_ == 0;
+  }
+
+  void recompute_(this RollingWeightedMean& self) noexcept
+  {
+    self.sum_ = 0.0;
+    self.weighted_sum_ = 0.0;
+
+    // The oldest value sits in the slot the next bar overwrites.
+    for(auto i = 0uz; i < self.period_; ++i) {
+      const auto value = self.window_[(self.count_ + i) % self.period_];
+      self.sum_ += value;
+      self.weighted_sum_ += value * static_cast<double>(i + 1);
+    }
+
+    self.update_count_ = 0;
+    self.is_computed_ = true;
+  }
+};
+
+/**
+ * Rolling linearly weighted mean of a column.
+ */
+auto weighted_mean_column(const std::vector<double>& values,
+                          std::size_t period) -> std::vector<double>
+{
+  auto window = RollingWeightedMean{period};
+
+  auto results = std::vector<double>{};
+  results.reserve(values.size());
+  for(const auto value : values) {
+    window.push(value);
+    results.push_back(window.mean());
+  }
+
+  return results;
+}
+
+} // namespace pludux
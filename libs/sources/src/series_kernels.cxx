@@ -0,0 +1,272 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+// On x86-64 ELF targets GCC and Clang compile every kernel for AVX2 and for
+// the baseline, and the loader picks the clone the CPU supports. Elsewhere,
+// such as MSVC, AArch64 with its baseline NEON, and WebAssembly, the kernels
+// are compiled once for the target.
+#if !defined(__EMSCRIPTEN__) && (defined(__GNUC__) || defined(__clang__)) && \
+ defined(__x86_64__) && defined(__ELF__)
+#define PLUDUX_SERIES_KERNEL __attribute__((target_clones("avx2", "default")))
+#define PLUDUX_SERIES_KERNEL_BODY __attribute__((always_inline)) inline
+#else
+#define PLUDUX_SERIES_KERNEL
+#define PLUDUX_SERIES_KERNEL_BODY inline
+#endif
+
+export module pludux:series_kernels;
+
+namespace pludux {
+
+/**
+ * The number of bars a kernel computes into a local block before it stores
+ * them. A block of fixed size written to a local array cannot overlap its
+ * inputs, so the compiler turns the loop into lane operations without
+ * checking the operands for aliasing at run time.
+ */
+constexpr auto kernel_block_size = 64uz;
+
+/**
+ * Apply a binary operator bar by bar. `results` may be one of the operands.
+ * Inlined into every clone of a kernel, so it is compiled for the
+ * instruction set of the clone.
+ */
+template<typename TBinaryFn>
+PLUDUX_SERIES_KERNEL_BODY void transform_blocks(std::span<const double> lhs,
+                                                std::span<const double> rhs,
+                                                std::span<double> results,
+                                                TBinaryFn binary_fn) noexcept
+{
+  const auto size = results.size();
+  auto block = std::array<double, kernel_block_size>{};
+
+  auto offset = 0uz;
+  for(; offset + kernel_block_size <= size; offset += kernel_block_size) {
+    for(auto i = 0uz; i < kernel_block_size; ++i) {
+      block[i] = binary_fn(lhs[offset + i], rhs[offset + i]);
+    }
+    std::ranges::copy(block, results.begin() + offset);
+  }
+
+  for(auto i = offset; i < size; ++i) {
+    results[i] = binary_fn(lhs[i], rhs[i]);
+  }
+}
+
+/**
+ * Compare two columns bar by bar into words of one bit per bar. The bars are
+ * compared a block at a time into flags, and the block is then packed into
+ * one word.
+ */
+template<typename TComparator>
+PLUDUX_SERIES_KERNEL_BODY void
+compare_blocks(std::span<const double> lhs,
+               std::span<const double> rhs,
+               TComparator comparator,
+               std::span<std::uint64_t> words) noexcept
+{
+  constexpr auto word_size =
+   static_cast<std::size_t>(std::numeric_limits<std::uint64_t>::digits);
+  static_assert(kernel_block_size == word_size);
+
+  const auto size = std::min(lhs.size(), rhs.size());
+  auto flags = std::array<std::uint64_t, kernel_block_size>{};
+
+  for(auto word_index = 0uz; word_index < words.size(); ++word_index) {
+    const auto offset = word_index * kernel_block_size;
+    const auto block_size =
+     offset < size ? std::min(kernel_block_size, size - offset) : 0uz;
+
+    for(auto i = 0uz; i < block_size; ++i) {
+      flags[i] = comparator(lhs[offset + i], rhs[offset + i]);
+    }
+
+    auto word = std::uint64_t{0};
+    for(auto i = 0uz; i < block_size; ++i) {
+      word |= flags[i] << i;
+    }
+    words[word_index] = word;
+  }
+}
+
+} // namespace pludux
+
+export namespace pludux {
+
+// Elementwise kernels over series columns. Each kernel writes
+// `results.size()` bars, so the inputs hold at least as many. NaN propagates
+// through the arithmetic and the comparisons exactly as it does bar by bar.
+
+PLUDUX_SERIES_KERNEL void transform_columns(std::span<const double> lhs,
+                                            std::span<const double> rhs,
+                                            std::plus<>,
+                                            std::span<double> results) noexcept
+{
+  transform_blocks(lhs, rhs, results, std::plus<>{});
+}
+
+PLUDUX_SERIES_KERNEL void transform_columns(std::span<const double> lhs,
+                                            std::span<const double> rhs,
+                                            std::minus<>,
+                                            std::span<double> results) noexcept
+{
+  transform_blocks(lhs, rhs, results, std::minus<>{});
+}
+
+PLUDUX_SERIES_KERNEL void transform_columns(std::span<const double> lhs,
+                                            std::span<const double> rhs,
+                                            std::multiplies<>,
+                                            std::span<double> results) noexcept
+{
+  transform_blocks(lhs, rhs, results, std::multiplies<>{});
+}
+
+PLUDUX_SERIES_KERNEL void transform_columns(std::span<const double> lhs,
+                                            std::span<const double> rhs,
+                                            std::divides<>,
+                                            std::span<double> results) noexcept
+{
+  transform_blocks(lhs, rhs, results, std::divides<>{});
+}
+
+/**
+ * Any other binary operator, computed a block at a time for the baseline
+ * instruction set.
+ */
+template<typename TBinaryFn>
+  requires std::is_invocable_r_v<double, TBinaryFn, double, double>
+void transform_columns(std::span<const double> lhs,
+                       std::span<const double> rhs,
+                       TBinaryFn binary_fn,
+                       std::span<double> results)
+{
+  transform_blocks(lhs, rhs, results, binary_fn);
+}
+
+PLUDUX_SERIES_KERNEL void transform_column(std::span<const double> values,
+                                           std::negate<>,
+                                           std::span<double> results) noexcept
+{
+  transform_blocks(values, values, results, [](double value, double) {
+    return -value;
+  });
+}
+
+template<typename TUnaryFn>
+  requires std::is_invocable_r_v<double, TUnaryFn, double>
+void transform_column(std::span<const double> values,
+                      TUnaryFn unary_fn,
+                      std::span<double> results)
+{
+  transform_blocks(values, values, results, [&](double value, double) {
+    return unary_fn(value);
+  });
+}
+
+PLUDUX_SERIES_KERNEL void abs_column(std::span<const double> values,
+                                     std::span<double> results) noexcept
+{
+  transform_blocks(values, values, results, [](double value, double) {
+    return std::abs(value);
+  });
+}
+
+/**
+ * Multiply every bar by `factor`, such as a percentage of the bar.
+ */
+PLUDUX_SERIES_KERNEL void scale_column(std::span<const double> values,
+                                       double factor,
+                                       std::span<double> results) noexcept
+{
+  transform_blocks(values, values, results, [factor](double value, double) {
+    return value * factor;
+  });
+}
+
+/**
+ * The change of every bar from its base bar in percent of the base.
+ */
+PLUDUX_SERIES_KERNEL void
+percent_change_columns(std::span<const double> values,
+                       std::span<const double> bases,
+                       std::span<double> results) noexcept
+{
+  transform_blocks(values, bases, results, [](double value, double base) {
+    return 100 * (value - base) / base;
+  });
+}
+
+PLUDUX_SERIES_KERNEL void
+compare_columns(std::span<const double> lhs,
+                std::span<const double> rhs,
+                std::greater<>,
+                std::span<std::uint64_t> words) noexcept
+{
+  compare_blocks(lhs, rhs, std::greater<>{}, words);
+}
+
+PLUDUX_SERIES_KERNEL void
+compare_columns(std::span<const double> lhs,
+                std::span<const double> rhs,
+                std::greater_equal<>,
+                std::span<std::uint64_t> words) noexcept
+{
+  compare_blocks(lhs, rhs, std::greater_equal<>{}, words);
+}
+
+PLUDUX_SERIES_KERNEL void
+compare_columns(std::span<const double> lhs,
+                std::span<const double> rhs,
+                std::less<>,
+                std::span<std::uint64_t> words) noexcept
+{
+  compare_blocks(lhs, rhs, std::less<>{}, words);
+}
+
+PLUDUX_SERIES_KERNEL void
+compare_columns(std::span<const double> lhs,
+                std::span<const double> rhs,
+                std::less_equal<>,
+                std::span<std::uint64_t> words) noexcept
+{
+  compare_blocks(lhs, rhs, std::less_equal<>{}, words);
+}
+
+PLUDUX_SERIES_KERNEL void
+compare_columns(std::span<const double> lhs,
+                std::span<const double> rhs,
+                std::equal_to<>,
+                std::span<std::uint64_t> words) noexcept
+{
+  compare_blocks(lhs, rhs, std::equal_to<>{}, words);
+}
+
+PLUDUX_SERIES_KERNEL void
+compare_columns(std::span<const double> lhs,
+                std::span<const double> rhs,
+                std::not_equal_to<>,
+                std::span<std::uint64_t> words) noexcept
+{
+  compare_blocks(lhs, rhs, std::not_equal_to<>{}, words);
+}
+
+template<typename TComparator>
+  requires std::is_invocable_r_v<bool, TComparator, double, double>
+void compare_columns(std::span<const double> lhs,
+                     std::span<const double> rhs,
+                     TComparator comparator,
+                     std::span<std::uint64_t> words)
+{
+  compare_blocks(lhs, rhs, comparator, words);
+}
+
+} // namespace pludux
@@ -1,9 +1,9 @@
 module;
 
-#include <functional>
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <string>
-#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -12,30 +12,83 @@ export module pludux:series_results_collector;
 
 export namespace pludux {
 
+/**
+ * The results of a run, one column per series. Every series has a slot, the
+ * position of its column, so collecting a bar is a push to a column without
+ * looking up the name. Once the columns are reserved for the bars of the run,
+ * collecting never reallocates and the spans handed out stay valid.
+ */
 class SeriesResultsCollector {
 public:
   SeriesResultsCollector() = default;
 
-  auto results(this const SeriesResultsCollector& self) noexcept
-   -> const std::unordered_map<std::string, std::vector<double>>&
+  /**
+   * A collector with the given series in slot order, each with room for
+   * `bar_count` results.
+   */
+  SeriesResultsCollector(const std::vector<std::string>& series_names,
+                         std::size_t bar_count)
   {
-    return self.results_;
+    reserve(series_names, bar_count);
   }
 
-  void results(
-   this SeriesResultsCollector& self,
-   std::unordered_map<std::string, std::vector<double>> new_results) noexcept
+  auto size(this const SeriesResultsCollector& self) noexcept -> std::size_t
   {
-    self.results_ = std::move(new_results);
+    return self.columns_.size();
+  }
+
+  auto empty(this const SeriesResultsCollector& self) noexcept -> bool
+  {
+    return self.columns_.empty();
+  }
+
+  auto series_names(this const SeriesResultsCollector& self) noexcept
+   -> const std::vector<std::string>&
+  {
+    return self.series_names_;
+  }
+
+  auto slot(this const SeriesResultsCollector& self,
+            const std::string& series_name) noexcept
+   -> std::optional<std::size_t>
+  {
+    const auto it = self.slots_.find(series_name);
+    if(it != self.slots_.end()) {
+      return it->second;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * Add a column for every series the collector does not have yet, and make
+   * room for `bar_count` results in every column.
+   */
+  void reserve(this SeriesResultsCollector& self,
+               const std::vector<std::string>& series_names,
+               std::size_t bar_count)
+  {
+    for(const auto& series_name : series_names) {
+      self.add_series_(series_name);
+    }
+
+    for(auto& column : self.columns_) {
+      column.reserve(bar_count);
+    }
+  }
+
+  auto results(this const SeriesResultsCollector& self,
+               std::size_t slot) noexcept -> std::span<const double>
+  {
+    return self.columns_[slot];
   }
 
   auto results(this const SeriesResultsCollector& self,
                const std::string& series_name) noexcept
-   -> std::optional<std::reference_wrapper<const std::vector<double>>>
+   -> std::optional<std::span<const double>>
   {
-    const auto it = self.results_.find(series_name);
-    if(it != self.results_.end()) {
-      return std::cref(it->second);
+    if(const auto slot = self.slot(series_name)) {
+      return self.results(*slot);
     }
 
     return std::nullopt;
@@ -43,23 +96,51 @@ public:
 
   void results(this SeriesResultsCollector& self,
                const std::string& series_name,
-               std::vector<double> new_results) noexcept
+               std::vector<double> new_results)
   {
-    self.results_[series_name] = std::move(new_results);
+    const auto slot = self.add_series_(series_name);
+    self.columns_[slot] = std::move(new_results);
   }
 
-  void collect(const std::string& series_name, double value)
+  void collect(this SeriesResultsCollector& self,
+               std::size_t slot,
+               double value)
   {
-    results_[series_name].emplace_back(value);
+    self.columns_[slot].push_back(value);
+  }
+
+  void collect(this SeriesResultsCollector& self,
+               const std::string& series_name,
+               double value)
+  {
+    const auto slot = self.add_series_(series_name);
+    self.collect(slot, value);
   }
 
   void clear(this SeriesResultsCollector& self) noexcept
   {
-    self.results_.clear();
+    self.series_names_.clear();
+    self.slots_.clear();
+    self.columns_.clear();
   }
 
 private:
-  std::unordered_map<std::string, std::vector<double>> results_;
+  std::vector<std::string> series_names_;
+  std::unordered_map<std::string, std::size_t> slots_;
+  std::vector<std::vector<double>> columns_;
+
+  auto add_series_(this SeriesResultsCollector& self,
+                   const std::string& series_name) -> std::size_t
+  {
+    const auto [it, is_inserted] =
+     self.slots_.try_emplace(series_name, self.columns_.size());
+    if(is_inserted) {
+      self.series_names_.push_back(series_name);
+      self.columns_.emplace_back();
+    }
+
+    return it->second;
+  }
 };
 
-} // namespace pludux
\ No newline at end of file
+} // namespace pludux
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <utility>
+
 import pludux;
 
 using namespace pludux;
@@ -58,3 +61,59 @@ TEST(AnySeriesMethodTest, NotEqualOperator)
   EXPECT_TRUE(any_method1 != any_method2);
   EXPECT_NE(any_method1, any_method2);
 }
+
+TEST(AnySeriesMethodTest, ContextReferencesWrappedContext)
+{
+  const auto asset_data = AssetHistory{{"Close", {1.0, 1.1, 1.2}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  auto registry = SeriesMethodRegistry{};
+  registry.set("close", CloseMethod{});
+
+  auto results_collector = SeriesResultsCollector{};
+  results_collector.collect("close", 1.5);
+  const auto default_context =
+   DefaultMethodContext{registry, results_collector, {}, 2};
+  const auto context = AnySeriesMethodContext{default_context};
+
+  EXPECT_EQ(series_method_context_cast<DefaultMethodContext>(context),
+            &default_context);
+  EXPECT_EQ(series_method_context_cast<AnySeriesMethodContext>(context),
+            nullptr);
+  EXPECT_EQ(context.index(), 2);
+  EXPECT_DOUBLE_EQ(context.get_series_result("close", 0), 1.5);
+  EXPECT_DOUBLE_EQ(context.call_series_method("close", asset_snapshot[1]),
+                   1.1);
+
+  const auto empty_context = AnySeriesMethodContext{};
+  EXPECT_EQ(empty_context.index(), 0);
+  EXPECT_EQ(empty_context.indicator_cache(), nullptr);
+  EXPECT_TRUE(std::isnan(empty_context.get_series_result("close", 0)));
+}
+
+TEST(AnySeriesMethodTest, CopiesShareLargeMethods)
+{
+  using LargeMethod = SmaMethod<AnySeriesMethod>;
+
+  const auto any_method =
+   AnySeriesMethod{LargeMethod{AnySeriesMethod{CloseMethod{}}, 5}};
+  auto copied_method = any_method;
+
+  EXPECT_EQ(series_method_cast<LargeMethod>(any_method),
+            series_method_cast<LargeMethod>(std::as_const(copied_method)));
+  EXPECT_EQ(any_method, copied_method);
+
+  auto* mutable_method = series_method_cast<LargeMethod>(copied_method);
+  ASSERT_NE(mutable_method, nullptr);
+  EXPECT_NE(mutable_method, series_method_cast<LargeMethod>(any_method));
+  EXPECT_EQ(mutable_method->period(), 5);
+  EXPECT_EQ(any_method, copied_method);
+
+  const auto inline_method = AnySeriesMethod{ValueMethod{2.0}};
+  auto moved_method = AnySeriesMethod{inline_method};
+  const auto other_method = std::move(moved_method);
+  ASSERT_NE(series_method_cast<ValueMethod>(other_method), nullptr);
+  EXPECT_EQ(series_method_cast<ValueMethod>(other_method)->value(), 2.0);
+  EXPECT_NE(series_method_cast<ValueMethod>(other_method),
+            series_method_cast<ValueMethod>(inline_method));
+}
@@ -1,4 +1,8 @@
 #include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -133,3 +137,150 @@ TEST(AssetHistoryTest, AccessNonExistentKey)
   EXPECT_TRUE(std::isnan(open_series[1]));
   EXPECT_TRUE(std::isnan(open_series[2]));
 }
+
+TEST(AssetHistoryTest, RevisionChangesOnInsert)
+{
+  auto asset_history = AssetHistory{{"Close", {1.0, 2.0}}};
+  const auto other_history = AssetHistory{{"Close", {1.0, 2.0}}};
+  const auto revision = asset_history.revision();
+
+  EXPECT_NE(revision, other_history.revision());
+
+  asset_history.insert("Open", AssetData{1.0, 2.0});
+  EXPECT_NE(asset_history.revision(), revision);
+}
+
+TEST(AssetHistoryTest, FieldHandles)
+{
+  auto asset_history = AssetHistory{{"close", {875, 830, 800, 835, 870}},
+                                    {"open", {870, 825}}};
+
+  const auto close_handle = asset_history.field_handle("close");
+  const auto open_handle = asset_history.field_handle("open");
+  ASSERT_NE(close_handle, AssetHistory::invalid_field_handle);
+  ASSERT_NE(open_handle, AssetHistory::invalid_field_handle);
+  EXPECT_EQ(asset_history.field_handle("volume"),
+            AssetHistory::invalid_field_handle);
+
+  EXPECT_EQ(asset_history.value(close_handle, 0), 875);
+  EXPECT_EQ(asset_history.value(close_handle, 4), 870);
+  EXPECT_TRUE(std::isnan(asset_history.value(close_handle, 5)));
+  EXPECT_EQ(asset_history.value(open_handle, 1), 825);
+  EXPECT_TRUE(std::isnan(asset_history.value(open_handle, 2)));
+  EXPECT_TRUE(std::isnan(
+   asset_history.value(AssetHistory::invalid_field_handle, 0)));
+
+  asset_history.insert("volume", {10, 20, 30, 40, 50, 60});
+
+  EXPECT_EQ(asset_history.size(), 6);
+  EXPECT_EQ(asset_history.field_handle("close"), close_handle);
+  EXPECT_EQ(asset_history.value(close_handle, 4), 870);
+  EXPECT_TRUE(std::isnan(asset_history.value(close_handle, 5)));
+  EXPECT_EQ(asset_history.value(open_handle, 0), 870);
+  EXPECT_EQ(asset_history["volume"][5], 60);
+  EXPECT_EQ(asset_history.fields(),
+            (std::vector<std::string>{"close", "open", "volume"}));
+}
+
+TEST(AssetHistoryTest, ChronologicalAssetData)
+{
+  const auto field_data = std::vector<std::pair<std::string, AssetData>>{
+   {"close", AssetData{std::vector<double>{870, 835, 800, 830, 875}}},
+   {"open", AssetData{std::vector<double>{795, 825, 870}}}};
+  const auto asset_history =
+   AssetHistory{field_data.begin(), field_data.end()};
+
+  EXPECT_EQ(asset_history.size(), 5);
+  EXPECT_EQ(asset_history["close"][0], 875);
+  EXPECT_EQ(asset_history["close"][4], 870);
+  EXPECT_EQ(asset_history["open"][0], 870);
+  EXPECT_TRUE(std::isnan(asset_history["open"][3]));
+
+  const auto asset_snapshot = AssetSnapshot{asset_history};
+  const auto open_column =
+   series_column(asset_snapshot.series("open"), asset_snapshot[1]);
+  ASSERT_EQ(open_column.size(), 4);
+  EXPECT_TRUE(std::isnan(open_column[0]));
+  EXPECT_TRUE(std::isnan(open_column[1]));
+  EXPECT_EQ(open_column[2], 795);
+  EXPECT_EQ(open_column[3], 825);
+}
+
+TEST(AssetHistoryTest, ViewOfStorage)
+{
+  const auto storage = std::make_shared<std::vector<double>>(
+   std::vector<double>{1, 2, 3, std::nan(""), 10, 20});
+  auto asset_history = AssetHistory{std::vector<std::string>{"close", "open"},
+                                    std::vector<std::size_t>{3, 2},
+                                    3,
+                                    *storage,
+                                    storage};
+
+  EXPECT_EQ(asset_history.size(), 3);
+  EXPECT_EQ(asset_history["close"][0], 3);
+  EXPECT_EQ(asset_history["open"][1], 10);
+  EXPECT_EQ(asset_history["open"].size(), 2);
+  EXPECT_EQ(asset_history["close"].data().data(), storage->data());
+
+  asset_history.insert("volume", {300, 200, 100, 50});
+  storage->assign(storage->size(), 0);
+
+  EXPECT_EQ(asset_history.size(), 4);
+  EXPECT_EQ(asset_history["close"][0], 3);
+  EXPECT_TRUE(std::isnan(asset_history["close"][3]));
+  EXPECT_EQ(asset_history["open"][0], 20);
+  EXPECT_EQ(asset_history["volume"][3], 50);
+}
+
+TEST(AssetHistoryTest, WindowOfBars)
+{
+  const auto field_data = std::vector<std::pair<std::string, AssetData>>{
+   {"close", AssetData{std::vector<double>{870, 835, 800, 830, 875}}},
+   {"open", AssetData{std::vector<double>{795, 825, 870}}}};
+  const auto asset_history =
+   AssetHistory{field_data.begin(), field_data.end()};
+
+  auto window = asset_history.window(1, 4);
+  EXPECT_EQ(window.size(), 3);
+  EXPECT_NE(window.revision(), asset_history.revision());
+  EXPECT_EQ(window["close"][0], 830);
+  EXPECT_EQ(window["close"][2], 835);
+  EXPECT_EQ(window["open"].size(), 2);
+  EXPECT_EQ(window["open"][0], 825);
+  EXPECT_TRUE(std::isnan(window["open"][2]));
+  EXPECT_EQ(window["close"].data().data(),
+            asset_history["close"].data().data() + 1);
+
+  const auto inner_window = window.window(1, 3);
+  EXPECT_EQ(inner_window.size(), 2);
+  EXPECT_EQ(inner_window["close"][0], 830);
+  EXPECT_EQ(inner_window["close"][1], 800);
+  EXPECT_EQ(inner_window["open"][1], 795);
+
+  EXPECT_EQ(asset_history.window(3, 10).size(), 2);
+  EXPECT_EQ(asset_history.window(0, 2)["open"].size(), 0);
+
+  window.insert("volume", {300, 200, 100});
+  EXPECT_EQ(window["close"][0], 830);
+  EXPECT_EQ(window["open"][0], 825);
+  EXPECT_EQ(window["volume"][0], 300);
+  EXPECT_EQ(asset_history["close"][1], 830);
+  EXPECT_FALSE(asset_history.contains("volume"));
+}
+
+TEST(AssetHistoryTest, WindowSharesOwnedBuffer)
+{
+  auto asset_history = std::make_unique<AssetHistory>(
+   AssetHistory{{"close", {875, 830, 800, 835, 870}}});
+
+  const auto window = asset_history->window(1, 4);
+  const auto* window_data = window["close"].data().data();
+
+  asset_history->insert("open", {870, 825, 795});
+  EXPECT_EQ((*asset_history)["open"][0], 870);
+  asset_history.reset();
+
+  EXPECT_EQ(window["close"].data().data(), window_data);
+  EXPECT_EQ(window["close"][0], 830);
+  EXPECT_EQ(window["close"][2], 835);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+import pludux;
+
+using namespace pludux;
+
+namespace {
+
+auto make_asset_history(std::size_t size) -> AssetHistory
+{
+  auto closes = std::vector<double>{};
+  auto opens = std::vector<double>{};
+  for(auto i = 0uz; i < size; ++i) {
+    closes.push_back(50.0 + 10.0 * std::sin(static_cast<double>(i) * 0.3));
+    opens.push_back(50.0 + 10.0 * std::cos(static_cast<double>(i) * 0.2));
+  }
+  closes[7] = NAN;
+
+  return AssetHistory{{"Close", closes}, {"Open", opens}};
+}
+
+void expect_same_as_each_bar(const AnyConditionMethod& condition,
+                             AssetSnapshot asset_snapshot)
+{
+  const auto context = AnySeriesMethodContext{};
+  const auto column = condition.compute_column(asset_snapshot, context);
+
+  ASSERT_EQ(column.size(), asset_snapshot.size());
+  for(auto i = 0uz; i < asset_snapshot.size(); ++i) {
+    const auto bar_snapshot = asset_snapshot[asset_snapshot.size() - 1 - i];
+    EXPECT_EQ(column[i], condition(bar_snapshot, context)) << "bar " << i;
+  }
+}
+
+} // namespace
+
+TEST(ConditionColumnTest, FillAndCount)
+{
+  const auto all_true = ConditionColumn{70, true};
+  const auto all_false = ConditionColumn{70};
+
+  EXPECT_EQ(all_true.size(), 70);
+  EXPECT_EQ(all_true.count(), 70);
+  EXPECT_EQ(all_false.count(), 0);
+  EXPECT_EQ(all_true.transform(std::logical_not<>{}), all_false);
+}
+
+TEST(ConditionColumnTest, SetAndLag)
+{
+  auto column = ConditionColumn{130};
+  column.set(0, true);
+  column.set(63, true);
+  column.set(129, true);
+
+  const auto lagged = column.lagged(1);
+  EXPECT_EQ(lagged.count(), 2);
+  EXPECT_FALSE(lagged[0]);
+  EXPECT_TRUE(lagged[1]);
+  EXPECT_TRUE(lagged[64]);
+
+  EXPECT_EQ(column.lagged(64).count(), 2);
+  EXPECT_TRUE(column.lagged(64)[127]);
+  EXPECT_EQ(column.lagged(130).count(), 0);
+}
+
+TEST(ConditionColumnTest, MatchesEachBar)
+{
+  const auto asset_history = make_asset_history(150);
+  const auto asset_snapshot = AssetSnapshot{asset_history};
+
+  const auto above = GreaterThanMethod{CloseMethod{}, ValueMethod{50.0}};
+  const auto below = LessEqualMethod{CloseMethod{}, OpenMethod{}};
+  const auto not_equal = NotEqualMethod{CloseMethod{}, ValueMethod{50.0}};
+  const auto crossover = CrossoverMethod{CloseMethod{}, OpenMethod{}};
+  const auto crossunder = CrossunderMethod{CloseMethod{}, OpenMethod{}};
+
+  expect_same_as_each_bar(above, asset_snapshot);
+  expect_same_as_each_bar(below, asset_snapshot);
+  expect_same_as_each_bar(not_equal, asset_snapshot);
+  expect_same_as_each_bar(crossover, asset_snapshot);
+  expect_same_as_each_bar(crossunder, asset_snapshot);
+
+  expect_same_as_each_bar(AllOfMethod{above, crossover}, asset_snapshot);
+  expect_same_as_each_bar(AnyOfMethod{below, crossunder}, asset_snapshot);
+  expect_same_as_each_bar(AllOfMethod{}, asset_snapshot);
+  expect_same_as_each_bar(AnyOfMethod{}, asset_snapshot);
+  expect_same_as_each_bar(AndMethod{above, below}, asset_snapshot);
+  expect_same_as_each_bar(OrMethod{above, below}, asset_snapshot);
+  expect_same_as_each_bar(XorMethod{above, not_equal}, asset_snapshot);
+  expect_same_as_each_bar(NotMethod{crossover}, asset_snapshot);
+  expect_same_as_each_bar(AlwaysMethod{}, asset_snapshot);
+  expect_same_as_each_bar(NeverMethod{}, asset_snapshot);
+
+  expect_same_as_each_bar(above, asset_snapshot[20]);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+import pludux;
+
+using namespace pludux;
+
+class ConditionStatisticsTest : public ::testing::Test {
+protected:
+  AssetHistory asset_history{{"Close", {10.0, 20.0, 30.0, 40.0}}};
+  SeriesMethodRegistry registry;
+  SeriesResultsCollector results_collector;
+  SeriesResultsCollector series_columns;
+  IndicatorCache indicator_cache;
+  LinkedSeries linked_series;
+  ConditionStatistics condition_statistics;
+
+  auto make_context() -> DefaultMethodContext
+  {
+    return DefaultMethodContext{
+     registry,
+     results_collector,
+     {.series_columns = &series_columns,
+      .indicator_cache = &indicator_cache,
+      .linked_series = &linked_series,
+      .condition_statistics = &condition_statistics}};
+  }
+};
+
+TEST_F(ConditionStatisticsTest, AllOfMovesUndecidingClauseLast)
+{
+  const auto condition = AnyConditionMethod{AllOfMethod{
+   AlwaysMethod{}, GreaterThanMethod{CloseMethod{}, ValueMethod{25.0}}}};
+  const auto asset_snapshot = AssetSnapshot{asset_history};
+  const auto context = make_context();
+
+  const auto evaluation_count = ClauseOrder::reorder_interval;
+  for(auto i = 0uz; i < evaluation_count; ++i) {
+    const auto bar_snapshot = asset_snapshot[i % asset_snapshot.size()];
+    EXPECT_EQ(condition(bar_snapshot, context),
+              condition(bar_snapshot, AnySeriesMethodContext{}));
+  }
+
+  ASSERT_EQ(condition_statistics.size(), 1);
+  const auto& clause_order = condition_statistics.clause_orders().front();
+  EXPECT_FALSE(clause_order.deciding_result());
+  EXPECT_EQ(clause_order.evaluation_count(), evaluation_count);
+  EXPECT_EQ(clause_order.order(), (std::vector<std::size_t>{1, 0}));
+
+  const auto& clauses = clause_order.clauses();
+  EXPECT_EQ(clauses[0].evaluation_count, evaluation_count);
+  EXPECT_DOUBLE_EQ(clauses[0].hit_rate(), 1.0);
+  EXPECT_EQ(clauses[1].evaluation_count, evaluation_count);
+  EXPECT_DOUBLE_EQ(clauses[1].hit_rate(), 0.5);
+
+  const auto bar_snapshot = asset_snapshot[3];
+  EXPECT_FALSE(condition(bar_snapshot, context));
+  EXPECT_EQ(clauses[0].evaluation_count, evaluation_count);
+}
+
+TEST_F(ConditionStatisticsTest, ColumnSkipsDecidedClauses)
+{
+  const auto all_of = AnyConditionMethod{AllOfMethod{
+   NeverMethod{}, GreaterThanMethod{CloseMethod{}, ValueMethod{25.0}}}};
+  const auto any_of = AnyConditionMethod{AnyOfMethod{
+   AlwaysMethod{}, GreaterThanMethod{CloseMethod{}, ValueMethod{25.0}}}};
+  const auto asset_snapshot = AssetSnapshot{asset_history};
+  const auto context = make_context();
+
+  EXPECT_EQ(all_of.compute_column(asset_snapshot, context).count(), 0);
+  EXPECT_EQ(any_of.compute_column(asset_snapshot, context).count(),
+            asset_snapshot.size());
+
+  // Columns follow the declared order and leave the statistics alone.
+  EXPECT_EQ(condition_statistics.size(), 0);
+}
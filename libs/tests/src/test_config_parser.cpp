@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 #include <jsoncons/json.hpp>
 
 import pludux;
@@ -1852,3 +1854,155 @@ TEST_F(ConfigParserTest, SeriesMethodRegistrySerializationDeserialization)
   EXPECT_EQ(deserialized_config, deserialized_registry);
   EXPECT_EQ(registry, deserialized_registry);
 }
+
+TEST_F(ConfigParserTest, ShareCommonMethods)
+{
+  const auto config = json::parse(R"(
+    {
+      "series": {
+        "spread": {
+          "method": "SUBTRACT",
+          "params": {
+            "minuend": {"method": "EMA", "params": {"period": 5}},
+            "subtrahend": {"method": "SMA", "params": {"period": 10}}
+          }
+        },
+        "fast": {
+          "method": "EMA",
+          "params": {"period": 5, "source": "CLOSE"}
+        }
+      },
+      "signal": {
+        "method": "GREATER_THAN",
+        "params": {
+          "target": {"method": "EMA", "params": {"period": 5}},
+          "threshold": {"method": "SMA", "params": {"period": 20}}
+        }
+      }
+    }
+  )");
+
+  config_parser.share_common_methods(config);
+
+  const auto registry =
+   config_parser.parse_registered_methods(config.at("series"));
+  const auto fast_method = *registry.get("fast");
+  const auto shared_ema =
+   series_method_cast<SharedSeriesMethod<AnySeriesMethod>>(fast_method);
+  ASSERT_NE(shared_ema, nullptr);
+  EXPECT_NE(series_method_cast<CachedResultsEmaMethod<AnySeriesMethod>>(
+             shared_ema->method()),
+            nullptr);
+
+  const auto spread_method = *registry.get("spread");
+  const auto subtract_method =
+   series_method_cast<SubtractMethod<AnySeriesMethod, AnySeriesMethod>>(
+    spread_method);
+  ASSERT_NE(subtract_method, nullptr);
+  EXPECT_EQ(subtract_method->minuend(), fast_method);
+  EXPECT_EQ(series_method_cast<SharedSeriesMethod<AnySeriesMethod>>(
+             subtract_method->subtrahend()),
+            nullptr);
+
+  const auto serialized_config = config_parser.serialize_method(fast_method);
+  EXPECT_EQ(serialized_config,
+            config_parser.serialize_method(
+             CachedResultsEmaMethod<AnySeriesMethod>{CloseMethod{}, 5}));
+
+  config_parser.clear_common_methods();
+
+  const auto unshared_method =
+   config_parser.parse_method(config.at("series").at("fast"));
+  EXPECT_EQ(series_method_cast<SharedSeriesMethod<AnySeriesMethod>>(
+             unshared_method),
+            nullptr);
+}
+
+TEST_F(ConfigParserTest, ShareCommonNestedMethods)
+{
+  const auto config = json::parse(R"(
+    {
+      "slow": {
+        "method": "SMA",
+        "params": {
+          "period": 20,
+          "source": {"method": "EMA", "params": {"period": 5}}
+        }
+      },
+      "fast": {
+        "method": "SMA",
+        "params": {
+          "period": 10,
+          "source": {
+            "method": "EMA",
+            "params": {"period": 5, "source": "CLOSE"}
+          }
+        }
+      }
+    }
+  )");
+
+  config_parser.share_common_methods(config);
+
+  // Only the EMA read by both averages is shared, however it is written.
+  const auto registry = config_parser.parse_registered_methods(config);
+  const auto slow_method = *registry.get("slow");
+  const auto fast_method = *registry.get("fast");
+  const auto slow_sma =
+   series_method_cast<SmaMethod<AnySeriesMethod>>(slow_method);
+  const auto fast_sma =
+   series_method_cast<SmaMethod<AnySeriesMethod>>(fast_method);
+  ASSERT_NE(slow_sma, nullptr);
+  ASSERT_NE(fast_sma, nullptr);
+
+  EXPECT_NE(series_method_cast<SharedSeriesMethod<AnySeriesMethod>>(
+             slow_sma->source()),
+            nullptr);
+  EXPECT_EQ(slow_sma->source(), fast_sma->source());
+}
+
+TEST_F(ConfigParserTest, ParseLinkedSeriesNodeMethod)
+{
+  const auto config = json::parse(R"(
+    {
+      "method": "SERIES_NODE",
+      "params": {
+        "name": "close"
+      }
+    }
+  )");
+
+  const auto unlinked_method = config_parser.parse_method(config);
+  EXPECT_EQ(series_method_cast<SeriesNodeMethod>(unlinked_method)->slot(),
+            SeriesNodeMethod::unlinked_slot);
+
+  config_parser.link_series({"open", "close"});
+  const auto linked_method = config_parser.parse_method(config);
+  const auto series_node_method =
+   series_method_cast<SeriesNodeMethod>(linked_method);
+  ASSERT_NE(series_node_method, nullptr);
+  EXPECT_EQ(series_node_method->slot(), 1);
+  EXPECT_EQ(linked_method, unlinked_method);
+
+  config_parser.clear_linked_series();
+  EXPECT_EQ(series_method_cast<SeriesNodeMethod>(
+             config_parser.parse_method(config))
+             ->slot(),
+            SeriesNodeMethod::unlinked_slot);
+}
+
+TEST_F(ConfigParserTest, ParseLinkedUnknownSeriesThrows)
+{
+  const auto config = json::parse(R"(
+    {
+      "method": "SERIES_VALUE",
+      "params": {
+        "name": "volume"
+      }
+    }
+  )");
+
+  config_parser.link_series({"open", "close"});
+
+  EXPECT_THROW(config_parser.parse_method(config), std::invalid_argument);
+}
@@ -1,12 +1,34 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <cstddef>
+#include <memory>
 #include <variant>
 
 import pludux;
 
 using namespace pludux;
 
+namespace {
+
+struct CountedCloseMethod {
+  using ResultType = double;
+
+  std::shared_ptr<std::size_t> evaluation_count{
+   std::make_shared<std::size_t>(0)};
+
+  auto operator==(const CountedCloseMethod&) const noexcept -> bool = default;
+
+  auto operator()(AssetSnapshot asset_snapshot,
+                  MethodContextable auto) const noexcept -> ResultType
+  {
+    ++*evaluation_count;
+    return asset_snapshot.close();
+  }
+};
+
+} // namespace
+
 TEST(EmaMethodTest, ConstructorInitialization)
 {
   {
@@ -49,6 +71,55 @@ TEST(EmaMethodTest, RunAllMethod)
   EXPECT_TRUE(std::isnan(ema_method(asset_snapshot[9], context)));
 }
 
+TEST(EmaMethodTest, RunForwardBarByBar)
+{
+  const auto ema_method = EmaMethod{CloseMethod{}, 5};
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_TRUE(std::isnan(ema_method(asset_snapshot[6], context)));
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot[5], context), 842);
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot[4], context), 853);
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot[3], context), 855.33333333333337);
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot[2], context), 856.88888888888891);
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot[1], context), 857.92592592592598);
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot[0], context), 856.95061728395069);
+}
+
+TEST(EmaMethodTest, RunForwardEvaluatesEachBarOnce)
+{
+  const auto close_method = CountedCloseMethod{};
+  const auto ema_method = EmaMethod{close_method, 5};
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  for(auto lookback = asset_snapshot.size(); lookback-- > 0;) {
+    ema_method(asset_snapshot[lookback], context);
+  }
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot, context), 856.95061728395069);
+
+  // The SMA seeding the first value reads 5 closes, and every later bar one.
+  EXPECT_EQ(*close_method.evaluation_count, 10);
+}
+
+TEST(EmaMethodTest, RunOnAnotherHistory)
+{
+  const auto ema_method = EmaMethod{CloseMethod{}, 2};
+  const auto context = std::monostate{};
+
+  const auto asset_data1 = AssetHistory{{"Close", {4, 2, 6}}};
+  const auto asset_snapshot1 = AssetSnapshot{asset_data1};
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot1, context), 4);
+
+  const auto asset_data2 = AssetHistory{{"Close", {10, 4, 2}}};
+  const auto asset_snapshot2 = AssetSnapshot{asset_data2};
+  EXPECT_DOUBLE_EQ(ema_method(asset_snapshot2, context), 23.0 / 3);
+}
+
 TEST(EmaMethodTest, EqualityOperator)
 {
   const auto ema_method1 = EmaMethod{CloseMethod{}, 5};
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <variant>
+
+import pludux;
+
+using namespace pludux;
+
+TEST(HighestMethodTest, ConstructorInitialization)
+{
+  {
+    auto highest_method = HighestMethod{};
+
+    EXPECT_EQ(highest_method.period(), 14);
+    EXPECT_EQ(highest_method.source(), CloseMethod{});
+  }
+  {
+    const auto highest_method = HighestMethod{HighMethod{}, 5};
+
+    EXPECT_EQ(highest_method.period(), 5);
+    EXPECT_EQ(highest_method.source(), HighMethod{});
+  }
+}
+
+TEST(HighestMethodTest, RunAllMethod)
+{
+  const auto highest_method = HighestMethod{CloseMethod{}, 3};
+  const auto asset_data =
+   AssetHistory{{"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[0], context), 875);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[1], context), 835);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[2], context), 870);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[3], context), 875);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[4], context), 875);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[5], context), 875);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[6], context), 860);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[7], context), 860);
+  EXPECT_TRUE(std::isnan(highest_method(asset_snapshot[8], context)));
+  EXPECT_TRUE(std::isnan(highest_method(asset_snapshot[9], context)));
+}
+
+TEST(HighestMethodTest, NegativeValues)
+{
+  const auto highest_method = HighestMethod{CloseMethod{}, 3};
+  const auto asset_data = AssetHistory{{"Close", {-5, -3, -4, -8, -2, -6}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[0], context), -2);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[1], context), -2);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[2], context), -3);
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[3], context), -3);
+  EXPECT_TRUE(std::isnan(highest_method(asset_snapshot[4], context)));
+}
+
+TEST(HighestMethodTest, SkipsNaNValues)
+{
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  const auto highest_method = HighestMethod{CloseMethod{}, 3};
+  const auto asset_data = AssetHistory{{"Close", {1, nan, nan, nan, 4}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[0], context), 4);
+  EXPECT_TRUE(std::isnan(highest_method(asset_snapshot[1], context)));
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot[2], context), 1);
+}
+
+TEST(HighestMethodTest, IncrementalMatchesWindowScan)
+{
+  const auto highest_method = HighestMethod{CloseMethod{}, 4};
+  const auto asset_data = AssetHistory{
+   {"Close",
+    {855, 860, 860, 860, 875, 870, 835, 800, 830, 875, 880, 845, 850, 820}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  for(auto i = 0uz; i < asset_snapshot.size(); ++i) {
+    const auto expected = highest_method(asset_snapshot[i], std::monostate{});
+    const auto result = highest_method(asset_snapshot[i], context);
+    if(std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << "lookback " << i;
+    } else {
+      EXPECT_DOUBLE_EQ(result, expected) << "lookback " << i;
+    }
+  }
+  EXPECT_EQ(indicator_cache.size(), 1);
+}
+
+TEST(HighestMethodTest, EqualityOperator)
+{
+  const auto highest_method1 = HighestMethod{CloseMethod{}, 5};
+  const auto highest_method2 = HighestMethod{CloseMethod{}, 5};
+  const auto highest_method3 = HighestMethod{CloseMethod{}, 6};
+
+  EXPECT_EQ(highest_method1, highest_method2);
+  EXPECT_NE(highest_method1, highest_method3);
+}
@@ -48,6 +48,34 @@ TEST(HmaMethodTest, RunAllMethod)
   EXPECT_TRUE(std::isnan(hma_method(asset_snapshot[9], context)));
 }
 
+TEST(HmaMethodTest, IncrementalMatchesWindowScan)
+{
+  const auto hma_method = HmaMethod{CloseMethod{}, 5};
+  const auto asset_data = AssetHistory{
+   {"Close",
+    {855, 860, 860, 860, 875, 870, 835, 800, 830, 875, 880, 845, 850, 820}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  for(auto i = 0uz; i < asset_snapshot.size(); ++i) {
+    const auto expected = hma_method(asset_snapshot[i], std::monostate{});
+    const auto result = hma_method(asset_snapshot[i], context);
+    if(std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << "lookback " << i;
+    } else {
+      EXPECT_DOUBLE_EQ(result, expected) << "lookback " << i;
+    }
+  }
+}
+
 TEST(HmaMethodTest, EqualityOperator)
 {
   const auto hma_method1 = HmaMethod{CloseMethod{}, 5};
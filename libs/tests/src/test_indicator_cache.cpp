@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+import pludux;
+
+using namespace pludux;
+
+namespace {
+
+/**
+ * The close of every bar, counting the columns it computes.
+ */
+struct CountedCloseMethod {
+  using ResultType = double;
+
+  std::shared_ptr<std::size_t> column_count{std::make_shared<std::size_t>(0)};
+
+  auto operator==(const CountedCloseMethod&) const noexcept -> bool = default;
+
+  auto operator()(AssetSnapshot asset_snapshot,
+                  MethodContextable auto) const noexcept -> ResultType
+  {
+    return asset_snapshot.close();
+  }
+
+  auto operator()(AssetSnapshot,
+                  SeriesOutput,
+                  MethodContextable auto) const noexcept -> ResultType
+  {
+    return std::numeric_limits<ResultType>::quiet_NaN();
+  }
+
+  auto compute_column(AssetSnapshot asset_snapshot,
+                      MethodContextable auto context) const
+   -> std::vector<ResultType>
+  {
+    ++*column_count;
+    return compute_series_column(CloseMethod{}, asset_snapshot, context);
+  }
+};
+
+} // namespace
+
+TEST(IndicatorCacheTest, SameStructureSharesResults)
+{
+  auto indicator_cache = IndicatorCache{};
+
+  auto& results1 = indicator_cache.results(EmaMethod{CloseMethod{}, 5});
+  auto& results2 = indicator_cache.results(EmaMethod{CloseMethod{}, 5});
+  auto& results3 = indicator_cache.results(EmaMethod{CloseMethod{}, 10});
+  auto& results4 = indicator_cache.results(EmaMethod{OpenMethod{}, 5});
+
+  EXPECT_EQ(&results1, &results2);
+  EXPECT_NE(&results1, &results3);
+  EXPECT_NE(&results1, &results4);
+  EXPECT_EQ(indicator_cache.size(), 3);
+
+  indicator_cache.clear();
+  EXPECT_EQ(indicator_cache.size(), 0);
+}
+
+TEST(IndicatorCacheTest, StructuralHash)
+{
+  EXPECT_EQ(series_method_hash(RmaMethod{CloseMethod{}, 14}),
+            series_method_hash(RmaMethod{CloseMethod{}, 14}));
+  EXPECT_EQ(series_method_hash(AnySeriesMethod{RmaMethod{CloseMethod{}, 14}}),
+            series_method_hash(RmaMethod{CloseMethod{}, 14}));
+  EXPECT_NE(series_method_hash(RmaMethod{CloseMethod{}, 14}),
+            series_method_hash(RmaMethod{CloseMethod{}, 7}));
+}
+
+TEST(IndicatorCacheTest, CopyStartsEmpty)
+{
+  auto indicator_cache = IndicatorCache{};
+  indicator_cache.results(EmaMethod{CloseMethod{}, 5});
+
+  const auto copied_cache = indicator_cache;
+
+  EXPECT_EQ(indicator_cache.size(), 1);
+  EXPECT_EQ(copied_cache.size(), 0);
+}
+
+TEST(IndicatorCacheTest, MethodsUseContextCache)
+{
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  const auto ema_method1 = EmaMethod{CloseMethod{}, 5};
+  const auto ema_method2 = AnySeriesMethod{EmaMethod{CloseMethod{}, 5}};
+
+  EXPECT_DOUBLE_EQ(ema_method1(asset_snapshot, context), 856.95061728395069);
+  EXPECT_DOUBLE_EQ(ema_method2(asset_snapshot[1], context),
+                   857.92592592592598);
+  EXPECT_EQ(indicator_cache.size(), 1);
+}
+
+TEST(IndicatorCacheTest, SharedMethodIsComputedOncePerBar)
+{
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  const auto sma_method = SmaMethod{CloseMethod{}, 5};
+  const auto shared_method = SharedSeriesMethod{sma_method};
+  const auto highest_method = HighestMethod{shared_method, 3};
+  const auto lowest_method = LowestMethod{shared_method, 3};
+
+  EXPECT_DOUBLE_EQ(shared_method(asset_snapshot, context),
+                   sma_method(asset_snapshot, context));
+  EXPECT_DOUBLE_EQ(highest_method(asset_snapshot, context), 865);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot, context), 860);
+
+  // The shared SMA, and the windows of the highest and the lowest.
+  EXPECT_EQ(indicator_cache.size(), 3);
+}
+
+TEST(IndicatorCacheTest, SharedMethodColumnIsComputedOncePerRun)
+{
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  const auto close_method = CountedCloseMethod{};
+  const auto shared_method = SharedSeriesMethod{close_method};
+  const auto highest_method = HighestMethod{shared_method, 3};
+  const auto lowest_method = LowestMethod{shared_method, 3};
+
+  const auto highests =
+   compute_series_column(highest_method, asset_snapshot, context);
+  const auto lowests =
+   compute_series_column(lowest_method, asset_snapshot, context);
+  EXPECT_DOUBLE_EQ(highests.back(), 860);
+  EXPECT_DOUBLE_EQ(lowests.back(), 855);
+
+  // A later snapshot is cut from the column of the whole history.
+  const auto closes =
+   compute_series_column(shared_method, asset_snapshot[2], context);
+  EXPECT_EQ(closes,
+            (std::vector<double>{875, 830, 800, 835, 870, 875, 860, 860}));
+
+  EXPECT_EQ(*close_method.column_count, 1);
+}
+
+TEST(IndicatorCacheTest, ColumnIsKeyedByHistoryRevision)
+{
+  const auto asset_data = AssetHistory{{"Close", {855, 860, 860, 860}}};
+  const auto other_asset_data = AssetHistory{{"Close", {875, 870, 835, 800}}};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto context = DefaultMethodContext{registry, results_collector};
+
+  auto indicator_cache = IndicatorCache{};
+  const auto close_method = CloseMethod{};
+  auto compute_count = 0uz;
+  const auto compute_closes = [&](AssetSnapshot asset_snapshot) {
+    return [&, asset_snapshot] {
+      ++compute_count;
+      return compute_series_column(close_method, asset_snapshot, context);
+    };
+  };
+
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto closes = indicator_cache.column(
+   close_method, std::nullopt, asset_snapshot, compute_closes(asset_snapshot));
+  EXPECT_EQ(std::vector<double>(closes.begin(), closes.end()),
+            (std::vector<double>{860, 860, 860, 855}));
+  EXPECT_EQ(indicator_cache.column_bytes(), 4 * sizeof(double));
+
+  // A later snapshot of the same history reads a prefix of the column.
+  const auto prefix = indicator_cache.column(close_method,
+                                             std::nullopt,
+                                             asset_snapshot[1],
+                                             compute_closes(asset_snapshot));
+  EXPECT_EQ(prefix.size(), 3);
+  EXPECT_EQ(prefix.data(), closes.data());
+  EXPECT_EQ(compute_count, 1);
+
+  // Another history has its own revision, so the column is computed again.
+  const auto other_asset_snapshot = AssetSnapshot{other_asset_data};
+  const auto other_closes =
+   indicator_cache.column(close_method,
+                          std::nullopt,
+                          other_asset_snapshot,
+                          compute_closes(other_asset_snapshot));
+  EXPECT_EQ(std::vector<double>(other_closes.begin(), other_closes.end()),
+            (std::vector<double>{800, 835, 870, 875}));
+  EXPECT_EQ(compute_count, 2);
+  EXPECT_EQ(indicator_cache.column_bytes(), 4 * sizeof(double));
+
+  indicator_cache.clear();
+  EXPECT_EQ(indicator_cache.column_bytes(), 0);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <variant>
+
+import pludux;
+
+using namespace pludux;
+
+TEST(LowestMethodTest, ConstructorInitialization)
+{
+  {
+    auto lowest_method = LowestMethod{};
+
+    EXPECT_EQ(lowest_method.period(), 14);
+    EXPECT_EQ(lowest_method.source(), CloseMethod{});
+  }
+  {
+    const auto lowest_method = LowestMethod{HighMethod{}, 5};
+
+    EXPECT_EQ(lowest_method.period(), 5);
+    EXPECT_EQ(lowest_method.source(), HighMethod{});
+  }
+}
+
+TEST(LowestMethodTest, RunAllMethod)
+{
+  const auto lowest_method = LowestMethod{CloseMethod{}, 3};
+  const auto asset_data =
+   AssetHistory{{"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[0], context), 800);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[1], context), 800);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[2], context), 800);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[3], context), 835);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[4], context), 860);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[5], context), 860);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[6], context), 860);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[7], context), 855);
+  EXPECT_TRUE(std::isnan(lowest_method(asset_snapshot[8], context)));
+  EXPECT_TRUE(std::isnan(lowest_method(asset_snapshot[9], context)));
+}
+
+TEST(LowestMethodTest, NegativeValues)
+{
+  const auto lowest_method = LowestMethod{CloseMethod{}, 3};
+  const auto asset_data = AssetHistory{{"Close", {-5, -3, -4, -8, -2, -6}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[0], context), -8);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[1], context), -8);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[2], context), -8);
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[3], context), -5);
+  EXPECT_TRUE(std::isnan(lowest_method(asset_snapshot[4], context)));
+}
+
+TEST(LowestMethodTest, SkipsNaNValues)
+{
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  const auto lowest_method = LowestMethod{CloseMethod{}, 3};
+  const auto asset_data = AssetHistory{{"Close", {1, nan, nan, nan, 4}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[0], context), 4);
+  EXPECT_TRUE(std::isnan(lowest_method(asset_snapshot[1], context)));
+  EXPECT_DOUBLE_EQ(lowest_method(asset_snapshot[2], context), 1);
+}
+
+TEST(LowestMethodTest, IncrementalMatchesWindowScan)
+{
+  const auto lowest_method = LowestMethod{CloseMethod{}, 4};
+  const auto asset_data = AssetHistory{
+   {"Close",
+    {855, 860, 860, 860, 875, 870, 835, 800, 830, 875, 880, 845, 850, 820}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  for(auto i = 0uz; i < asset_snapshot.size(); ++i) {
+    const auto expected = lowest_method(asset_snapshot[i], std::monostate{});
+    const auto result = lowest_method(asset_snapshot[i], context);
+    if(std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << "lookback " << i;
+    } else {
+      EXPECT_DOUBLE_EQ(result, expected) << "lookback " << i;
+    }
+  }
+  EXPECT_EQ(indicator_cache.size(), 1);
+}
+
+TEST(LowestMethodTest, EqualityOperator)
+{
+  const auto lowest_method1 = LowestMethod{CloseMethod{}, 5};
+  const auto lowest_method2 = LowestMethod{CloseMethod{}, 5};
+  const auto lowest_method3 = LowestMethod{CloseMethod{}, 6};
+
+  EXPECT_EQ(lowest_method1, lowest_method2);
+  EXPECT_NE(lowest_method1, lowest_method3);
+}
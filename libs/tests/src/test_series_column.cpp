@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+import pludux;
+
+using namespace pludux;
+
+namespace {
+
+void expect_column_matches_bars(const auto& method,
+                                AssetSnapshot asset_snapshot,
+                                auto context)
+{
+  const auto column = compute_series_column(method, asset_snapshot, context);
+  ASSERT_EQ(column.size(), asset_snapshot.size());
+
+  for(auto i = 0uz; i < column.size(); ++i) {
+    const auto lookback = column.size() - 1 - i;
+    const auto expected = method(asset_snapshot[lookback], context);
+    if(std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(column[i])) << "bar " << i;
+    } else {
+      EXPECT_DOUBLE_EQ(column[i], expected) << "bar " << i;
+    }
+  }
+}
+
+} // namespace
+
+TEST(SeriesColumnTest, SmaColumn)
+{
+  const auto sma_method = SmaMethod{CloseMethod{}, 5};
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  const auto column = compute_series_column(sma_method, asset_snapshot, context);
+
+  ASSERT_EQ(column.size(), 10);
+  EXPECT_TRUE(std::isnan(column[0]));
+  EXPECT_TRUE(std::isnan(column[1]));
+  EXPECT_TRUE(std::isnan(column[2]));
+  EXPECT_TRUE(std::isnan(column[3]));
+  EXPECT_DOUBLE_EQ(column[4], 842);
+  EXPECT_DOUBLE_EQ(column[5], 842);
+  EXPECT_DOUBLE_EQ(column[6], 848);
+  EXPECT_DOUBLE_EQ(column[7], 860);
+  EXPECT_DOUBLE_EQ(column[8], 865);
+  EXPECT_DOUBLE_EQ(column[9], 862);
+}
+
+TEST(SeriesColumnTest, EmaColumn)
+{
+  const auto ema_method = EmaMethod{CloseMethod{}, 5};
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  const auto column = compute_series_column(ema_method, asset_snapshot, context);
+
+  ASSERT_EQ(column.size(), 10);
+  EXPECT_TRUE(std::isnan(column[3]));
+  EXPECT_DOUBLE_EQ(column[4], 842);
+  EXPECT_DOUBLE_EQ(column[5], 853);
+  EXPECT_DOUBLE_EQ(column[6], 855.33333333333337);
+  EXPECT_DOUBLE_EQ(column[7], 856.88888888888891);
+  EXPECT_DOUBLE_EQ(column[8], 857.92592592592598);
+  EXPECT_DOUBLE_EQ(column[9], 856.95061728395069);
+}
+
+TEST(SeriesColumnTest, ColumnOfSnapshotWithLookback)
+{
+  const auto sma_method = SmaMethod{CloseMethod{}, 5};
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  const auto column =
+   compute_series_column(sma_method, asset_snapshot[3], context);
+
+  ASSERT_EQ(column.size(), 7);
+  EXPECT_DOUBLE_EQ(column[6], 848);
+}
+
+TEST(SeriesColumnTest, ColumnsMatchBars)
+{
+  const auto asset_data = AssetHistory{
+   {"Open", {850, 865, 860, 870, 880, 860, 830, 810, 845, 870}},
+   {"High", {860, 870, 865, 875, 885, 875, 840, 820, 850, 880}},
+   {"Low", {845, 855, 850, 855, 860, 850, 825, 790, 820, 860}},
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}},
+   {"Volume", {10, 20, 15, 30, 25, 20, 40, 35, 30, 25}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = std::monostate{};
+
+  expect_column_matches_bars(ValueMethod{3.0}, asset_snapshot, context);
+  expect_column_matches_bars(DataMethod{"Volume"}, asset_snapshot, context);
+  expect_column_matches_bars(ChangeMethod{}, asset_snapshot, context);
+  expect_column_matches_bars(
+   LookbackMethod{CloseMethod{}, 2}, asset_snapshot, context);
+  expect_column_matches_bars(RmaMethod{HighMethod{}, 3}, asset_snapshot, context);
+  expect_column_matches_bars(
+   StddevMethod{CloseMethod{}, 4}, asset_snapshot, context);
+  expect_column_matches_bars(
+   HighestMethod{HighMethod{}, 3}, asset_snapshot, context);
+  expect_column_matches_bars(
+   LowestMethod{LowMethod{}, 3}, asset_snapshot, context);
+  expect_column_matches_bars(WmaMethod{CloseMethod{}, 4}, asset_snapshot, context);
+  expect_column_matches_bars(HmaMethod{CloseMethod{}, 5}, asset_snapshot, context);
+  expect_column_matches_bars(RocMethod{CloseMethod{}, 3}, asset_snapshot, context);
+  expect_column_matches_bars(
+   SubtractMethod{HighMethod{}, LowMethod{}}, asset_snapshot, context);
+  expect_column_matches_bars(
+   AbsMethod{ChangeMethod{OpenMethod{}}}, asset_snapshot, context);
+  expect_column_matches_bars(
+   SmaMethod{DivideMethod{VolumeMethod{}, ValueMethod{5.0}}, 3},
+   asset_snapshot,
+   context);
+  expect_column_matches_bars(MacdMethod{}, asset_snapshot, context);
+  expect_column_matches_bars(BbMethod{5, 2.0}, asset_snapshot, context);
+  expect_column_matches_bars(
+   SelectOutputMethod{BbMethod{5, 2.0}, SeriesOutput::UpperBand},
+   asset_snapshot,
+   context);
+  expect_column_matches_bars(
+   SelectOutputMethod{BbMethod{MaMethodType::Ema, CloseMethod{}, 4, 1.5},
+                      SeriesOutput::LowerBand},
+   asset_snapshot,
+   context);
+  expect_column_matches_bars(StochMethod{5, 3, 2}, asset_snapshot, context);
+  expect_column_matches_bars(
+   SelectOutputMethod{StochMethod{5, 3, 2}, SeriesOutput::DPercent},
+   asset_snapshot,
+   context);
+  expect_column_matches_bars(
+   StochRsiMethod{CloseMethod{}, 3, 3, 2, 2}, asset_snapshot, context);
+}
+
+TEST(SeriesColumnTest, AnySeriesMethodColumn)
+{
+  const auto asset_data = AssetHistory{
+   {"Close", {855, 860, 860, 860, 875, 870, 835, 800, 830, 875}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+  const auto context = AnySeriesMethodContext{};
+
+  const auto any_method =
+   AnySeriesMethod{EmaMethod{AnySeriesMethod{CloseMethod{}}, 3}};
+
+  expect_column_matches_bars(any_method, asset_snapshot, context);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+
+import pludux;
+
+using namespace pludux;
+
+namespace {
+
+// Longer than two blocks of 64 bars, with a partial block at the end.
+constexpr auto column_size = 150uz;
+
+auto make_column(double offset) -> std::vector<double>
+{
+  auto column = std::vector<double>{};
+  for(auto i = 0uz; i < column_size; ++i) {
+    column.push_back(i % 17 == 0 ? std::numeric_limits<double>::quiet_NaN()
+                                 : offset + std::sin(static_cast<double>(i)));
+  }
+  return column;
+}
+
+void expect_same_values(const std::vector<double>& results,
+                        const std::vector<double>& expected)
+{
+  ASSERT_EQ(results.size(), expected.size());
+  for(auto i = 0uz; i < results.size(); ++i) {
+    if(std::isnan(expected[i])) {
+      EXPECT_TRUE(std::isnan(results[i])) << "bar " << i;
+    } else {
+      EXPECT_EQ(results[i], expected[i]) << "bar " << i;
+    }
+  }
+}
+
+void expect_binary_kernel(auto binary_fn)
+{
+  const auto lhs = make_column(0.5);
+  const auto rhs = make_column(-0.25);
+
+  auto expected = std::vector<double>(column_size);
+  for(auto i = 0uz; i < column_size; ++i) {
+    expected[i] = binary_fn(lhs[i], rhs[i]);
+  }
+
+  auto results = std::vector<double>(column_size);
+  transform_columns(lhs, rhs, binary_fn, results);
+  expect_same_values(results, expected);
+}
+
+void expect_compare_kernel(auto comparator)
+{
+  const auto lhs = make_column(0.0);
+  auto rhs = make_column(0.0);
+  for(auto i = 0uz; i < column_size; i += 3) {
+    rhs[i] = std::cos(static_cast<double>(i));
+  }
+
+  auto words = std::vector<std::uint64_t>((column_size + 63) / 64);
+  compare_columns(lhs, rhs, comparator, words);
+
+  for(auto i = 0uz; i < column_size; ++i) {
+    const auto bit = (words[i / 64] >> (i % 64)) & 1;
+    EXPECT_EQ(bit != 0, comparator(lhs[i], rhs[i])) << "bar " << i;
+  }
+  EXPECT_EQ(words.back() >> (column_size % 64), 0);
+}
+
+} // namespace
+
+TEST(SeriesKernelsTest, BinaryKernelsMatchScalar)
+{
+  expect_binary_kernel(std::plus<>{});
+  expect_binary_kernel(std::minus<>{});
+  expect_binary_kernel(std::multiplies<>{});
+  expect_binary_kernel(std::divides<>{});
+  expect_binary_kernel([](double lhs, double rhs) { return lhs * 2 + rhs; });
+}
+
+TEST(SeriesKernelsTest, UnaryKernelsMatchScalar)
+{
+  const auto values = make_column(-0.5);
+
+  auto expected = std::vector<double>(column_size);
+  auto results = std::vector<double>(column_size);
+
+  for(auto i = 0uz; i < column_size; ++i) {
+    expected[i] = -values[i];
+  }
+  transform_column(values, std::negate<>{}, results);
+  expect_same_values(results, expected);
+
+  for(auto i = 0uz; i < column_size; ++i) {
+    expected[i] = std::abs(values[i]);
+  }
+  abs_column(values, results);
+  expect_same_values(results, expected);
+
+  for(auto i = 0uz; i < column_size; ++i) {
+    expected[i] = values[i] * 0.25;
+  }
+  scale_column(values, 0.25, results);
+  expect_same_values(results, expected);
+}
+
+TEST(SeriesKernelsTest, KernelsRunInPlace)
+{
+  auto values = make_column(1.5);
+  const auto original = values;
+
+  scale_column(values, 2.0, values);
+  for(auto i = 0uz; i < column_size; ++i) {
+    if(!std::isnan(original[i])) {
+      EXPECT_EQ(values[i], original[i] * 2.0) << "bar " << i;
+    }
+  }
+}
+
+TEST(SeriesKernelsTest, PercentChangeMatchesScalar)
+{
+  const auto values = make_column(2.0);
+  const auto bases = make_column(3.0);
+
+  auto expected = std::vector<double>(column_size);
+  for(auto i = 0uz; i < column_size; ++i) {
+    expected[i] = 100 * (values[i] - bases[i]) / bases[i];
+  }
+
+  auto results = std::vector<double>(column_size);
+  percent_change_columns(values, bases, results);
+  expect_same_values(results, expected);
+}
+
+TEST(SeriesKernelsTest, CompareKernelsMatchScalar)
+{
+  expect_compare_kernel(std::greater<>{});
+  expect_compare_kernel(std::greater_equal<>{});
+  expect_compare_kernel(std::less<>{});
+  expect_compare_kernel(std::less_equal<>{});
+  expect_compare_kernel(std::equal_to<>{});
+  expect_compare_kernel(std::not_equal_to<>{});
+}
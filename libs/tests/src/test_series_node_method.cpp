@@ -65,4 +65,44 @@ TEST(SeriesReferenceMethodTest, NotEqualOperator)
 
   EXPECT_TRUE(ref_method1 != ref_method2);
   EXPECT_NE(ref_method1, ref_method2);
-}
\ No newline at end of file
+}
+
+TEST(SeriesReferenceMethodTest, RunLinkedSlot)
+{
+  const auto asset_data =
+   AssetHistory{{"Open", {4.0, 4.1, 4.2}}, {"Close", {1.0, 1.1, 1.2}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  auto registry = SeriesMethodRegistry{};
+  registry.set("open", OpenMethod{});
+  registry.set("close", CloseMethod{});
+
+  auto results_collector = SeriesResultsCollector{};
+  auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto linked_series =
+   LinkedSeries{registry, results_collector, series_columns};
+  auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns,
+    .indicator_cache = &indicator_cache,
+    .linked_series = &linked_series}};
+
+  const auto close_slot = registry.slot("close");
+  ASSERT_TRUE(close_slot.has_value());
+  EXPECT_EQ(*close_slot, 1);
+
+  const auto close_ref_method = SeriesNodeMethod{"close", *close_slot};
+  EXPECT_EQ(close_ref_method.slot(), 1);
+  EXPECT_EQ(close_ref_method, SeriesNodeMethod{"close"});
+  EXPECT_EQ(close_ref_method(asset_snapshot[0], context), 1.0);
+  EXPECT_EQ(close_ref_method(asset_snapshot[2], context), 1.2);
+
+  const auto unlinked_context =
+   DefaultMethodContext{registry, results_collector};
+  EXPECT_EQ(close_ref_method(asset_snapshot[1], unlinked_context), 1.1);
+
+  const auto out_of_range_method = SeriesNodeMethod{"close", 5};
+  EXPECT_TRUE(std::isnan(out_of_range_method(asset_snapshot[0], context)));
+}
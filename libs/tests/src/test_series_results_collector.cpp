@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+import pludux;
+
+using namespace pludux;
+
+TEST(SeriesResultsCollectorTest, CollectBySlot)
+{
+  auto collector =
+   SeriesResultsCollector{std::vector<std::string>{"open", "close"}, 3};
+
+  ASSERT_EQ(collector.size(), 2);
+  EXPECT_EQ(collector.slot("open"), 0);
+  EXPECT_EQ(collector.slot("close"), 1);
+  EXPECT_FALSE(collector.slot("volume").has_value());
+
+  const auto* close_data = collector.results(1).data();
+  for(auto i = 0; i < 3; ++i) {
+    collector.collect(0, 4.0 + i);
+    collector.collect(1, 1.0 + i);
+  }
+
+  const auto close_results = collector.results(1);
+  ASSERT_EQ(close_results.size(), 3);
+  EXPECT_EQ(close_results.data(), close_data);
+  EXPECT_EQ(close_results[2], 3.0);
+
+  const auto open_results = collector.results("open");
+  ASSERT_TRUE(open_results.has_value());
+  EXPECT_EQ((*open_results)[1], 5.0);
+}
+
+TEST(SeriesResultsCollectorTest, CollectByName)
+{
+  auto collector = SeriesResultsCollector{};
+  collector.collect("close", 1.0);
+  collector.collect("close", 1.1);
+  collector.results("open", {4.0, 4.1});
+
+  EXPECT_EQ(collector.series_names(),
+            (std::vector<std::string>{"close", "open"}));
+  EXPECT_EQ(collector.results("close")->size(), 2);
+  EXPECT_EQ((*collector.results("open"))[1], 4.1);
+  EXPECT_FALSE(collector.results("volume").has_value());
+
+  collector.reserve({"open", "volume"}, 10);
+  EXPECT_EQ(collector.size(), 3);
+  EXPECT_EQ(collector.slot("volume"), 2);
+  EXPECT_TRUE(collector.results(2).empty());
+
+  collector.clear();
+  EXPECT_TRUE(collector.empty());
+}
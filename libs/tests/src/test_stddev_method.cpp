@@ -2,6 +2,7 @@
 
 #include <cmath>
 #include <variant>
+#include <vector>
 
 import pludux;
 
@@ -55,6 +56,46 @@ TEST(StddevMethodTest, RunAllMethod)
   EXPECT_TRUE(std::isnan(stddev_method(asset_snapshot[9], context)));
 }
 
+TEST(StddevMethodTest, RollingMomentsMatchWindowScan)
+{
+  // A high price level with a small spread, where cancellation shows first.
+  auto closes = std::vector<double>{};
+  for(auto i = 0; i < 2000; ++i) {
+    closes.push_back(100000.0 + 50.0 * std::sin(i * 0.37) + (i % 7) * 0.25);
+  }
+  const auto asset_data = AssetHistory{{"Close", closes}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  for(const auto period : {3uz, 20uz, 200uz}) {
+    const auto stddev_method = StddevMethod{CloseMethod{}, period};
+    const auto column =
+     compute_series_column(stddev_method, asset_snapshot, context);
+    ASSERT_EQ(column.size(), closes.size());
+
+    for(auto i = period - 1; i < column.size(); ++i) {
+      const auto lookback = column.size() - 1 - i;
+      const auto expected =
+       stddev_method(asset_snapshot[lookback], std::monostate{});
+      const auto tolerance = 1e-9 * expected;
+
+      EXPECT_NEAR(column[i], expected, tolerance) << "bar " << i;
+      EXPECT_NEAR(stddev_method(asset_snapshot[lookback], context),
+                  expected,
+                  tolerance)
+       << "bar " << i;
+    }
+  }
+}
+
 TEST(StddevMethodTest, EqualityOperator)
 {
   const auto stddev_method1 = StddevMethod{14};
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <variant>
 
 import pludux;
 
@@ -48,6 +49,34 @@ TEST(WmaMethodTest, RunAllMethod)
   EXPECT_TRUE(std::isnan(wma_method(asset_snapshot[9], context)));
 }
 
+TEST(WmaMethodTest, IncrementalMatchesWindowScan)
+{
+  const auto wma_method = WmaMethod{CloseMethod{}, 4};
+  const auto asset_data = AssetHistory{
+   {"Close",
+    {855, 860, 860, 860, 875, 870, 835, 800, 830, 875, 880, 845, 850, 820}}};
+  const auto asset_snapshot = AssetSnapshot{asset_data};
+
+  const auto registry = SeriesMethodRegistry{};
+  const auto results_collector = SeriesResultsCollector{};
+  const auto series_columns = SeriesResultsCollector{};
+  auto indicator_cache = IndicatorCache{};
+  const auto context = DefaultMethodContext{
+   registry,
+   results_collector,
+   {.series_columns = &series_columns, .indicator_cache = &indicator_cache}};
+
+  for(auto i = 0uz; i < asset_snapshot.size(); ++i) {
+    const auto expected = wma_method(asset_snapshot[i], std::monostate{});
+    const auto result = wma_method(asset_snapshot[i], context);
+    if(std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(result)) << "lookback " << i;
+    } else {
+      EXPECT_DOUBLE_EQ(result, expected) << "lookback " << i;
+    }
+  }
+}
+
 TEST(WmaMethodTest, EqualityOperator)
 {
   const auto wma_method1 = WmaMethod{CloseMethod{}, 5};